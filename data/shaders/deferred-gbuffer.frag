@@ -0,0 +1,16 @@
+#version 450
+
+layout(location = 0) in vec4 in_albedo;
+layout(location = 1) in vec3 in_normal;
+layout(location = 2) in vec3 in_position;
+
+layout(location = 0) out vec4 out_albedo;
+layout(location = 1) out vec4 out_normal;
+layout(location = 2) out vec4 out_position;
+
+void main(void)
+{
+    out_albedo = in_albedo;
+    out_normal = vec4(normalize(in_normal), 0.0);
+    out_position = vec4(in_position, 1.0);
+}
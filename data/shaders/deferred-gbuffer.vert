@@ -0,0 +1,26 @@
+#version 450
+
+layout(std140, binding = 0) uniform block {
+    uniform mat4 ModelViewProjectionMatrix;
+    uniform mat4 ModelViewMatrix;
+    uniform mat4 NormalMatrix;
+    uniform vec4 MaterialDiffuse;
+};
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_normal;
+
+layout(location = 0) out vec4 out_albedo;
+layout(location = 1) out vec3 out_normal;
+layout(location = 2) out vec3 out_position;
+
+void main(void)
+{
+    out_albedo = MaterialDiffuse;
+
+    // Lighting is done in eye coordinates
+    out_normal = vec3(NormalMatrix * vec4(in_normal, 0.0));
+    out_position = vec3(ModelViewMatrix * vec4(in_position, 1.0));
+
+    gl_Position = ModelViewProjectionMatrix * vec4(in_position, 1.0);
+}
@@ -0,0 +1,42 @@
+#version 450
+
+// The G-buffer is read from the first subpass, at the current fragment
+layout(input_attachment_index = 0, binding = 0) uniform subpassInput Albedo;
+layout(input_attachment_index = 1, binding = 1) uniform subpassInput Normal;
+layout(input_attachment_index = 2, binding = 2) uniform subpassInput Position;
+
+struct Light {
+    // The w component of the position is the light radius
+    vec4 position;
+    vec4 color;
+};
+
+layout(std430, binding = 3) readonly buffer lights {
+    int LightCount;
+    Light Lights[];
+};
+
+layout(location = 0) in vec2 in_texcoord;
+
+layout(location = 0) out vec4 frag_color;
+
+void main(void)
+{
+    vec3 albedo = subpassLoad(Albedo).rgb;
+    vec3 N = subpassLoad(Normal).xyz;
+    vec3 position = subpassLoad(Position).xyz;
+
+    vec3 color = 0.05 * albedo;
+
+    for (int i = 0; i < LightCount; ++i)
+    {
+        vec3 L = Lights[i].position.xyz - position;
+        float dist = length(L);
+        float attenuation = max(1.0 - dist / Lights[i].position.w, 0.0);
+        float diffuse = max(dot(N, L / dist), 0.0);
+
+        color += attenuation * attenuation * diffuse * Lights[i].color.rgb * albedo;
+    }
+
+    frag_color = vec4(color, 1.0);
+}
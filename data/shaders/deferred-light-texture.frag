@@ -0,0 +1,42 @@
+#version 450
+
+// The G-buffer is sampled as textures rendered by an earlier render pass
+layout(binding = 0) uniform sampler2D Albedo;
+layout(binding = 1) uniform sampler2D Normal;
+layout(binding = 2) uniform sampler2D Position;
+
+struct Light {
+    // The w component of the position is the light radius
+    vec4 position;
+    vec4 color;
+};
+
+layout(std430, binding = 3) readonly buffer lights {
+    int LightCount;
+    Light Lights[];
+};
+
+layout(location = 0) in vec2 in_texcoord;
+
+layout(location = 0) out vec4 frag_color;
+
+void main(void)
+{
+    vec3 albedo = texture(Albedo, in_texcoord).rgb;
+    vec3 N = texture(Normal, in_texcoord).xyz;
+    vec3 position = texture(Position, in_texcoord).xyz;
+
+    vec3 color = 0.05 * albedo;
+
+    for (int i = 0; i < LightCount; ++i)
+    {
+        vec3 L = Lights[i].position.xyz - position;
+        float dist = length(L);
+        float attenuation = max(1.0 - dist / Lights[i].position.w, 0.0);
+        float diffuse = max(dot(N, L / dist), 0.0);
+
+        color += attenuation * attenuation * diffuse * Lights[i].color.rgb * albedo;
+    }
+
+    frag_color = vec4(color, 1.0);
+}
@@ -0,0 +1,11 @@
+#version 450 core
+
+layout(location = 0) in vec2 in_texcoord;
+
+layout(location = 0) out vec4 frag_color;
+
+void main(void)
+{
+    // Mostly transparent, so that blended layers keep contributing
+    frag_color = vec4(in_texcoord, 0.5, 0.1);
+}
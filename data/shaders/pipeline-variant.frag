@@ -0,0 +1,18 @@
+#version 450 core
+
+// Each value compiles to different code, to create distinct pipeline variants
+layout(constant_id = 0) const int Iterations = 0;
+
+layout(location = 0) in vec4 in_color;
+
+layout(location = 0) out vec4 frag_color;
+
+void main(void)
+{
+    vec4 color = in_color;
+
+    for (int i = 0; i < Iterations; ++i)
+        color.rgb = color.rgb * 0.98 + color.gbr * 0.02;
+
+    frag_color = color;
+}
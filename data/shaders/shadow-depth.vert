@@ -0,0 +1,20 @@
+#version 450
+
+layout(std140, binding = 0) uniform block {
+    uniform mat4 ModelViewProjectionMatrix;
+    uniform mat4 NormalMatrix;
+    uniform mat4 LightModelViewProjectionMatrix;
+    uniform mat4 ShadowMatrix;
+    uniform vec4 MaterialDiffuse;
+    uniform vec4 LightDirection;
+    uniform float ShadowTexelSize;
+    uniform int PcfRadius;
+};
+
+layout(location = 0) in vec3 in_position;
+
+void main(void)
+{
+    // Only depth is written, from the point of view of the light
+    gl_Position = LightModelViewProjectionMatrix * vec4(in_position, 1.0);
+}
@@ -0,0 +1,43 @@
+#version 450
+
+layout(std140, binding = 0) uniform block {
+    uniform mat4 ModelViewProjectionMatrix;
+    uniform mat4 NormalMatrix;
+    uniform mat4 LightModelViewProjectionMatrix;
+    uniform mat4 ShadowMatrix;
+    uniform vec4 MaterialDiffuse;
+    uniform vec4 LightDirection;
+    uniform float ShadowTexelSize;
+    uniform int PcfRadius;
+};
+
+layout(binding = 1) uniform sampler2DShadow ShadowMap;
+
+layout(location = 0) in vec4 in_ambient;
+layout(location = 1) in vec4 in_diffuse;
+layout(location = 2) in vec4 in_shadow_coord;
+
+layout(location = 0) out vec4 frag_color;
+
+void main(void)
+{
+    // Percentage closer filtering: average the depth comparisons over a
+    // kernel of (2 * PcfRadius + 1)^2 texels
+    float lit = 0.0;
+
+    for (int y = -PcfRadius; y <= PcfRadius; ++y)
+    {
+        for (int x = -PcfRadius; x <= PcfRadius; ++x)
+        {
+            vec2 offset = vec2(x, y) * ShadowTexelSize;
+            lit += textureLod(ShadowMap,
+                              vec3(in_shadow_coord.xy + offset, in_shadow_coord.z),
+                              0.0);
+        }
+    }
+
+    float kernel_size = float(2 * PcfRadius + 1);
+    lit /= kernel_size * kernel_size;
+
+    frag_color = in_ambient + lit * in_diffuse;
+}
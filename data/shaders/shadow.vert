@@ -0,0 +1,36 @@
+#version 450
+
+layout(std140, binding = 0) uniform block {
+    uniform mat4 ModelViewProjectionMatrix;
+    uniform mat4 NormalMatrix;
+    uniform mat4 LightModelViewProjectionMatrix;
+    uniform mat4 ShadowMatrix;
+    uniform vec4 MaterialDiffuse;
+    uniform vec4 LightDirection;
+    uniform float ShadowTexelSize;
+    uniform int PcfRadius;
+};
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_normal;
+
+layout(location = 0) out vec4 out_ambient;
+layout(location = 1) out vec4 out_diffuse;
+layout(location = 2) out vec4 out_shadow_coord;
+
+void main(void)
+{
+    // Transform the normal to eye coordinates
+    vec3 N = normalize(vec3(NormalMatrix * vec4(in_normal, 0.0)));
+
+    // LightDirection is in eye coordinates and normalized
+    float diffuse = max(dot(N, LightDirection.xyz), 0.0);
+
+    out_ambient = vec4(0.2 * MaterialDiffuse.rgb, MaterialDiffuse.a);
+    out_diffuse = vec4(diffuse * MaterialDiffuse.rgb, 0.0);
+
+    // Shadow map texture coordinates, with the depth as seen from the light
+    out_shadow_coord = ShadowMatrix * vec4(in_position, 1.0);
+
+    gl_Position = ModelViewProjectionMatrix * vec4(in_position, 1.0);
+}
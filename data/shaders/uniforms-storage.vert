@@ -0,0 +1,30 @@
+#version 450 core
+
+struct Object {
+    mat4 ModelViewProjectionMatrix;
+    mat4 NormalMatrix;
+};
+
+// The objects are indexed by the first instance of each draw
+layout(std430, binding = 0) readonly buffer objects {
+    Object Objects[];
+};
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_normal;
+
+layout(location = 0) out vec4 out_color;
+
+const vec3 LightDirection = vec3(0.666667, -0.666667, 0.333333);
+const vec4 MaterialDiffuse = vec4(0.7, 0.7, 0.7, 1.0);
+
+void main(void)
+{
+    Object object = Objects[gl_InstanceIndex];
+
+    vec3 N = normalize(vec3(object.NormalMatrix * vec4(in_normal, 0.0)));
+    float diffuse = max(dot(N, LightDirection), 0.0);
+    out_color = vec4(diffuse * MaterialDiffuse.rgb, MaterialDiffuse.a);
+
+    gl_Position = object.ModelViewProjectionMatrix * vec4(in_position, 1.0);
+}
@@ -0,0 +1,23 @@
+#version 450 core
+
+layout(std140, binding = 0) uniform block {
+    mat4 ModelViewProjectionMatrix;
+    mat4 NormalMatrix;
+};
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_normal;
+
+layout(location = 0) out vec4 out_color;
+
+const vec3 LightDirection = vec3(0.666667, -0.666667, 0.333333);
+const vec4 MaterialDiffuse = vec4(0.7, 0.7, 0.7, 1.0);
+
+void main(void)
+{
+    vec3 N = normalize(vec3(NormalMatrix * vec4(in_normal, 0.0)));
+    float diffuse = max(dot(N, LightDirection), 0.0);
+    out_color = vec4(diffuse * MaterialDiffuse.rgb, MaterialDiffuse.a);
+
+    gl_Position = ModelViewProjectionMatrix * vec4(in_position, 1.0);
+}
@@ -39,6 +39,30 @@ Scene& Benchmark::prepare_scene()
     return scene_;
 }
 
+std::function<void()> Benchmark::prefetch_task() const
+{
+    // Resolve the option values the scene will have for this benchmark
+    // without touching the scene itself, which may be in use
+    auto scene_options = scene_.options();
+
+    for (auto& kv : scene_options)
+        kv.second.value = kv.second.default_value;
+
+    for (auto const& option_pair : options)
+    {
+        auto const opt_iter = scene_options.find(option_pair.first);
+        if (opt_iter != scene_options.end() &&
+            opt_iter->second.accepts_value(option_pair.second))
+        {
+            opt_iter->second.value = option_pair.second;
+        }
+    }
+
+    auto const& scene = scene_;
+
+    return [&scene, scene_options] { scene.prefetch(scene_options); };
+}
+
 void Benchmark::load_options()
 {
     for (auto const& option_pair : options)
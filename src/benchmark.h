@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -35,6 +36,7 @@ public:
     Benchmark(Scene &scene, const std::vector<OptionPair> &options);
 
     Scene& prepare_scene();
+    std::function<void()> prefetch_task() const;
 
 private:
     void load_options();
@@ -0,0 +1,108 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ktx2_file.h"
+#include "util.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+
+unsigned char const ktx2_identifier[] =
+    {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+size_t const ktx2_header_size = 80;
+size_t const ktx2_level_index_entry_size = 24;
+
+// KTX2 files are always little endian
+template<typename T>
+T read_le(std::vector<char> const& data, size_t offset)
+{
+    T ret{0};
+    for (size_t i = 0; i < sizeof(T); ++i)
+        ret |= static_cast<T>(static_cast<unsigned char>(data[offset + i])) << (8 * i);
+    return ret;
+}
+
+}
+
+Ktx2File::Ktx2File(std::string const& rel_path)
+    : Ktx2File{Util::read_data_file(rel_path)}
+{
+}
+
+Ktx2File::Ktx2File(std::vector<char> data)
+    : data_{std::move(data)},
+      format_{vk::Format::eUndefined},
+      extent_{0, 0}
+{
+    parse();
+}
+
+void Ktx2File::parse()
+{
+    if (data_.size() < ktx2_header_size ||
+        memcmp(data_.data(), ktx2_identifier, sizeof(ktx2_identifier)))
+    {
+        throw std::runtime_error{"Not a KTX2 file"};
+    }
+
+    auto const vk_format = read_le<uint32_t>(data_, 12);
+    auto const pixel_width = read_le<uint32_t>(data_, 20);
+    auto const pixel_height = read_le<uint32_t>(data_, 24);
+    auto const pixel_depth = read_le<uint32_t>(data_, 28);
+    auto const layer_count = read_le<uint32_t>(data_, 32);
+    auto const face_count = read_le<uint32_t>(data_, 36);
+    auto const level_count = std::max(read_le<uint32_t>(data_, 40), 1u);
+    auto const supercompression_scheme = read_le<uint32_t>(data_, 44);
+
+    if (vk_format == 0)
+        throw std::runtime_error{"KTX2 files with undefined (basis) format are not supported"};
+    if (supercompression_scheme != 0)
+        throw std::runtime_error{"Supercompressed KTX2 files are not supported"};
+    if (pixel_width == 0 || pixel_height == 0 || pixel_depth != 0 ||
+        layer_count > 1 || face_count != 1)
+    {
+        throw std::runtime_error{"Only single 2D image KTX2 files are supported"};
+    }
+
+    if (data_.size() < ktx2_header_size + level_count * ktx2_level_index_entry_size)
+        throw std::runtime_error{"Truncated KTX2 level index"};
+
+    format_ = static_cast<vk::Format>(vk_format);
+    extent_ = vk::Extent2D{pixel_width, pixel_height};
+
+    for (uint32_t i = 0; i < level_count; ++i)
+    {
+        auto const entry = ktx2_header_size + i * ktx2_level_index_entry_size;
+        auto const offset = read_le<uint64_t>(data_, entry);
+        auto const size = read_le<uint64_t>(data_, entry + 8);
+
+        if (size == 0 || offset > data_.size() || size > data_.size() - offset)
+            throw std::runtime_error{"Invalid KTX2 level data range"};
+
+        levels_.push_back(
+            {{std::max(pixel_width >> i, 1u), std::max(pixel_height >> i, 1u)},
+             static_cast<size_t>(offset),
+             static_cast<size_t>(size)});
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <string>
+#include <vector>
+
+// A KTX2 container holding a single 2D texture with pre-encoded
+// (typically block compressed) mipmap levels, ready to be copied
+// verbatim into a Vulkan image of format().
+class Ktx2File
+{
+public:
+    struct Level
+    {
+        vk::Extent2D extent;
+        size_t offset;
+        size_t size;
+    };
+
+    Ktx2File(std::string const& rel_path);
+    Ktx2File(std::vector<char> data);
+
+    vk::Format format() const { return format_; }
+    vk::Extent2D extent() const { return extent_; }
+    std::vector<Level> const& levels() const { return levels_; }
+    char const* data() const { return data_.data(); }
+    size_t size() const { return data_.size(); }
+
+private:
+    void parse();
+
+    std::vector<char> data_;
+    vk::Format format_;
+    vk::Extent2D extent_;
+    std::vector<Level> levels_;
+};
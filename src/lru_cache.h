@@ -0,0 +1,100 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// A thread-safe cache that evicts the least recently used entries when the
+// total size of the entries exceeds max_size. The most recently inserted
+// entry is always kept, even if it alone exceeds max_size.
+template <typename T>
+class LruCache
+{
+public:
+    LruCache(size_t max_size) : max_size{max_size}, total_size{0} {}
+
+    // Copies the value for key to value, marking it as the most recently used
+    bool find(std::string const& key, T& value)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        auto const iter = index.find(key);
+        if (iter == index.end())
+            return false;
+
+        entries.splice(entries.begin(), entries, iter->second);
+        value = iter->second->value;
+
+        return true;
+    }
+
+    // Stores value for key, replacing any previous value
+    void insert(std::string const& key, T value, size_t size)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        erase(key);
+
+        entries.push_front(Entry{key, std::move(value), size});
+        index[key] = entries.begin();
+        total_size += size;
+
+        while (total_size > max_size && entries.size() > 1)
+            erase(entries.back().key);
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        index.clear();
+        entries.clear();
+        total_size = 0;
+    }
+
+private:
+    struct Entry
+    {
+        std::string key;
+        T value;
+        size_t size;
+    };
+
+    void erase(std::string const& key)
+    {
+        auto const iter = index.find(key);
+        if (iter == index.end())
+            return;
+
+        total_size -= iter->second->size;
+        entries.erase(iter->second);
+        index.erase(iter);
+    }
+
+    std::mutex mutex;
+    // Ordered from the most to the least recently used
+    std::list<Entry> entries;
+    std::unordered_map<std::string, typename std::list<Entry>::iterator> index;
+    size_t const max_size;
+    size_t total_size;
+};
@@ -32,14 +32,29 @@
 #include "log.h"
 #include "util.h"
 #include "main_loop.h"
+#include "model.h"
 
+#include "scenes/async_compute_scene.h"
 #include "scenes/clear_scene.h"
+#include "scenes/compute_scene.h"
 #include "scenes/cube_scene.h"
 #include "scenes/default_options_scene.h"
+#include "scenes/deferred_scene.h"
+#include "scenes/descriptors_scene.h"
 #include "scenes/desktop_scene.h"
+#include "scenes/draw_calls_scene.h"
 #include "scenes/effect2d_scene.h"
+#include "scenes/fill_scene.h"
+#include "scenes/geometry_scene.h"
+#include "scenes/instancing_scene.h"
+#include "scenes/lod_scene.h"
+#include "scenes/pipelines_scene.h"
 #include "scenes/shading_scene.h"
+#include "scenes/shadow_scene.h"
+#include "scenes/streaming_scene.h"
 #include "scenes/texture_scene.h"
+#include "scenes/transfer_scene.h"
+#include "scenes/uniforms_scene.h"
 #include "scenes/vertex_scene.h"
 
 #include <stdexcept>
@@ -70,13 +85,27 @@ void set_up_sighandler(MainLoop& main_loop)
 
 void populate_scene_collection(SceneCollection& sc)
 {
+    sc.register_scene(std::make_unique<AsyncComputeScene>());
     sc.register_scene(std::make_unique<ClearScene>());
+    sc.register_scene(std::make_unique<ComputeScene>());
     sc.register_scene(std::make_unique<CubeScene>());
     sc.register_scene(std::make_unique<DefaultOptionsScene>(sc));
+    sc.register_scene(std::make_unique<DeferredScene>());
+    sc.register_scene(std::make_unique<DescriptorsScene>());
     sc.register_scene(std::make_unique<DesktopScene>());
+    sc.register_scene(std::make_unique<DrawCallsScene>());
     sc.register_scene(std::make_unique<Effect2DScene>());
+    sc.register_scene(std::make_unique<FillScene>());
+    sc.register_scene(std::make_unique<GeometryScene>());
+    sc.register_scene(std::make_unique<InstancingScene>());
+    sc.register_scene(std::make_unique<LodScene>());
+    sc.register_scene(std::make_unique<PipelinesScene>());
     sc.register_scene(std::make_unique<ShadingScene>());
+    sc.register_scene(std::make_unique<ShadowScene>());
+    sc.register_scene(std::make_unique<StreamingScene>());
     sc.register_scene(std::make_unique<TextureScene>());
+    sc.register_scene(std::make_unique<TransferScene>());
+    sc.register_scene(std::make_unique<UniformsScene>());
     sc.register_scene(std::make_unique<VertexScene>());
 }
 
@@ -102,6 +131,8 @@ try
     }
 
     Util::set_data_dir(options.data_dir);
+    Util::set_image_cache_dir(options.image_cache_dir);
+    Model::set_mesh_cache_dir(options.mesh_cache_dir);
 
     SceneCollection sc;
     populate_scene_collection(sc);
@@ -31,6 +31,10 @@
 #include "options.h"
 #include "util.h"
 
+#include <future>
+#include <pthread.h>
+#include <sched.h>
+
 namespace
 {
 
@@ -54,10 +58,16 @@ void log_scene_exception(std::string const& what)
     Log::flush();
 }
 
-void log_scene_fps(unsigned int fps)
+void log_prefetch_exception(std::string const& what)
+{
+    Log::debug("MainLoop: Failed to prefetch benchmark data: %s\n", what.c_str());
+}
+
+void log_scene_fps(unsigned int fps, std::string const& extra_results)
 {
-    auto const fmt = Log::continuation_prefix + " FPS: %u FrameTime: %.3f ms\n";
-    Log::info(fmt.c_str(), fps, 1000.0 / fps);
+    auto const fmt = Log::continuation_prefix + " FPS: %u FrameTime: %.3f ms%s%s\n";
+    Log::info(fmt.c_str(), fps, 1000.0 / fps,
+              extra_results.empty() ? "" : " ", extra_results.c_str());
     Log::flush();
 }
 
@@ -70,6 +80,37 @@ void advance_iter(T& iter, T const& start, T const& end, bool run_forever)
         iter = start;
 }
 
+// Prefetches the data for the benchmark after iter on a worker thread, so
+// that it overlaps with the rendering of the current benchmark. The worker
+// runs at idle priority, so that it only uses CPU time the rendering doesn't.
+template <typename T>
+std::future<void> prefetch_next(T iter, T const& start, T const& end, bool run_forever)
+{
+    advance_iter(iter, start, end, run_forever);
+    if (iter == end)
+        return {};
+
+    auto const task = (*iter)->prefetch_task();
+
+    return std::async(
+        std::launch::async,
+        [task]
+        {
+            sched_param param{};
+            if (pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) != 0)
+                Log::debug("MainLoop: Failed to lower the prefetch thread priority\n");
+
+            try
+            {
+                task();
+            }
+            catch (std::exception const& e)
+            {
+                log_prefetch_exception(e.what());
+            }
+        });
+}
+
 }
 
 MainLoop::MainLoop(VulkanState& vulkan,
@@ -86,6 +127,7 @@ MainLoop::MainLoop(VulkanState& vulkan,
 void MainLoop::run()
 {
     auto const& benchmarks = bc.benchmarks();
+    std::future<void> prefetch;
 
     for (auto iter = benchmarks.begin();
          iter != benchmarks.end();
@@ -94,6 +136,10 @@ void MainLoop::run()
     {
         auto& benchmark = *iter;
 
+        // The prefetch may be reading from the scene we are about to prepare
+        if (prefetch.valid())
+            prefetch.wait();
+
         auto& scene = benchmark->prepare_scene();
 
         if (!scene.is_valid())
@@ -115,6 +161,9 @@ void MainLoop::run()
         auto const scene_teardown = Util::on_scope_exit([&] { scene.teardown(); });
         scene.setup(vulkan, ws.vulkan_images());
 
+        prefetch = prefetch_next(iter, benchmarks.begin(), benchmarks.end(),
+                                 options.run_forever);
+
         bool should_quit = false;
 
         scene.start();
@@ -130,7 +179,7 @@ void MainLoop::run()
 
         auto const scene_fps = scene.average_fps();
 
-        log_scene_fps(scene_fps);
+        log_scene_fps(scene_fps, scene.extra_results());
 
         total_fps += scene_fps;
         ++total_benchmarks;
@@ -22,53 +22,200 @@
 
 #include "mesh.h"
 
-#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 namespace
 {
 
-std::vector<size_t> vk_formats_to_float_formats(
+uint16_t float_to_half(float f)
+{
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+
+    uint32_t const sign = (x >> 16) & 0x8000;
+    x &= 0x7fffffff;
+
+    uint16_t ret;
+
+    if (x >= 0x47800000)
+    {
+        // Too large for half (becomes infinity), or infinity/NaN
+        ret = x > 0x7f800000 ? 0x7e00 : 0x7c00;
+    }
+    else if (x < 0x38800000)
+    {
+        // Denormal or zero in half; let the FPU do the rounding by adding
+        // a value that aligns the mantissa bits we need at the bottom
+        uint32_t const magic_bits = 0x3f000000;
+        float magic;
+        memcpy(&magic, &magic_bits, sizeof(magic));
+        float xf;
+        memcpy(&xf, &x, sizeof(xf));
+        xf += magic;
+        uint32_t r;
+        memcpy(&r, &xf, sizeof(r));
+        ret = r - magic_bits;
+    }
+    else
+    {
+        // Normal: rebias exponent and round mantissa to nearest even
+        uint32_t const mantissa_odd = (x >> 13) & 1;
+        x += 0xc8000fff + mantissa_odd;
+        ret = x >> 13;
+    }
+
+    return sign | ret;
+}
+
+template<int bits>
+int32_t float_to_snorm(float f)
+{
+    float const max = (1 << (bits - 1)) - 1;
+    return static_cast<int32_t>(std::lround(std::min(std::max(f, -1.0f), 1.0f) * max));
+}
+
+template<int bits>
+uint32_t float_to_unorm(float f)
+{
+    float const max = (1u << bits) - 1;
+    return static_cast<uint32_t>(std::lround(std::min(std::max(f, 0.0f), 1.0f) * max));
+}
+
+float to_float32(float f) { return f; }
+int16_t to_snorm16(float f) { return float_to_snorm<16>(f); }
+int8_t to_snorm8(float f) { return float_to_snorm<8>(f); }
+uint16_t to_unorm16(float f) { return float_to_unorm<16>(f); }
+uint8_t to_unorm8(float f) { return float_to_unorm<8>(f); }
+
+// The conversions run over all vertices of an attribute at once, keeping
+// the inner loops simple enough for the compiler to vectorize
+template<typename T, size_t N, T (*convert_value)(float)>
+void convert_components(float const* src, size_t src_stride,
+                        char* dst, size_t dst_stride, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        T converted[N];
+        for (size_t c = 0; c < N; ++c)
+            converted[c] = convert_value(src[c]);
+
+        memcpy(dst, converted, sizeof(converted));
+        src += src_stride;
+        dst += dst_stride;
+    }
+}
+
+template<bool snorm>
+void convert_a2b10g10r10(float const* src, size_t src_stride,
+                         char* dst, size_t dst_stride, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t packed;
+
+        if (snorm)
+        {
+            packed = (float_to_snorm<10>(src[0]) & 0x3ff) |
+                     (float_to_snorm<10>(src[1]) & 0x3ff) << 10 |
+                     (float_to_snorm<10>(src[2]) & 0x3ff) << 20 |
+                     static_cast<uint32_t>(float_to_snorm<2>(src[3]) & 0x3) << 30;
+        }
+        else
+        {
+            packed = float_to_unorm<10>(src[0]) |
+                     float_to_unorm<10>(src[1]) << 10 |
+                     float_to_unorm<10>(src[2]) << 20 |
+                     float_to_unorm<2>(src[3]) << 30;
+        }
+
+        memcpy(dst, &packed, sizeof(packed));
+        src += src_stride;
+        dst += dst_stride;
+    }
+}
+
+Mesh::Attribute vk_format_to_attribute(vk::Format format)
+{
+    switch (format)
+    {
+        case vk::Format::eR32Sfloat:
+            return {1, 1, 0, 4, 0, convert_components<float, 1, to_float32>};
+        case vk::Format::eR32G32Sfloat:
+            return {2, 2, 0, 8, 0, convert_components<float, 2, to_float32>};
+        case vk::Format::eR32G32B32Sfloat:
+            return {3, 3, 0, 12, 0, convert_components<float, 3, to_float32>};
+        case vk::Format::eR32G32B32A32Sfloat:
+            return {4, 4, 0, 16, 0, convert_components<float, 4, to_float32>};
+        case vk::Format::eR16G16Sfloat:
+            return {2, 2, 0, 4, 0, convert_components<uint16_t, 2, float_to_half>};
+        case vk::Format::eR16G16B16A16Sfloat:
+            return {4, 3, 0, 8, 0, convert_components<uint16_t, 4, float_to_half>};
+        case vk::Format::eR16G16Snorm:
+            return {2, 2, 0, 4, 0, convert_components<int16_t, 2, to_snorm16>};
+        case vk::Format::eR16G16B16A16Snorm:
+            return {4, 3, 0, 8, 0, convert_components<int16_t, 4, to_snorm16>};
+        case vk::Format::eR16G16Unorm:
+            return {2, 2, 0, 4, 0, convert_components<uint16_t, 2, to_unorm16>};
+        case vk::Format::eR16G16B16A16Unorm:
+            return {4, 3, 0, 8, 0, convert_components<uint16_t, 4, to_unorm16>};
+        case vk::Format::eR8G8B8A8Snorm:
+            return {4, 3, 0, 4, 0, convert_components<int8_t, 4, to_snorm8>};
+        case vk::Format::eR8G8B8A8Unorm:
+            return {4, 3, 0, 4, 0, convert_components<uint8_t, 4, to_unorm8>};
+        case vk::Format::eA2B10G10R10SnormPack32:
+            return {4, 3, 0, 4, 0, convert_a2b10g10r10<true>};
+        case vk::Format::eA2B10G10R10UnormPack32:
+            return {4, 3, 0, 4, 0, convert_a2b10g10r10<false>};
+        default:
+            throw std::runtime_error{"Unsupported vertex format " + to_string(format)};
+    };
+}
+
+std::vector<Mesh::Attribute> vk_formats_to_attributes(
     std::vector<vk::Format> const& formats)
 {
-    std::vector<size_t> ret;
+    std::vector<Mesh::Attribute> ret;
+    size_t value_offset = 0;
+    size_t offset = 0;
 
     for (auto const f : formats)
     {
-        switch (f)
-        {
-            case vk::Format::eR32Sfloat:
-                ret.push_back(1);
-                break;
-            case vk::Format::eR32G32Sfloat:
-                ret.push_back(2);
-                break;
-            case vk::Format::eR32G32B32Sfloat:
-                ret.push_back(3);
-                break;
-            case vk::Format::eR32G32B32A32Sfloat:
-                ret.push_back(4);
-                break;
-            default:
-                throw std::runtime_error{"Unsupported vertex format " + to_string(f)};
-        };
+        auto attrib = vk_format_to_attribute(f);
+        attrib.value_offset = value_offset;
+        attrib.offset = offset;
+        value_offset += attrib.num_values;
+        offset += attrib.size;
+        ret.push_back(attrib);
     }
 
     return ret;
 }
 
-size_t calc_vertex_num_floats(std::vector<size_t> const& formats)
+size_t calc_vertex_num_values(std::vector<Mesh::Attribute> const& attributes)
+{
+    return attributes.empty() ? 0 :
+           attributes.back().value_offset + attributes.back().num_values;
+}
+
+size_t calc_vertex_size(std::vector<Mesh::Attribute> const& attributes)
 {
-    return std::accumulate(formats.begin(), formats.end(), 0);
+    return attributes.empty() ? 0 :
+           attributes.back().offset + attributes.back().size;
 }
 
 }
 
 Mesh::Mesh(std::vector<vk::Format> const& vk_formats)
     : vk_formats{vk_formats},
-      formats{vk_formats_to_float_formats(vk_formats)},
-      vertex_num_floats{calc_vertex_num_floats(formats)},
-      interleave{false}
+      attributes{vk_formats_to_attributes(vk_formats)},
+      vertex_num_values{calc_vertex_num_values(attributes)},
+      vertex_size_{calc_vertex_size(attributes)},
+      interleave{false},
+      vertex_count{0}
 {
 
 }
@@ -78,109 +225,196 @@ void Mesh::set_interleave(bool interleave_)
     interleave = interleave_;
 }
 
+std::vector<vk::Format> const& Mesh::vertex_formats() const
+{
+    return vk_formats;
+}
+
+void Mesh::reserve_vertices(size_t count)
+{
+    values.reserve(count * vertex_num_values);
+}
+
+void Mesh::add_vertices(float const* data, size_t count)
+{
+    values.insert(values.end(), data, data + count * vertex_num_values);
+    vertex_count += count;
+}
+
 void Mesh::next_vertex()
 {
-    vertices.push_back(std::vector<float>(vertex_num_floats));
+    values.resize(values.size() + vertex_num_values);
+    ++vertex_count;
 }
 
 size_t Mesh::num_vertices() const
 {
-    return vertices.size();
+    return vertex_count;
 }
 
-void Mesh::set_attribute(size_t pos, float data)
+void Mesh::add_index(uint32_t index)
 {
-    if (formats[pos] != 1)
-        throw std::logic_error{"Trying to set vertex attribute with incorrectly sized data"};
+    if (index >= vertex_count)
+        throw std::logic_error{"Trying to add index to non-existent vertex"};
 
-    auto const offset = std::accumulate(formats.begin(), formats.begin() + pos, 0);
-    auto& vertex = vertices.back();
+    indices.push_back(index);
+}
 
-    vertex[offset] = data;
+size_t Mesh::num_indices() const
+{
+    return indices.size();
 }
 
-void Mesh::set_attribute(size_t pos, glm::vec2 const& data)
+std::vector<uint32_t> const& Mesh::index_list() const
 {
-    if (formats[pos] != 2)
-        throw std::logic_error{"Trying to set vertex attribute with incorrectly sized data"};
+    return indices;
+}
 
-    auto const offset = std::accumulate(formats.begin(), formats.begin() + pos, 0);
-    auto& vertex = vertices.back();
+void Mesh::set_indices(std::vector<uint32_t> indices_)
+{
+    for (auto const index : indices_)
+    {
+        if (index >= vertex_count)
+            throw std::logic_error{"Trying to add index to non-existent vertex"};
+    }
 
-    vertex[offset] = data.x;
-    vertex[offset + 1] = data.y;
+    indices = std::move(indices_);
 }
 
-void Mesh::set_attribute(size_t pos, glm::vec3 const& data)
+void Mesh::remap_vertices(std::vector<uint32_t> const& remap)
+{
+    if (remap.size() != vertex_count)
+        throw std::logic_error{"Trying to remap vertices with incorrectly sized remap table"};
+
+    std::vector<float> remapped_values(values.size());
+    std::vector<bool> remapped(vertex_count);
+
+    for (size_t i = 0; i < vertex_count; ++i)
+    {
+        if (remap[i] >= vertex_count || remapped[remap[i]])
+            throw std::logic_error{"Trying to remap vertices with invalid remap table"};
+
+        remapped[remap[i]] = true;
+        std::copy_n(values.data() + i * vertex_num_values, vertex_num_values,
+                    remapped_values.data() + remap[i] * vertex_num_values);
+    }
+
+    for (auto& index : indices)
+        index = remap[index];
+
+    values = std::move(remapped_values);
+}
+
+float* Mesh::attribute_values(size_t pos, size_t num, char const* error)
 {
-    if (formats[pos] != 3)
-        throw std::logic_error{"Trying to set vertex attribute with incorrectly sized data"};
+    auto const& attrib = attributes[pos];
 
-    auto const offset = std::accumulate(formats.begin(), formats.begin() + pos, 0);
-    auto& vertex = vertices.back();
+    if (num < attrib.min_num_values || num > attrib.num_values)
+        throw std::logic_error{error};
 
-    vertex[offset] = data.x;
-    vertex[offset + 1] = data.y;
-    vertex[offset + 2] = data.z;
+    return &values[values.size() - vertex_num_values + attrib.value_offset];
+}
+
+void Mesh::set_attribute(size_t pos, float data)
+{
+    auto const attrib = attribute_values(
+        pos, 1, "Trying to set vertex attribute with incorrectly sized data");
+
+    attrib[0] = data;
+}
+
+void Mesh::set_attribute(size_t pos, glm::vec2 const& data)
+{
+    auto const attrib = attribute_values(
+        pos, 2, "Trying to set vertex attribute with incorrectly sized data");
+
+    attrib[0] = data.x;
+    attrib[1] = data.y;
+}
+
+void Mesh::set_attribute(size_t pos, glm::vec3 const& data)
+{
+    auto const attrib = attribute_values(
+        pos, 3, "Trying to set vertex attribute with incorrectly sized data");
+
+    attrib[0] = data.x;
+    attrib[1] = data.y;
+    attrib[2] = data.z;
 }
 
 void Mesh::set_attribute(size_t pos, glm::vec4 const& data)
 {
-    if (formats[pos] != 4)
-        throw std::logic_error{"Trying to set vertex attribute with incorrectly sized data"};
+    auto const attrib = attribute_values(
+        pos, 4, "Trying to set vertex attribute with incorrectly sized data");
+
+    attrib[0] = data.x;
+    attrib[1] = data.y;
+    attrib[2] = data.z;
+    attrib[3] = data.w;
+}
+
+float const* Mesh::vertex_values() const
+{
+    return values.data();
+}
 
-    auto const offset = std::accumulate(formats.begin(), formats.begin() + pos, 0);
-    auto& vertex = vertices.back();
+size_t Mesh::num_vertex_values() const
+{
+    return vertex_num_values;
+}
 
-    vertex[offset] = data.x;
-    vertex[offset + 1] = data.y;
-    vertex[offset + 2] = data.z;
-    vertex[offset + 3] = data.w;
+float const* Mesh::vertex_attribute_values(size_t vertex, size_t pos) const
+{
+    return &values[vertex * vertex_num_values + attributes[pos].value_offset];
 }
 
-glm::vec3 Mesh::min_attribute_bound(size_t pos)
+glm::vec3 Mesh::min_attribute_bound(size_t pos) const
 {
-    if (formats[pos] != 3)
-        throw std::logic_error{"Trying to get min attribute bound from incorrectly sized data"};
+    auto const& attrib = attributes[pos];
 
-    auto const offset = std::accumulate(formats.begin(), formats.begin() + pos, 0);
+    if (attrib.min_num_values > 3 || attrib.num_values < 3)
+        throw std::logic_error{"Trying to get min attribute bound from incorrectly sized data"};
 
     glm::vec3 ret{std::numeric_limits<float>::max(),
                   std::numeric_limits<float>::max(),
                   std::numeric_limits<float>::max()};
 
-    for (auto const& v : vertices)
+    for (auto i = attrib.value_offset; i < values.size(); i += vertex_num_values)
     {
-        if (v[offset] < ret.x)
-            ret.x = v[offset];
-        if (v[offset + 1] < ret.y)
-            ret.y = v[offset + 1];
-        if (v[offset + 2] < ret.z)
-            ret.z = v[offset + 2];
+        auto const v = &values[i];
+
+        if (v[0] < ret.x)
+            ret.x = v[0];
+        if (v[1] < ret.y)
+            ret.y = v[1];
+        if (v[2] < ret.z)
+            ret.z = v[2];
     }
 
     return ret;
 }
 
-glm::vec3 Mesh::max_attribute_bound(size_t pos)
+glm::vec3 Mesh::max_attribute_bound(size_t pos) const
 {
-    if (formats[pos] != 3)
-        throw std::logic_error{"Trying to get max attribute bound from incorrectly sized data"};
+    auto const& attrib = attributes[pos];
 
-    auto const offset = std::accumulate(formats.begin(), formats.begin() + pos, 0);
+    if (attrib.min_num_values > 3 || attrib.num_values < 3)
+        throw std::logic_error{"Trying to get max attribute bound from incorrectly sized data"};
 
     glm::vec3 ret{std::numeric_limits<float>::min(),
                   std::numeric_limits<float>::min(),
                   std::numeric_limits<float>::min()};
 
-    for (auto const& v : vertices)
+    for (auto i = attrib.value_offset; i < values.size(); i += vertex_num_values)
     {
-        if (v[offset] > ret.x)
-            ret.x = v[offset];
-        if (v[offset + 1] > ret.y)
-            ret.y = v[offset + 1];
-        if (v[offset + 2] > ret.z)
-            ret.z = v[offset + 2];
+        auto const v = &values[i];
+
+        if (v[0] > ret.x)
+            ret.x = v[0];
+        if (v[1] > ret.y)
+            ret.y = v[1];
+        if (v[2] > ret.z)
+            ret.z = v[2];
     }
 
     return ret;
@@ -196,19 +430,19 @@ Mesh::binding_descriptions() const
         ret.push_back(
             vk::VertexInputBindingDescription{}
                 .setBinding(0)
-                .setStride(sizeof(float) * vertex_num_floats)
+                .setStride(vertex_size_)
                 .setInputRate(vk::VertexInputRate::eVertex));
     }
     else
     {
         int binding = 0;
 
-        for (auto const& f : formats)
+        for (auto const& attrib : attributes)
         {
             ret.push_back(
                 vk::VertexInputBindingDescription{}
                     .setBinding(binding)
-                    .setStride(sizeof(float) * f)
+                    .setStride(attrib.size)
                     .setInputRate(vk::VertexInputRate::eVertex));
 
             ++binding;
@@ -228,10 +462,7 @@ Mesh::attribute_descriptions() const
 
     for (auto const& vf : vk_formats)
     {
-        auto const offset =
-            interleave ?
-            sizeof(float) * std::accumulate(formats.begin(), formats.begin() + i, 0) :
-            0;
+        auto const offset = interleave ? attributes[i].offset : 0;
 
         ret.push_back(
             vk::VertexInputAttributeDescription{}
@@ -251,32 +482,28 @@ Mesh::attribute_descriptions() const
 void Mesh::copy_vertex_data_to(void* dst) const
 {
     auto const dst_c = static_cast<char*>(dst);
+    auto const binding_offsets = vertex_data_binding_offsets();
 
-    if (interleave)
+    if (interleave && vertex_size_ == vertex_num_values * sizeof(float))
     {
-        auto current = dst_c;
-
-        for (auto const& vertex : vertices)
-        {
-            auto const nbytes = vertex.size() * sizeof(float);
-            memcpy(current, vertex.data(), nbytes);
-            current += nbytes;
-        }
+        // All attributes are 32-bit floats, so no conversion is needed
+        memcpy(dst, values.data(), vertex_data_size());
+        return;
     }
-    else
+
+    for (size_t i = 0; i < attributes.size(); ++i)
     {
-        auto current = dst_c;
+        auto const& attrib = attributes[i];
 
-        for (size_t i = 0; i < formats.size(); ++i)
+        if (interleave)
         {
-            auto const offset = std::accumulate(formats.begin(), formats.begin() + i, 0);
-            auto const nbytes = formats[i] * sizeof(float);
-
-            for (auto const& vertex : vertices)
-            {
-                memcpy(current, &vertex[offset], nbytes);
-                current += nbytes;
-            }
+            attrib.convert(values.data() + attrib.value_offset, vertex_num_values,
+                           dst_c + attrib.offset, vertex_size_, vertex_count);
+        }
+        else
+        {
+            attrib.convert(values.data() + attrib.value_offset, vertex_num_values,
+                           dst_c + binding_offsets[i], attrib.size, vertex_count);
         }
     }
 }
@@ -291,17 +518,50 @@ std::vector<vk::DeviceSize> Mesh::vertex_data_binding_offsets() const
     }
     else
     {
-        for (size_t i = 0; i < formats.size(); ++i)
-        {
-            auto attrib_offset = std::accumulate(formats.begin(), formats.begin() + i, 0);
-            ret.push_back(attrib_offset * sizeof(float) * vertices.size());
-        }
+        for (auto const& attrib : attributes)
+            ret.push_back(attrib.offset * vertex_count);
     }
 
     return ret;
 }
 
+size_t Mesh::vertex_size() const
+{
+    return vertex_size_;
+}
+
 size_t Mesh::vertex_data_size() const
 {
-    return vertices.size() * vertex_num_floats * sizeof(float);
+    return vertex_count * vertex_size_;
+}
+
+vk::IndexType Mesh::index_type() const
+{
+    if (vertex_count <= std::numeric_limits<uint16_t>::max() + 1u)
+        return vk::IndexType::eUint16;
+    else
+        return vk::IndexType::eUint32;
+}
+
+size_t Mesh::index_data_size() const
+{
+    auto const index_size =
+        index_type() == vk::IndexType::eUint16 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+    return indices.size() * index_size;
+}
+
+void Mesh::copy_index_data_to(void* dst) const
+{
+    if (index_type() == vk::IndexType::eUint16)
+    {
+        auto current = static_cast<uint16_t*>(dst);
+
+        for (auto const index : indices)
+            *current++ = static_cast<uint16_t>(index);
+    }
+    else
+    {
+        memcpy(dst, indices.data(), indices.size() * sizeof(uint32_t));
+    }
 }
@@ -27,6 +27,11 @@
 
 class VertexData;
 
+// Attribute values are kept as floats and converted to the vertex formats
+// when copying the vertex data. Besides the 32-bit float formats, 16-bit
+// float, normalized and packed formats are supported. Formats with four
+// components, for which no equally compact three component format is widely
+// supported, also accept three component data, padding the fourth with 0.
 class Mesh
 {
 public:
@@ -34,6 +39,11 @@ public:
 
     void set_interleave(bool interleave_);
 
+    std::vector<vk::Format> const& vertex_formats() const;
+
+    void reserve_vertices(size_t count);
+    // Appends count vertices from tightly packed, interleaved attribute values
+    void add_vertices(float const* values, size_t count);
     void next_vertex();
     size_t num_vertices() const;
     void set_attribute(size_t pos, float data);
@@ -41,22 +51,65 @@ public:
     void set_attribute(size_t pos, glm::vec3 const& data);
     void set_attribute(size_t pos, glm::vec4 const& data);
 
-    glm::vec3 min_attribute_bound(size_t pos);
-    glm::vec3 max_attribute_bound(size_t pos);
+    void add_index(uint32_t index);
+    size_t num_indices() const;
+    std::vector<uint32_t> const& index_list() const;
+    void set_indices(std::vector<uint32_t> indices_);
+    // Moves each vertex i to position remap[i], updating the indices to match
+    void remap_vertices(std::vector<uint32_t> const& remap);
+
+    // Attribute values of all vertices in interleaved layout, before
+    // conversion to the vertex formats and regardless of set_interleave()
+    float const* vertex_values() const;
+    size_t num_vertex_values() const;
+    float const* vertex_attribute_values(size_t vertex, size_t pos) const;
+
+    glm::vec3 min_attribute_bound(size_t pos) const;
+    glm::vec3 max_attribute_bound(size_t pos) const;
 
     // Vulkan related
     std::vector<vk::VertexInputBindingDescription> binding_descriptions() const;
     std::vector<vk::VertexInputAttributeDescription> attribute_descriptions() const;
 
+    size_t vertex_size() const;
     size_t vertex_data_size() const;
+    // Writes the vertex data in the layout selected by set_interleave(),
+    // suitable for writing directly into mapped buffer memory
     void copy_vertex_data_to(void* dst) const;
     std::vector<vk::DeviceSize> vertex_data_binding_offsets() const;
 
+    // 16-bit indices are used when all vertices are addressable with them
+    vk::IndexType index_type() const;
+    size_t index_data_size() const;
+    void copy_index_data_to(void* dst) const;
+
+    struct Attribute
+    {
+        // Number of float values stored, and accepted by set_attribute()
+        size_t num_values;
+        size_t min_num_values;
+        // Offset of the values within a vertex
+        size_t value_offset;
+        // Size and offset in an interleaved vertex of the converted data
+        size_t size;
+        size_t offset;
+        // Converts count vertices, stride values/bytes apart
+        void (*convert)(float const* src, size_t src_stride,
+                        char* dst, size_t dst_stride, size_t count);
+    };
+
 private:
+    float* attribute_values(size_t pos, size_t num, char const* error);
+
     std::vector<vk::Format> const vk_formats;
-    std::vector<size_t> const formats;
-    size_t const vertex_num_floats;
+    std::vector<Attribute> const attributes;
+    size_t const vertex_num_values;
+    size_t const vertex_size_;
 
     bool interleave;
-    std::vector<std::vector<float>> vertices;
+    size_t vertex_count;
+    // All vertices stored contiguously, with the attributes of each vertex
+    // at the precomputed offsets
+    std::vector<float> values;
+    std::vector<uint32_t> indices;
 };
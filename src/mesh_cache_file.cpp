@@ -0,0 +1,235 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mesh_cache_file.h"
+#include "mesh.h"
+#include "util.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+char const mesh_cache_file_magic[8] = {'v', 'k', 'm', 'a', 'r', 'k', 'm', '1'};
+
+struct MeshCacheFileHeader
+{
+    char magic[8];
+    uint64_t key_size;
+    uint64_t num_formats;
+    uint64_t num_vertices;
+    uint64_t num_indices;
+    uint64_t vertex_data_offset;
+    uint64_t index_data_offset;
+};
+
+size_t const mesh_cache_file_data_alignment = 64;
+
+struct MappedFile
+{
+    MappedFile(std::string const& path)
+        : data{nullptr}, size{0}
+    {
+        int const fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            auto const map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED)
+            {
+                data = static_cast<char const*>(map);
+                size = st.st_size;
+            }
+        }
+
+        close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if (data)
+            munmap(const_cast<char*>(data), size);
+    }
+
+    char const* data;
+    size_t size;
+};
+
+size_t index_size(vk::IndexType type)
+{
+    return type == vk::IndexType::eUint16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+template<typename T>
+void add_indices(Mesh& mesh, char const* data, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        T index;
+        memcpy(&index, data + i * sizeof(index), sizeof(index));
+        mesh.add_index(index);
+    }
+}
+
+}
+
+std::unique_ptr<Mesh> read_mesh_cache_file(std::string const& path,
+                                           std::string const& key)
+{
+    MappedFile const file{path};
+    MeshCacheFileHeader header;
+
+    if (file.size < sizeof(header))
+        return nullptr;
+
+    memcpy(&header, file.data, sizeof(header));
+
+    auto const formats_offset = sizeof(header) + key.size();
+
+    if (memcmp(header.magic, mesh_cache_file_magic, sizeof(header.magic)) ||
+        header.key_size != key.size() ||
+        formats_offset > file.size ||
+        memcmp(file.data + sizeof(header), key.data(), key.size()) ||
+        header.num_formats > (file.size - formats_offset) / sizeof(uint32_t) ||
+        formats_offset + header.num_formats * sizeof(uint32_t) > header.vertex_data_offset ||
+        header.vertex_data_offset > header.index_data_offset ||
+        header.index_data_offset > file.size)
+    {
+        return nullptr;
+    }
+
+    std::vector<vk::Format> formats(header.num_formats);
+    for (size_t i = 0; i < formats.size(); ++i)
+    {
+        uint32_t format;
+        memcpy(&format, file.data + formats_offset + i * sizeof(format), sizeof(format));
+        formats[i] = static_cast<vk::Format>(format);
+    }
+
+    try
+    {
+        auto mesh = std::make_unique<Mesh>(formats);
+
+        auto const vertex_data_size = header.index_data_offset - header.vertex_data_offset;
+        auto const vertex_values_size = mesh->num_vertex_values() * sizeof(float);
+        if (vertex_values_size == 0 ||
+            header.num_vertices != vertex_data_size / vertex_values_size ||
+            vertex_data_size % vertex_values_size != 0)
+        {
+            return nullptr;
+        }
+
+        mesh->add_vertices(
+            reinterpret_cast<float const*>(file.data + header.vertex_data_offset),
+            header.num_vertices);
+
+        auto const index_data_size = file.size - header.index_data_offset;
+        if (header.num_indices != index_data_size / index_size(mesh->index_type()) ||
+            index_data_size % index_size(mesh->index_type()) != 0)
+        {
+            return nullptr;
+        }
+
+        auto const index_data = file.data + header.index_data_offset;
+        if (mesh->index_type() == vk::IndexType::eUint16)
+            add_indices<uint16_t>(*mesh, index_data, header.num_indices);
+        else
+            add_indices<uint32_t>(*mesh, index_data, header.num_indices);
+
+        return mesh;
+    }
+    catch (std::exception const&)
+    {
+        // Unsupported vertex formats or out of range indices
+        return nullptr;
+    }
+}
+
+bool write_mesh_cache_file(std::string const& path,
+                           std::string const& key,
+                           Mesh const& mesh)
+{
+    auto const tmp_path = Util::get_temporary_file_path(path);
+    auto const& formats = mesh.vertex_formats();
+    auto const vertex_values_size =
+        mesh.num_vertices() * mesh.num_vertex_values() * sizeof(float);
+
+    MeshCacheFileHeader header;
+    memcpy(header.magic, mesh_cache_file_magic, sizeof(header.magic));
+    header.key_size = key.size();
+    header.num_formats = formats.size();
+    header.num_vertices = mesh.num_vertices();
+    header.num_indices = mesh.num_indices();
+    header.vertex_data_offset =
+        (sizeof(header) + key.size() + formats.size() * sizeof(uint32_t) +
+         mesh_cache_file_data_alignment - 1) /
+        mesh_cache_file_data_alignment * mesh_cache_file_data_alignment;
+    header.index_data_offset = header.vertex_data_offset + vertex_values_size;
+
+    std::vector<uint32_t> file_formats;
+    for (auto const format : formats)
+        file_formats.push_back(static_cast<uint32_t>(format));
+
+    std::vector<char> const padding(
+        header.vertex_data_offset - sizeof(header) - key.size() -
+        file_formats.size() * sizeof(uint32_t));
+
+    std::vector<char> index_data(mesh.index_data_size());
+    mesh.copy_index_data_to(index_data.data());
+
+    {
+        std::ofstream ofs{tmp_path, std::ios::binary | std::ios::trunc};
+        ofs.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        ofs.write(key.data(), key.size());
+        ofs.write(reinterpret_cast<char const*>(file_formats.data()),
+                  file_formats.size() * sizeof(uint32_t));
+        ofs.write(padding.data(), padding.size());
+        ofs.write(reinterpret_cast<char const*>(mesh.vertex_values()),
+                  vertex_values_size);
+        ofs.write(index_data.data(), index_data.size());
+
+        if (ofs)
+            ofs.close();
+        if (!ofs)
+        {
+            unlink(tmp_path.c_str());
+            return false;
+        }
+    }
+
+    // Rename atomically, so that concurrent readers never see partial files
+    if (rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        unlink(tmp_path.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+class Mesh;
+
+// Meshes can be stored in a compact binary file, so that later runs can
+// skip model parsing and memory-map the vertex and index data instead.
+// Files are identified by a key describing the source of the mesh, which is
+// checked on reading, so stale or unrelated files are never used.
+//
+// On-disk layout: header, key, vertex formats, padding, interleaved vertex
+// attribute values, index data in the format given by Mesh::index_type()
+
+// Returns nullptr if the file doesn't exist or doesn't match the key
+std::unique_ptr<Mesh> read_mesh_cache_file(std::string const& path,
+                                           std::string const& key);
+// Returns false if the file couldn't be written
+bool write_mesh_cache_file(std::string const& path,
+                           std::string const& key,
+                           Mesh const& mesh);
@@ -0,0 +1,246 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mesh_optimizer.h"
+#include "mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+// The vertex cache optimization follows Tom Forsyth's "Linear-Speed Vertex
+// Cache Optimisation": vertices are scored by their position in a simulated
+// LRU cache and by how many of their triangles remain, and the triangle with
+// the highest total score is emitted next.
+size_t const cache_size = 32;
+float const cache_decay_power = 1.5f;
+float const last_triangle_score = 0.75f;
+float const valence_boost_scale = 2.0f;
+float const valence_boost_power = 0.5f;
+
+float vertex_score(int cache_position, uint32_t remaining_triangles)
+{
+    // Vertices not used by any remaining triangle don't matter
+    if (remaining_triangles == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+
+    if (cache_position >= 0)
+    {
+        // The vertices of the last triangle get a fixed score, so that the
+        // next triangle doesn't strongly prefer reusing one particular edge
+        if (cache_position < 3)
+        {
+            score = last_triangle_score;
+        }
+        else
+        {
+            auto const scale = 1.0f / (cache_size - 3);
+            score = std::pow(1.0f - (cache_position - 3) * scale, cache_decay_power);
+        }
+    }
+
+    // Boost vertices with few remaining triangles, to finish them off
+    score += valence_boost_scale *
+             std::pow(static_cast<float>(remaining_triangles), -valence_boost_power);
+
+    return score;
+}
+
+void check_triangle_list(Mesh const& mesh)
+{
+    if (mesh.num_indices() == 0 || mesh.num_indices() % 3 != 0)
+        throw std::logic_error{"Trying to optimize mesh that isn't an indexed triangle list"};
+}
+
+}
+
+void optimize_vertex_cache(Mesh& mesh)
+{
+    check_triangle_list(mesh);
+
+    auto const& indices = mesh.index_list();
+    auto const num_vertices = mesh.num_vertices();
+    auto const num_triangles = indices.size() / 3;
+
+    // Triangles using each vertex, as ranges into vertex_triangles. The first
+    // remaining_triangles[v] entries of each range are the unemitted ones.
+    std::vector<uint32_t> triangles_offset(num_vertices + 1);
+    std::vector<uint32_t> remaining_triangles(num_vertices);
+
+    for (auto const index : indices)
+        ++remaining_triangles[index];
+    for (size_t v = 0; v < num_vertices; ++v)
+        triangles_offset[v + 1] = triangles_offset[v] + remaining_triangles[v];
+
+    std::vector<uint32_t> vertex_triangles(indices.size());
+    std::vector<uint32_t> fill(triangles_offset.begin(), triangles_offset.end() - 1);
+
+    for (size_t i = 0; i < indices.size(); ++i)
+        vertex_triangles[fill[indices[i]]++] = i / 3;
+
+    std::vector<int> cache_position(num_vertices, -1);
+    std::vector<float> score(num_vertices);
+    std::vector<float> triangle_score(num_triangles);
+    std::vector<bool> emitted(num_triangles);
+
+    for (size_t v = 0; v < num_vertices; ++v)
+        score[v] = vertex_score(-1, remaining_triangles[v]);
+
+    for (size_t t = 0; t < num_triangles; ++t)
+    {
+        triangle_score[t] =
+            score[indices[3 * t]] + score[indices[3 * t + 1]] + score[indices[3 * t + 2]];
+    }
+
+    std::vector<uint32_t> optimized;
+    optimized.reserve(indices.size());
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> new_cache;
+    size_t next_unemitted = 0;
+
+    auto best_triangle = static_cast<size_t>(
+        std::max_element(triangle_score.begin(), triangle_score.end()) -
+        triangle_score.begin());
+
+    while (optimized.size() < indices.size())
+    {
+        auto const tri = &indices[3 * best_triangle];
+
+        emitted[best_triangle] = true;
+        optimized.insert(optimized.end(), tri, tri + 3);
+
+        // Remove the triangle from the remaining triangles of its vertices
+        for (int i = 0; i < 3; ++i)
+        {
+            auto const v = tri[i];
+            auto const begin = vertex_triangles.begin() + triangles_offset[v];
+            auto const end = begin + remaining_triangles[v];
+
+            std::iter_swap(std::find(begin, end, best_triangle), end - 1);
+            --remaining_triangles[v];
+        }
+
+        // Move the triangle's vertices to the front of the cache
+        new_cache.assign(tri, tri + 3);
+        for (auto const v : cache)
+        {
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+                new_cache.push_back(v);
+        }
+
+        for (size_t i = 0; i < new_cache.size(); ++i)
+        {
+            auto const v = new_cache[i];
+            cache_position[v] = i < cache_size ? static_cast<int>(i) : -1;
+            score[v] = vertex_score(cache_position[v], remaining_triangles[v]);
+        }
+
+        // Rescore the remaining triangles of all vertices whose score changed,
+        // including the ones just evicted, and pick the best one
+        float best_score = -1.0f;
+        best_triangle = num_triangles;
+
+        for (auto const v : new_cache)
+        {
+            auto const begin = vertex_triangles.begin() + triangles_offset[v];
+            auto const end = begin + remaining_triangles[v];
+
+            for (auto t = begin; t != end; ++t)
+            {
+                auto const ti = &indices[3 * *t];
+                triangle_score[*t] = score[ti[0]] + score[ti[1]] + score[ti[2]];
+
+                if (triangle_score[*t] > best_score)
+                {
+                    best_score = triangle_score[*t];
+                    best_triangle = *t;
+                }
+            }
+        }
+
+        if (new_cache.size() > cache_size)
+            new_cache.resize(cache_size);
+        cache.swap(new_cache);
+
+        // No cached vertex has remaining triangles, so continue with any
+        // unemitted triangle
+        if (best_triangle == num_triangles)
+        {
+            while (next_unemitted < num_triangles && emitted[next_unemitted])
+                ++next_unemitted;
+            best_triangle = next_unemitted;
+            if (best_triangle == num_triangles)
+                break;
+        }
+    }
+
+    mesh.set_indices(std::move(optimized));
+}
+
+void optimize_vertex_fetch(Mesh& mesh)
+{
+    auto const num_vertices = mesh.num_vertices();
+    uint32_t const unmapped = num_vertices;
+
+    std::vector<uint32_t> remap(num_vertices, unmapped);
+    uint32_t next = 0;
+
+    for (auto const index : mesh.index_list())
+    {
+        if (remap[index] == unmapped)
+            remap[index] = next++;
+    }
+
+    // Vertices not referenced by any index go to the end
+    for (auto& r : remap)
+    {
+        if (r == unmapped)
+            r = next++;
+    }
+
+    mesh.remap_vertices(remap);
+}
+
+float vertex_cache_miss_ratio(Mesh const& mesh, size_t cache_size)
+{
+    check_triangle_list(mesh);
+
+    std::vector<uint32_t> cache(cache_size, mesh.num_vertices());
+    size_t cache_next = 0;
+    size_t misses = 0;
+
+    for (auto const index : mesh.index_list())
+    {
+        if (std::find(cache.begin(), cache.end(), index) == cache.end())
+        {
+            cache[cache_next] = index;
+            cache_next = (cache_next + 1) % cache_size;
+            ++misses;
+        }
+    }
+
+    return static_cast<float>(misses) / (mesh.num_indices() / 3);
+}
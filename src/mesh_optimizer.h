@@ -0,0 +1,35 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+class Mesh;
+
+// Reorders the triangles of an indexed triangle list mesh, so that vertices
+// are reused while they are still in the GPU post-transform vertex cache
+void optimize_vertex_cache(Mesh& mesh);
+// Reorders the vertices of an indexed mesh in the order they are first
+// referenced, so that vertex fetches access memory mostly sequentially
+void optimize_vertex_fetch(Mesh& mesh);
+
+// Average number of vertex shader invocations per triangle, for a FIFO
+// post-transform cache of the specified size (lower is better, 0.5 is optimal)
+float vertex_cache_miss_ratio(Mesh const& mesh, size_t cache_size);
@@ -0,0 +1,194 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mesh_simplifier.h"
+#include "mesh.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+using Triangle = std::array<uint32_t, 3>;
+
+size_t const max_grid_size = 4096;
+
+class VertexClustering
+{
+public:
+    VertexClustering(Mesh const& mesh, size_t position_attribute)
+        : mesh{mesh},
+          position_attribute{position_attribute},
+          min_bound{mesh.min_attribute_bound(position_attribute)}
+    {
+        auto const extent = mesh.max_attribute_bound(position_attribute) - min_bound;
+        max_extent = std::max({extent.x, extent.y, extent.z, 1e-6f});
+    }
+
+    // Returns the triangles remaining after clustering on a grid with
+    // grid_size cells along the longest axis of the mesh, referencing the
+    // vertex of each cell that is closest to the cell's average position
+    std::vector<Triangle> cluster(size_t grid_size)
+    {
+        auto const num_vertices = mesh.num_vertices();
+        auto const cell_size = max_extent / grid_size;
+
+        std::unordered_map<uint64_t, uint32_t> cell_ids;
+        std::vector<uint32_t> vertex_cell(num_vertices);
+        std::vector<glm::vec3> cell_sum;
+        std::vector<uint32_t> cell_count;
+
+        for (size_t v = 0; v < num_vertices; ++v)
+        {
+            auto const p = position(v);
+            uint64_t key = 0;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                auto const c = std::min(
+                    static_cast<uint64_t>((p[i] - min_bound[i]) / cell_size),
+                    static_cast<uint64_t>(grid_size - 1));
+                key = key * grid_size + c;
+            }
+
+            auto const iter = cell_ids.emplace(key, cell_ids.size()).first;
+            vertex_cell[v] = iter->second;
+
+            if (iter->second == cell_sum.size())
+            {
+                cell_sum.push_back(glm::vec3{0.0f});
+                cell_count.push_back(0);
+            }
+
+            cell_sum[iter->second] = cell_sum[iter->second] + p;
+            ++cell_count[iter->second];
+        }
+
+        std::vector<uint32_t> representative(cell_sum.size(), num_vertices);
+        std::vector<float> representative_dist(cell_sum.size());
+
+        for (size_t v = 0; v < num_vertices; ++v)
+        {
+            auto const cell = vertex_cell[v];
+            auto const average = cell_sum[cell] / static_cast<float>(cell_count[cell]);
+            auto const dist = glm::length(position(v) - average);
+
+            if (representative[cell] == num_vertices || dist < representative_dist[cell])
+            {
+                representative[cell] = v;
+                representative_dist[cell] = dist;
+            }
+        }
+
+        auto const& indices = mesh.index_list();
+        std::vector<Triangle> triangles;
+
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            Triangle t{{representative[vertex_cell[indices[i]]],
+                        representative[vertex_cell[indices[i + 1]]],
+                        representative[vertex_cell[indices[i + 2]]]}};
+
+            if (t[0] == t[1] || t[1] == t[2] || t[2] == t[0])
+                continue;
+
+            // Rotate the lowest index first, preserving the winding, so that
+            // duplicate triangles compare equal
+            std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+            triangles.push_back(t);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+        return triangles;
+    }
+
+private:
+    glm::vec3 position(size_t v) const
+    {
+        auto const p = mesh.vertex_attribute_values(v, position_attribute);
+        return {p[0], p[1], p[2]};
+    }
+
+    Mesh const& mesh;
+    size_t const position_attribute;
+    glm::vec3 const min_bound;
+    float max_extent;
+};
+
+}
+
+std::unique_ptr<Mesh> simplify_mesh(Mesh const& mesh,
+                                    size_t position_attribute,
+                                    size_t target_triangles)
+{
+    if (mesh.num_indices() == 0 || mesh.num_indices() % 3 != 0)
+        throw std::logic_error{"Trying to simplify mesh that isn't an indexed triangle list"};
+
+    VertexClustering clustering{mesh, position_attribute};
+
+    // The triangle count grows (almost) monotonically with the grid size,
+    // so binary search for the finest grid meeting the target
+    std::vector<Triangle> best;
+    size_t low = 1;
+    size_t high = max_grid_size;
+
+    while (low <= high)
+    {
+        auto const grid_size = (low + high) / 2;
+        auto triangles = clustering.cluster(grid_size);
+
+        if (triangles.size() <= target_triangles)
+        {
+            if (triangles.size() >= best.size())
+                best = std::move(triangles);
+            low = grid_size + 1;
+        }
+        else
+        {
+            high = grid_size - 1;
+        }
+    }
+
+    // Keep only the referenced vertices, in order of first use
+    auto simplified = std::make_unique<Mesh>(mesh.vertex_formats());
+    std::unordered_map<uint32_t, uint32_t> new_index;
+    std::vector<uint32_t> indices;
+
+    for (auto const& t : best)
+    {
+        for (auto const v : t)
+        {
+            auto const iter = new_index.emplace(v, new_index.size()).first;
+            if (iter->second == simplified->num_vertices())
+                simplified->add_vertices(mesh.vertex_values() + v * mesh.num_vertex_values(), 1);
+            indices.push_back(iter->second);
+        }
+    }
+
+    simplified->set_indices(std::move(indices));
+
+    return simplified;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+class Mesh;
+
+// Simplifies an indexed triangle list mesh to at most target_triangles
+// triangles, by merging all vertices within each cell of a uniform grid
+// over the positions into one, and dropping the collapsed triangles. The
+// finest grid meeting the target is used, so detail is removed evenly.
+std::unique_ptr<Mesh> simplify_mesh(Mesh const& mesh,
+                                    size_t position_attribute,
+                                    size_t target_triangles);
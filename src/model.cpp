@@ -23,11 +23,17 @@
 #include "model.h"
 #include "util.h"
 #include "mesh.h"
+#include "mesh_cache_file.h"
+#include "log.h"
+#include "lru_cache.h"
 
 #include <assimp/scene.h>
 #include <assimp/mesh.h>
 #include <assimp/postprocess.h>
 
+#include <functional>
+#include <sstream>
+
 namespace
 {
 
@@ -37,10 +43,137 @@ unsigned int const post_process_flags =
     aiProcess_GenNormals |
     aiProcess_JoinIdenticalVertices;
 
+struct CachedMesh
+{
+    std::shared_ptr<Mesh const> mesh;
+    int64_t mtime_ns;
+};
+
+std::string mesh_cache_dir;
+LruCache<CachedMesh> mesh_cache{256 * 1024 * 1024};
+
+std::string mesh_cache_key(std::string const& model_file,
+                           ModelAttribMap const& map,
+                           bool indexed)
+{
+    std::stringstream ss;
+
+    ss << model_file << (indexed ? ":indexed" : "")
+       << (map.interleave ? ":interleaved" : "");
+    for (auto const format : map.formats)
+        ss << ":" << static_cast<int>(format);
+    ss << ":" << map.position << ":" << map.color
+       << ":" << map.normal << ":" << map.texcoord;
+
+    return ss.str();
+}
+
+std::string mesh_cache_file_path(std::string const& key)
+{
+    std::stringstream ss;
+    ss << mesh_cache_dir << "/" << std::hex << std::hash<std::string>{}(key) << ".mesh";
+    return ss.str();
+}
+
+std::unique_ptr<Mesh> read_or_convert_model(std::string const& model_file,
+                                            ModelAttribMap const& map,
+                                            bool indexed,
+                                            std::string const& key,
+                                            int64_t mtime_ns)
+{
+    if (mesh_cache_dir.empty() || mtime_ns < 0)
+        return Model{model_file}.to_mesh(map, indexed);
+
+    // The file name doesn't depend on the modification time, so that the
+    // cache file of a model that has changed is replaced, and the key stored
+    // in the file does, so that the stale contents are not used
+    auto const path = mesh_cache_file_path(key);
+    auto const file_key = key + ":" + std::to_string(mtime_ns);
+
+    auto mesh = read_mesh_cache_file(path, file_key);
+    if (mesh)
+    {
+        mesh->set_interleave(map.interleave);
+    }
+    else
+    {
+        mesh = Model{model_file}.to_mesh(map, indexed);
+        if (!write_mesh_cache_file(path, file_key, *mesh))
+            Log::debug("Model: Failed to write mesh cache file %s\n", path.c_str());
+    }
+
+    return mesh;
+}
+
+size_t num_mesh_vertices(aiScene const* scene, bool indexed)
+{
+    size_t ret = 0;
+
+    for (auto m = 0u; m < scene->mNumMeshes; ++m)
+    {
+        auto const aimesh = scene->mMeshes[m];
+
+        if (indexed)
+        {
+            ret += aimesh->mNumVertices;
+        }
+        else
+        {
+            for (auto f = 0u; f < aimesh->mNumFaces; ++f)
+                ret += aimesh->mFaces[f].mNumIndices;
+        }
+    }
+
+    return ret;
+}
+
+void add_mesh_vertex(Mesh& mesh, aiMesh const* aimesh, unsigned int vindex,
+                     ModelAttribMap const& map)
+{
+    auto const colors = aimesh->mColors[0];
+    auto const texcoords = aimesh->mTextureCoords[0];
+    auto const& vertex = aimesh->mVertices[vindex];
+    auto const& normal = aimesh->mNormals[vindex];
+
+    mesh.next_vertex();
+
+    if (map.position >= 0)
+        mesh.set_attribute(map.position, {vertex.x, -vertex.y, vertex.z});
+
+    if (map.normal >= 0)
+        mesh.set_attribute(map.normal, {normal.x, -normal.y, normal.z});
+
+    if (map.color >= 0)
+    {
+        if (colors)
+        {
+            auto const& color = colors[vindex];
+            mesh.set_attribute(map.color, {color.r, color.g, color.b});
+        }
+        else
+        {
+            mesh.set_attribute(map.color, {1, 1, 1});
+        }
+    }
+
+    if (map.texcoord >= 0)
+    {
+        if (texcoords)
+        {
+            auto const& texcoord = texcoords[vindex];
+            mesh.set_attribute(map.texcoord, {texcoord.x, 1.0 - texcoord.y});
+        }
+        else
+        {
+            mesh.set_attribute(map.texcoord, {0, 0});
+        }
+    }
+}
+
 }
 
 ModelAttribMap::ModelAttribMap()
-    : position{-1}, color{-1}, normal{-1}, texcoord{-1}
+    : position{-1}, color{-1}, normal{-1}, texcoord{-1}, interleave{false}
 {
 }
 
@@ -78,6 +211,12 @@ ModelAttribMap& ModelAttribMap::with_other(vk::Format format)
     return *this;
 }
 
+ModelAttribMap& ModelAttribMap::with_interleave(bool interleave_)
+{
+    interleave = interleave_;
+    return *this;
+}
+
 Model::Model(std::string const& model_file)
 {
     importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE,
@@ -102,64 +241,77 @@ Model::Model(std::string const& model_str, std::string const& model_type)
 
 Model::~Model() = default;
 
-std::unique_ptr<Mesh> Model::to_mesh(ModelAttribMap const& map)
+std::unique_ptr<Mesh> Model::to_mesh(ModelAttribMap const& map, bool indexed)
 {
     auto mesh = std::make_unique<Mesh>(map.formats);
+    mesh->set_interleave(map.interleave);
 
     auto const scene = importer.GetScene();
 
+    mesh->reserve_vertices(num_mesh_vertices(scene, indexed));
+
     for (auto m = 0u; m < scene->mNumMeshes; ++m)
     {
         auto const aimesh = scene->mMeshes[m];
-        auto const colors = aimesh->mColors[0];
-        auto const texcoords = aimesh->mTextureCoords[0];
 
-        for (auto f = 0u; f < aimesh->mNumFaces; ++f)
+        if (indexed)
         {
-            auto const& face = aimesh->mFaces[f];
+            auto const base_index = mesh->num_vertices();
+
+            for (auto v = 0u; v < aimesh->mNumVertices; ++v)
+                add_mesh_vertex(*mesh, aimesh, v, map);
 
-            for (auto i = 0u; i < face.mNumIndices; ++i)
+            for (auto f = 0u; f < aimesh->mNumFaces; ++f)
             {
-                auto const vindex = face.mIndices[i];
-                auto const& vertex = aimesh->mVertices[vindex];
-                auto const& normal = aimesh->mNormals[vindex];
-
-                mesh->next_vertex();
-
-                if (map.position >= 0)
-                    mesh->set_attribute(map.position, {vertex.x, -vertex.y, vertex.z});
-
-                if (map.normal >= 0)
-                    mesh->set_attribute(map.normal, {normal.x, -normal.y, normal.z});
-
-                if (map.color >= 0)
-                {
-                    if (colors)
-                    {
-                        auto const& color = colors[vindex];
-                        mesh->set_attribute(map.color, {color.r, color.g, color.b});
-                    }
-                    else
-                    {
-                        mesh->set_attribute(map.color, {1, 1, 1});
-                    }
-                }
-
-                if (map.texcoord >= 0)
-                {
-                    if (texcoords)
-                    {
-                        auto const& texcoord = texcoords[vindex];
-                        mesh->set_attribute(map.texcoord, {texcoord.x, 1.0 - texcoord.y});
-                    }
-                    else
-                    {
-                        mesh->set_attribute(map.texcoord, {0, 0});
-                    }
-                }
+                auto const& face = aimesh->mFaces[f];
+
+                for (auto i = 0u; i < face.mNumIndices; ++i)
+                    mesh->add_index(base_index + face.mIndices[i]);
+            }
+        }
+        else
+        {
+            for (auto f = 0u; f < aimesh->mNumFaces; ++f)
+            {
+                auto const& face = aimesh->mFaces[f];
+
+                for (auto i = 0u; i < face.mNumIndices; ++i)
+                    add_mesh_vertex(*mesh, aimesh, face.mIndices[i], map);
             }
         }
     }
 
     return mesh;
 }
+
+std::shared_ptr<Mesh const> Model::load_mesh(std::string const& model_file,
+                                             ModelAttribMap const& map,
+                                             bool indexed)
+{
+    auto const mtime_ns = Util::get_file_mtime_ns(
+        Util::get_data_file_path("models/" + model_file));
+    auto const key = mesh_cache_key(model_file, map, indexed);
+
+    // Entries for models that have since changed are replaced
+    CachedMesh cached;
+    if (mesh_cache.find(key, cached) && cached.mtime_ns == mtime_ns)
+        return cached.mesh;
+
+    std::shared_ptr<Mesh const> const mesh{
+        read_or_convert_model(model_file, map, indexed, key, mtime_ns)};
+
+    mesh_cache.insert(key, CachedMesh{mesh, mtime_ns},
+                      mesh->vertex_data_size() + mesh->index_data_size());
+
+    return mesh;
+}
+
+void Model::set_mesh_cache_dir(std::string const& dir)
+{
+    mesh_cache_dir = dir;
+}
+
+void Model::clear_mesh_cache()
+{
+    mesh_cache.clear();
+}
@@ -39,12 +39,15 @@ public:
     ModelAttribMap& with_normal(vk::Format format);
     ModelAttribMap& with_texcoord(vk::Format format);
     ModelAttribMap& with_other(vk::Format format);
+    // Selects the Mesh::set_interleave() layout of the converted meshes
+    ModelAttribMap& with_interleave(bool interleave_);
 
     std::vector<vk::Format> formats;
     ssize_t position;
     ssize_t color;
     ssize_t normal;
     ssize_t texcoord;
+    bool interleave;
 };
 
 class Model
@@ -54,7 +57,20 @@ public:
     Model(std::string const& model_str, std::string const& model_type);
     ~Model();
 
-    std::unique_ptr<Mesh> to_mesh(ModelAttribMap const& map);
+    // With indexed, each model vertex is emitted once and faces are
+    // described by indices, otherwise faces are expanded into unique vertices
+    std::unique_ptr<Mesh> to_mesh(ModelAttribMap const& map, bool indexed = false);
+
+    // Loads a model data file and converts it to a mesh. Recently loaded
+    // meshes are cached, and subsequent loads with the same arguments share
+    // the cached mesh, which is why it's read-only. If a mesh cache directory
+    // is set, converted meshes are also stored there and memory-mapped on
+    // later runs, skipping model parsing altogether.
+    static std::shared_ptr<Mesh const> load_mesh(std::string const& model_file,
+                                                 ModelAttribMap const& map,
+                                                 bool indexed = false);
+    static void set_mesh_cache_dir(std::string const& dir);
+    static void clear_mesh_cache();
 
 private:
     Assimp::Importer importer;
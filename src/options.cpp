@@ -46,6 +46,8 @@ struct option long_options[] = {
     {"show-all-options", 0, 0, 0},
     {"winsys-dir", 1, 0, 0},
     {"data-dir", 1, 0, 0},
+    {"image-cache-dir", 1, 0, 0},
+    {"mesh-cache-dir", 1, 0, 0},
     {"winsys", 1, 0, 0},
     {"winsys-options", 1, 0, 0},
     {"list-devices", 0, 0, 0},
@@ -135,6 +137,8 @@ Options::Options()
       show_all_options{false},
       window_system_dir{VKMARK_WINDOW_SYSTEM_DIR},
       data_dir{VKMARK_DATA_DIR},
+      image_cache_dir{},
+      mesh_cache_dir{},
       run_forever{false},
       show_debug{false},
       show_help{false},
@@ -162,6 +166,10 @@ std::string Options::help_string()
         "                              (only explicitly set options are shown by default)\n"
         "      --winsys-dir DIR        Directory to search in for window system plugins\n"
         "      --data-dir DIR          Directory to search in for scene data files\n"
+        "      --image-cache-dir DIR   Directory to store decoded images in, to speed up\n"
+        "                              subsequent runs (default: no on-disk cache)\n"
+        "      --mesh-cache-dir DIR    Directory to store converted model meshes in, to\n"
+        "                              speed up subsequent runs (default: no on-disk cache)\n"
         "      --winsys WS             Window system plugin to use (default: choose best)\n"
         "                              [xcb, wayland, kms]\n"
         "      --winsys-options OPTS   Window system options as 'opt1=val1(:opt2=val2)*'\n"
@@ -217,6 +225,10 @@ bool Options::parse_args(int argc, char **argv)
             window_system_dir = optarg;
         else if (optname == "data-dir")
             data_dir = optarg;
+        else if (optname == "image-cache-dir")
+            image_cache_dir = optarg;
+        else if (optname == "mesh-cache-dir")
+            mesh_cache_dir = optarg;
         else if (optname == "winsys")
             window_system = optarg;
         else if (optname == "winsys-options")
@@ -52,6 +52,8 @@ struct Options
     bool show_all_options;
     std::string window_system_dir;
     std::string data_dir;
+    std::string image_cache_dir;
+    std::string mesh_cache_dir;
     std::string window_system;
     std::vector<WindowSystemOption> window_system_options;
     bool run_forever;
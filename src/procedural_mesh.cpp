@@ -0,0 +1,173 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "procedural_mesh.h"
+#include "mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+float const pi = 3.14159265358979f;
+
+struct SurfacePoint
+{
+    glm::vec3 position;
+    glm::vec3 normal;
+};
+
+// Adds a grid of (nu + 1) x (nv + 1) vertices sampled from a parametric
+// surface over [0,1]x[0,1], and the 2 x nu x nv triangles between them
+void add_parametric_surface(
+    Mesh& mesh, std::vector<uint32_t>& indices, size_t nu, size_t nv,
+    std::function<SurfacePoint(float, float)> const& surface)
+{
+    auto const base = static_cast<uint32_t>(mesh.num_vertices());
+
+    for (size_t j = 0; j <= nv; ++j)
+    {
+        for (size_t i = 0; i <= nu; ++i)
+        {
+            auto const point = surface(static_cast<float>(i) / nu,
+                                       static_cast<float>(j) / nv);
+            mesh.next_vertex();
+            mesh.set_attribute(0, point.position);
+            mesh.set_attribute(1, point.normal);
+        }
+    }
+
+    auto const row = static_cast<uint32_t>(nu + 1);
+
+    for (uint32_t j = 0; j < nv; ++j)
+    {
+        for (uint32_t i = 0; i < nu; ++i)
+        {
+            auto const v = base + j * row + i;
+            for (auto const index : {v, v + row, v + 1, v + 1, v + row, v + row + 1})
+                indices.push_back(index);
+        }
+    }
+}
+
+size_t at_least_one(double n)
+{
+    return std::max<size_t>(1, std::lround(n));
+}
+
+// A cube with subdivided faces projected onto the unit sphere, which avoids
+// the degenerate triangles at the poles of a latitude/longitude sphere
+void generate_sphere(Mesh& mesh, std::vector<uint32_t>& indices, size_t triangles)
+{
+    auto const n = at_least_one(std::sqrt(triangles / 12.0));
+
+    glm::vec3 const axes[3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+
+    for (int face = 0; face < 6; ++face)
+    {
+        auto const normal = axes[face % 3] * (face < 3 ? 1.0f : -1.0f);
+        auto const u_axis = axes[(face + 1) % 3] * (face < 3 ? 1.0f : -1.0f);
+        auto const v_axis = axes[(face + 2) % 3];
+
+        mesh.reserve_vertices(mesh.num_vertices() + (n + 1) * (n + 1));
+        add_parametric_surface(
+            mesh, indices, n, n,
+            [&] (float u, float v)
+            {
+                auto const p = glm::normalize(
+                    normal + u_axis * (2.0f * u - 1.0f) + v_axis * (2.0f * v - 1.0f));
+                return SurfacePoint{p, p};
+            });
+    }
+}
+
+void generate_torus(Mesh& mesh, std::vector<uint32_t>& indices, size_t triangles)
+{
+    float const major_radius = 1.0f;
+    float const minor_radius = 0.4f;
+
+    // Keep quads roughly square, with the major circle being ~2.5x longer
+    auto const nv = at_least_one(std::sqrt(triangles / 5.0));
+    auto const nu = at_least_one(triangles / (2.0 * nv));
+
+    mesh.reserve_vertices((nu + 1) * (nv + 1));
+    add_parametric_surface(
+        mesh, indices, nu, nv,
+        [&] (float u, float v)
+        {
+            auto const a = -2.0f * pi * u;
+            auto const b = 2.0f * pi * v;
+            glm::vec3 const n{std::cos(a) * std::cos(b), std::sin(b), std::sin(a) * std::cos(b)};
+            glm::vec3 const c{major_radius * std::cos(a), 0.0f, major_radius * std::sin(a)};
+            return SurfacePoint{c + n * minor_radius, n};
+        });
+}
+
+void generate_heightfield(Mesh& mesh, std::vector<uint32_t>& indices, size_t triangles)
+{
+    auto const n = at_least_one(std::sqrt(triangles / 2.0));
+    float const amplitude = 0.1f;
+    float const frequency = 6.0f * pi;
+
+    mesh.reserve_vertices((n + 1) * (n + 1));
+    add_parametric_surface(
+        mesh, indices, n, n,
+        [&] (float u, float v)
+        {
+            auto const x = 2.0f * u - 1.0f;
+            auto const z = 2.0f * v - 1.0f;
+            // Up is -y in the vulkan coordinate system
+            auto const y = -amplitude * std::sin(frequency * u) * std::cos(frequency * v);
+            // Partial derivatives of the height with respect to x and z
+            auto const dx = amplitude * frequency / 2.0f *
+                            std::cos(frequency * u) * std::cos(frequency * v);
+            auto const dz = -amplitude * frequency / 2.0f *
+                            std::sin(frequency * u) * std::sin(frequency * v);
+            return SurfacePoint{{x, y, z}, glm::normalize(glm::vec3{-dx, -1.0f, -dz})};
+        });
+}
+
+}
+
+std::unique_ptr<Mesh> generate_procedural_mesh(std::string const& shape,
+                                               size_t target_triangles)
+{
+    auto mesh = std::make_unique<Mesh>(
+        std::vector<vk::Format>{vk::Format::eR32G32B32Sfloat,
+                                vk::Format::eR32G32B32Sfloat});
+    std::vector<uint32_t> indices;
+    indices.reserve(target_triangles * 3 + target_triangles / 10);
+
+    if (shape == "sphere")
+        generate_sphere(*mesh, indices, target_triangles);
+    else if (shape == "torus")
+        generate_torus(*mesh, indices, target_triangles);
+    else if (shape == "heightfield")
+        generate_heightfield(*mesh, indices, target_triangles);
+    else
+        throw std::logic_error{"Unknown procedural mesh shape " + shape};
+
+    mesh->set_indices(std::move(indices));
+
+    return mesh;
+}
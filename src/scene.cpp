@@ -59,6 +59,10 @@ bool Scene::is_valid() const
     return true;
 }
 
+void Scene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+}
+
 void Scene::setup(VulkanState&, std::vector<VulkanImage> const&)
 {
     duration = 1000000.0 * Util::from_string<double>(options_["duration"].value);
@@ -128,6 +132,11 @@ unsigned int Scene::average_fps() const
     return current_frame / elapsed_time_sec;
 }
 
+std::string Scene::extra_results() const
+{
+    return {};
+}
+
 bool Scene::is_running() const
 {
     return running;
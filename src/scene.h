@@ -55,6 +55,11 @@ public:
     virtual ~Scene() = default;
 
     virtual bool is_valid() const;
+    // Performs the CPU-only parts of setup (e.g., reading and decoding data
+    // files) for the given option values, populating the data caches used by
+    // setup(). May be called from another thread while the scene is in use,
+    // so it mustn't modify the scene.
+    virtual void prefetch(std::unordered_map<std::string, SceneOption> const& options) const;
     virtual void setup(VulkanState&, std::vector<VulkanImage> const&);
     virtual void teardown();
 
@@ -65,6 +70,8 @@ public:
     std::string name() const;
     std::string info_string(bool show_all_options) const;
     unsigned int average_fps() const;
+    // Scene specific results (e.g., throughput), shown after the FPS
+    virtual std::string extra_results() const;
     bool is_running() const;
 
     bool set_option(std::string const& opt, std::string const& val);
@@ -0,0 +1,722 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "async_compute_scene.h"
+
+#include "log.h"
+#include "mesh.h"
+#include "particles.h"
+#include "procedural_mesh.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 normal;
+    glm::vec4 material_diffuse;
+};
+
+uint32_t const max_particles = 10000000;
+uint32_t const max_steps = 1000;
+uint32_t const min_triangles = 1000;
+uint32_t const max_triangles = 50000000;
+uint32_t const workgroup_size = 64;
+// Graphics start and end, compute start and end
+uint32_t const queries_per_frame = 4;
+
+void generate_particles(Particle* particles, size_t count)
+{
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> coord{-1.0f, 1.0f};
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        particles[i] = Particle{
+            {coord(rng), coord(rng), coord(rng), 1.0f},
+            {0.0f, 0.0f, 0.0f, 0.0f}};
+    }
+}
+
+uint64_t timestamp_mask(uint32_t valid_bits)
+{
+    return valid_bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << valid_bits) - 1;
+}
+
+}
+
+AsyncComputeScene::AsyncComputeScene() : Scene{"async-compute"}
+{
+    options_["mode"] =
+        SceneOption("mode", "async",
+                    "How to submit the compute work: to a compute-only queue, or "
+                    "serialized with the rendering on the graphics queue",
+                    "async,serial");
+
+    options_["particles"] =
+        SceneOption("particles", "1000000",
+                    "The number of particles the compute work simulates (1 to 10000000)");
+
+    options_["steps"] =
+        SceneOption("steps", "10",
+                    "The number of integration steps per frame (1 to 1000)");
+
+    options_["triangles"] =
+        SceneOption("triangles", "1000000",
+                    "The number of triangles to render (1000 to 50000000)");
+}
+
+AsyncComputeScene::~AsyncComputeScene() = default;
+
+void AsyncComputeScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    Util::read_data_file("shaders/light-basic.vert.spv");
+    Util::read_data_file("shaders/light-basic.frag.spv");
+    Util::read_data_file("shaders/particles.comp.spv");
+}
+
+void AsyncComputeScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    Scene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+
+    num_particles = Util::ranged_option_value<uint32_t>(
+        "particles", options_["particles"].value, 1, max_particles);
+    num_steps = Util::ranged_option_value<uint32_t>(
+        "steps", options_["steps"].value, 1, max_steps);
+    auto const num_triangles = Util::ranged_option_value<uint32_t>(
+        "triangles", options_["triangles"].value, min_triangles, max_triangles);
+
+    auto const num_workgroups = (num_particles + workgroup_size - 1) / workgroup_size;
+    auto const max_workgroups =
+        vulkan->physical_device().getProperties().limits.maxComputeWorkGroupCount[0];
+
+    if (num_workgroups > max_workgroups)
+    {
+        throw std::runtime_error(
+            "\"particles\" option must be at most " +
+            std::to_string(static_cast<uint64_t>(max_workgroups) * workgroup_size) +
+            " on this device");
+    }
+
+    async = options_["mode"].value == "async";
+
+    if (async && !vulkan->has_async_compute_queue())
+    {
+        Log::warning("AsyncComputeScene: No compute-only queue family available, "
+                     "submitting the compute work to the graphics queue\n");
+    }
+
+    if (async)
+    {
+        compute_queue = vulkan->compute_queue();
+        compute_queue_family_index = vulkan->compute_queue_family_index();
+    }
+    else
+    {
+        compute_queue = vulkan->graphics_queue();
+        compute_queue_family_index = vulkan->graphics_queue_family_index();
+    }
+
+    mesh = generate_procedural_mesh("sphere", num_triangles);
+    mesh->set_interleave(true);
+    num_indices = mesh->num_indices();
+    index_type = mesh->index_type();
+
+    auto const radius = glm::length(mesh->max_attribute_bound(0) - mesh->min_attribute_bound(0)) / 2.0f;
+    auto const aspect = static_cast<float>(extent.width)/static_cast<float>(extent.height);
+    auto const fovy = 2.0f * atanf(radius / (2.0f + radius));
+    view_distance = 2.0f + radius;
+    projection = glm::perspective(fovy, aspect, 2.0f, 2.0f + 2.0f * radius);
+
+    auto const command_pool_create_info = vk::CommandPoolCreateInfo{}
+        .setQueueFamilyIndex(compute_queue_family_index);
+    compute_command_pool = ManagedResource<vk::CommandPool>{
+        vulkan->device().createCommandPool(command_pool_create_info),
+        [this] (auto const& cp) { vulkan->device().destroyCommandPool(cp); }};
+
+    setup_vertex_buffer();
+    setup_index_buffer();
+    setup_uniform_buffer();
+    setup_uniform_descriptor_set();
+    setup_render_pass();
+    setup_pipeline();
+    setup_framebuffers(vulkan_images);
+    setup_timestamps();
+    setup_particle_buffer();
+    setup_storage_image();
+    setup_compute_descriptor_set();
+    setup_compute_pipeline();
+    setup_command_buffers();
+
+    mesh.reset();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    render_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    compute_semaphores.push_back(vkutil::SemaphoreBuilder{*vulkan}.build());
+    compute_semaphores.push_back(vkutil::SemaphoreBuilder{*vulkan}.build());
+
+    frame_count = 0;
+    graphics_time_ns = 0.0;
+    compute_time_ns = 0.0;
+    num_timed_frames = 0;
+    rotation = 0.0f;
+}
+
+void AsyncComputeScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    compute_semaphores.clear();
+    render_semaphore = {};
+    submit_semaphore = {};
+
+    for (auto const& frame : frames)
+    {
+        if (frame.fence)
+            vulkan->device().destroyFence(frame.fence);
+        if (frame.compute_fence)
+            vulkan->device().destroyFence(frame.compute_fence);
+        vulkan->device().freeCommandBuffers(vulkan->command_pool(), frame.command_buffer);
+        vulkan->device().freeCommandBuffers(compute_command_pool, frame.compute_command_buffer);
+    }
+    frames.clear();
+
+    query_pool = {};
+    compute_pipeline = {};
+    compute_pipeline_layout = {};
+    compute_descriptor_set = {};
+    storage_image_view = {};
+    storage_image = {};
+    particle_buffer = {};
+    compute_command_pool = {};
+    framebuffers.clear();
+    image_views.clear();
+    pipeline = {};
+    pipeline_layout = {};
+    render_pass = {};
+    descriptor_set = {};
+    uniform_buffer_map = {};
+    uniform_buffer = {};
+    index_buffer = {};
+    vertex_buffer = {};
+
+    Scene::teardown();
+}
+
+VulkanImage AsyncComputeScene::draw(VulkanImage const& image)
+{
+    auto& frame = frames[image.index];
+
+    if (!frame.fence)
+    {
+        frame.fence = vulkan->device().createFence(vk::FenceCreateInfo());
+        frame.compute_fence = vulkan->device().createFence(vk::FenceCreateInfo());
+    }
+    else
+    {
+        std::array<vk::Fence, 2> const fences{{frame.fence, frame.compute_fence}};
+        vulkan->device().waitForFences(fences, true, INT64_MAX);
+        vulkan->device().resetFences(fences);
+        accumulate_timestamps(image.index);
+    }
+
+    update_uniforms();
+
+    // Serialized compute work waits for the rendering of the previous frame
+    vk::PipelineStageFlags const compute_wait_mask = vk::PipelineStageFlagBits::eAllCommands;
+    auto const& compute_semaphore = compute_semaphores[frame_count % 2];
+    bool const compute_wait = !async && frame_count > 0;
+
+    auto const compute_submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&frame.compute_command_buffer)
+        .setWaitSemaphoreCount(compute_wait ? 1 : 0)
+        .setPWaitSemaphores(&render_semaphore.raw)
+        .setPWaitDstStageMask(&compute_wait_mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&compute_semaphore.raw);
+
+    compute_queue.submit(compute_submit_info, frame.compute_fence);
+
+    // The rendering doesn't read the particles, but it waits for the compute
+    // work as if it consumed its results, like a real producer-consumer
+    // workload would: the results of the previous frame when running
+    // asynchronously, leaving the compute work of this frame free to overlap
+    // with the rendering, otherwise the results of this frame
+    std::vector<vk::Semaphore> wait_semaphores;
+    std::vector<vk::PipelineStageFlags> wait_masks;
+
+    if (image.semaphore)
+    {
+        wait_semaphores.push_back(image.semaphore);
+        wait_masks.push_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+    }
+
+    if (!async)
+    {
+        wait_semaphores.push_back(compute_semaphore);
+        wait_masks.push_back(vk::PipelineStageFlagBits::eAllCommands);
+    }
+    else if (frame_count > 0)
+    {
+        wait_semaphores.push_back(compute_semaphores[(frame_count - 1) % 2]);
+        wait_masks.push_back(vk::PipelineStageFlagBits::eAllCommands);
+    }
+
+    std::array<vk::Semaphore, 2> const signal_semaphores{{submit_semaphore, render_semaphore}};
+
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&frame.command_buffer)
+        .setWaitSemaphoreCount(wait_semaphores.size())
+        .setPWaitSemaphores(wait_semaphores.data())
+        .setPWaitDstStageMask(wait_masks.data())
+        .setSignalSemaphoreCount(async ? 1 : 2)
+        .setPSignalSemaphores(signal_semaphores.data());
+
+    vulkan->graphics_queue().submit(submit_info, frame.fence);
+
+    ++frame_count;
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void AsyncComputeScene::update()
+{
+    auto const t = (Util::get_timestamp_us() - start_time) / 1000000.0f;
+
+    rotation = 36.0f * t;
+
+    Scene::update();
+}
+
+std::string AsyncComputeScene::extra_results() const
+{
+    std::stringstream ss;
+
+    ss << "Mode: " << (async ? "async" : "serial")
+       << " Compute queue: "
+       << (compute_queue_family_index != vulkan->graphics_queue_family_index() ?
+           "dedicated" : "graphics");
+
+    if (!timestamps_supported || num_timed_frames == 0)
+    {
+        ss << " Overlap: unavailable";
+        return ss.str();
+    }
+
+    // The GPU time of each kind of work, and the frame time, tell how much
+    // of the serialized time is saved by overlapping the work
+    auto const compute_ms = compute_time_ns / num_timed_frames / 1000000.0;
+    auto const graphics_ms = graphics_time_ns / num_timed_frames / 1000000.0;
+    auto const frame_ms = 1000.0 / average_fps();
+    auto const overlap = std::max(0.0, std::min(1.0,
+        (compute_ms + graphics_ms - frame_ms) / std::min(compute_ms, graphics_ms)));
+
+    ss << std::fixed << std::setprecision(2)
+       << " Compute: " << compute_ms << " ms"
+       << " Graphics: " << graphics_ms << " ms"
+       << " Serialized: " << compute_ms + graphics_ms << " ms"
+       << " Overlap: " << std::setprecision(0) << overlap * 100.0 << "%";
+
+    return ss.str();
+}
+
+void AsyncComputeScene::setup_timestamps()
+{
+    auto const queue_families = vulkan->physical_device().getQueueFamilyProperties();
+    auto const graphics_valid_bits =
+        queue_families[vulkan->graphics_queue_family_index()].timestampValidBits;
+    auto const compute_valid_bits =
+        queue_families[compute_queue_family_index].timestampValidBits;
+
+    timestamps_supported = graphics_valid_bits > 0 && compute_valid_bits > 0;
+    timestamp_period = vulkan->physical_device().getProperties().limits.timestampPeriod;
+    graphics_timestamp_mask = timestamp_mask(graphics_valid_bits);
+    compute_timestamp_mask = timestamp_mask(compute_valid_bits);
+
+    if (!timestamps_supported)
+    {
+        Log::warning("AsyncComputeScene: Timestamp queries are not supported, "
+                     "overlap will not be measured\n");
+        return;
+    }
+
+    auto const query_pool_create_info = vk::QueryPoolCreateInfo{}
+        .setQueryType(vk::QueryType::eTimestamp)
+        .setQueryCount(queries_per_frame * framebuffers.size());
+
+    query_pool = ManagedResource<vk::QueryPool>{
+        vulkan->device().createQueryPool(query_pool_create_info),
+        [this] (auto const& qp) { vulkan->device().destroyQueryPool(qp); }};
+}
+
+void AsyncComputeScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
+
+void AsyncComputeScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(*vulkan, *mesh);
+}
+
+void AsyncComputeScene::setup_uniform_buffer()
+{
+    uniform_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(sizeof(Uniforms))
+        .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(uniform_buffer_memory)
+        .build();
+
+    uniform_buffer_map = vkutil::map_memory(
+        *vulkan, uniform_buffer_memory, 0, sizeof(Uniforms));
+}
+
+void AsyncComputeScene::setup_uniform_descriptor_set()
+{
+    descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eUniformBuffer)
+        .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+        .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+        .set_layout_out(descriptor_set_layout)
+        .build();
+}
+
+void AsyncComputeScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void AsyncComputeScene::setup_pipeline()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    // The sphere is convex, so culling the back faces is enough to draw it
+    // correctly without a depth buffer
+    pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_vertex_shader(Util::read_data_file("shaders/light-basic.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/light-basic.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .build();
+}
+
+void AsyncComputeScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views({image_view})
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void AsyncComputeScene::setup_particle_buffer()
+{
+    // Upload on the queue that uses the buffer, to avoid transferring the
+    // buffer ownership between queue families
+    particle_buffer = vkutil::create_device_local_buffer(
+        *vulkan, num_particles * sizeof(Particle),
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        [this] (void* dst) { generate_particles(static_cast<Particle*>(dst), num_particles); },
+        compute_command_pool, compute_queue);
+}
+
+void AsyncComputeScene::setup_storage_image()
+{
+    // The shader needs an image to draw the particles to, but the scene
+    // doesn't display them, so a single pixel, which is never written to,
+    // is enough
+    storage_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent({1, 1})
+        .set_format(vk::Format::eR8G8B8A8Unorm)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eStorage)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    storage_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(storage_image)
+        .set_format(vk::Format::eR8G8B8A8Unorm)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+        .build();
+}
+
+void AsyncComputeScene::setup_compute_descriptor_set()
+{
+    compute_descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eStorageBuffer)
+        .set_stage_flags(vk::ShaderStageFlagBits::eCompute)
+        .set_buffer(particle_buffer, 0, num_particles * sizeof(Particle))
+        .next_binding()
+        .set_type(vk::DescriptorType::eStorageImage)
+        .set_stage_flags(vk::ShaderStageFlagBits::eCompute)
+        .set_image_view(storage_image_view, vk::ImageLayout::eGeneral)
+        .set_layout_out(compute_descriptor_set_layout)
+        .build();
+}
+
+void AsyncComputeScene::setup_compute_pipeline()
+{
+    auto const push_constant_range = vk::PushConstantRange{}
+        .setStageFlags(vk::ShaderStageFlagBits::eCompute)
+        .setOffset(0)
+        .setSize(sizeof(ParticlePushConstants));
+
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&compute_descriptor_set_layout)
+        .setPushConstantRangeCount(1)
+        .setPPushConstantRanges(&push_constant_range);
+    compute_pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    compute_pipeline = vkutil::ComputePipelineBuilder{*vulkan}
+        .set_layout(compute_pipeline_layout)
+        .set_shader(Util::read_data_file("shaders/particles.comp.spv"))
+        .set_specialization_constants({workgroup_size})
+        .build();
+}
+
+void AsyncComputeScene::setup_command_buffers()
+{
+    frames.resize(framebuffers.size());
+
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(frames.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+    auto const compute_command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(compute_command_pool)
+        .setCommandBufferCount(frames.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    auto const command_buffers =
+        vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+    auto const compute_command_buffers =
+        vulkan->device().allocateCommandBuffers(compute_command_buffer_allocate_info);
+
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+
+    // An empty image size keeps the shader from drawing the particles
+    ParticlePushConstants push_constants;
+    push_constants.particle_count = num_particles;
+    push_constants.steps = num_steps;
+    push_constants.time_step = 0.01f / num_steps;
+    push_constants.scale = 0.0f;
+    push_constants.image_size[0] = 0;
+    push_constants.image_size[1] = 0;
+
+    auto const num_workgroups = (num_particles + workgroup_size - 1) / workgroup_size;
+
+    // The particles are updated in place, so each dispatch has to see the
+    // results of the previous one
+    auto const particle_barrier = vk::MemoryBarrier{}
+        .setSrcAccessMask(vk::AccessFlagBits::eShaderWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+
+    auto const image_barrier = vk::ImageMemoryBarrier{}
+        .setImage(storage_image)
+        .setOldLayout(vk::ImageLayout::eUndefined)
+        .setNewLayout(vk::ImageLayout::eGeneral)
+        .setSrcAccessMask({})
+        .setDstAccessMask(vk::AccessFlagBits::eShaderWrite)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setSubresourceRange(
+            vk::ImageSubresourceRange{}
+                .setAspectMask(vk::ImageAspectFlagBits::eColor)
+                .setBaseMipLevel(0)
+                .setLevelCount(1)
+                .setBaseArrayLayer(0)
+                .setLayerCount(1));
+
+    for (uint32_t i = 0; i < frames.size(); ++i)
+    {
+        auto& frame = frames[i];
+        auto const first_query = i * queries_per_frame;
+
+        frame.command_buffer = command_buffers[i];
+        frame.compute_command_buffer = compute_command_buffers[i];
+
+        // Compute
+        frame.compute_command_buffer.begin(vk::CommandBufferBeginInfo{});
+
+        if (timestamps_supported)
+        {
+            frame.compute_command_buffer.resetQueryPool(query_pool, first_query + 2, 2);
+            frame.compute_command_buffer.writeTimestamp(
+                vk::PipelineStageFlagBits::eTopOfPipe, query_pool, first_query + 2);
+        }
+
+        frame.compute_command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eComputeShader,
+            vk::PipelineStageFlagBits::eComputeShader,
+            {}, particle_barrier, {}, image_barrier);
+
+        frame.compute_command_buffer.bindPipeline(
+            vk::PipelineBindPoint::eCompute, compute_pipeline);
+        frame.compute_command_buffer.bindDescriptorSets(
+            vk::PipelineBindPoint::eCompute, compute_pipeline_layout, 0,
+            compute_descriptor_set.raw, {});
+        frame.compute_command_buffer.pushConstants(
+            compute_pipeline_layout, vk::ShaderStageFlagBits::eCompute,
+            0, sizeof(push_constants), &push_constants);
+        frame.compute_command_buffer.dispatch(num_workgroups, 1, 1);
+
+        if (timestamps_supported)
+        {
+            frame.compute_command_buffer.writeTimestamp(
+                vk::PipelineStageFlagBits::eBottomOfPipe, query_pool, first_query + 3);
+        }
+
+        frame.compute_command_buffer.end();
+
+        // Graphics
+        frame.command_buffer.begin(vk::CommandBufferBeginInfo{});
+
+        // The start timestamp is written at the stage the wait for the
+        // acquired image applies to, so that the time spent waiting for the
+        // presentation engine isn't counted as rendering time
+        if (timestamps_supported)
+        {
+            frame.command_buffer.resetQueryPool(query_pool, first_query, 2);
+            frame.command_buffer.writeTimestamp(
+                vk::PipelineStageFlagBits::eColorAttachmentOutput, query_pool, first_query);
+        }
+
+        vk::ClearValue const clear_value{
+            vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}}};
+
+        auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(render_pass)
+            .setFramebuffer(framebuffers[i])
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(1)
+            .setPClearValues(&clear_value);
+
+        frame.command_buffer.beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+        frame.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+        frame.command_buffer.bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, descriptor_set.raw, {});
+        frame.command_buffer.bindVertexBuffers(
+            0,
+            std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+            binding_offsets
+            );
+        frame.command_buffer.bindIndexBuffer(index_buffer, 0, index_type);
+        frame.command_buffer.drawIndexed(num_indices, 1, 0, 0, 0);
+        frame.command_buffer.endRenderPass();
+
+        if (timestamps_supported)
+        {
+            frame.command_buffer.writeTimestamp(
+                vk::PipelineStageFlagBits::eBottomOfPipe, query_pool, first_query + 1);
+        }
+
+        frame.command_buffer.end();
+    }
+}
+
+void AsyncComputeScene::update_uniforms()
+{
+    Uniforms ubo;
+
+    glm::mat4 modelview{1.0};
+    modelview = glm::translate(modelview, glm::vec3{0.0f, 0.0f, -view_distance});
+    modelview = glm::rotate(modelview, glm::radians(rotation), {0.0f, 1.0f, 0.0f});
+
+    ubo.modelviewprojection = projection * modelview;
+    ubo.normal = glm::inverseTranspose(modelview);
+    ubo.material_diffuse = glm::vec4{0.7f, 0.7f, 0.7f, 1.0};
+
+    memcpy(uniform_buffer_map, &ubo, sizeof(ubo));
+}
+
+void AsyncComputeScene::accumulate_timestamps(uint32_t frame)
+{
+    if (!timestamps_supported)
+        return;
+
+    std::array<uint64_t, queries_per_frame> timestamps;
+
+    auto const result = vulkan->device().getQueryPoolResults(
+        query_pool, frame * queries_per_frame, queries_per_frame,
+        sizeof(timestamps), timestamps.data(), sizeof(uint64_t),
+        vk::QueryResultFlagBits::e64);
+
+    if (result != vk::Result::eSuccess)
+        return;
+
+    graphics_time_ns +=
+        ((timestamps[1] - timestamps[0]) & graphics_timestamp_mask) * timestamp_period;
+    compute_time_ns +=
+        ((timestamps[3] - timestamps[2]) & compute_timestamp_mask) * timestamp_period;
+    ++num_timed_frames;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "scene.h"
+#include "managed_resource.h"
+
+#include <memory>
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+// Runs a compute job every frame while rendering a mesh, with the compute
+// work either submitted to a compute-only queue, so that it can overlap with
+// the rendering, or serialized with the rendering on the graphics queue.
+// The GPU time of both kinds of work is measured with timestamp queries, to
+// report how much of it overlaps.
+class AsyncComputeScene : public Scene
+{
+public:
+    AsyncComputeScene();
+    ~AsyncComputeScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+    void update() override;
+
+    std::string extra_results() const override;
+
+private:
+    struct Frame
+    {
+        vk::CommandBuffer command_buffer;
+        vk::CommandBuffer compute_command_buffer;
+        vk::Fence fence;
+        vk::Fence compute_fence;
+    };
+
+    void setup_timestamps();
+    void setup_vertex_buffer();
+    void setup_index_buffer();
+    void setup_uniform_buffer();
+    void setup_uniform_descriptor_set();
+    void setup_render_pass();
+    void setup_pipeline();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_particle_buffer();
+    void setup_storage_image();
+    void setup_compute_descriptor_set();
+    void setup_compute_pipeline();
+    void setup_command_buffers();
+    void update_uniforms();
+    void accumulate_timestamps(uint32_t frame);
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+    glm::mat4 projection;
+    float view_distance;
+
+    bool async;
+    vk::Queue compute_queue;
+    uint32_t compute_queue_family_index;
+
+    std::unique_ptr<Mesh> mesh;
+    uint32_t num_indices;
+    vk::IndexType index_type;
+    uint32_t num_particles;
+    uint32_t num_steps;
+
+    ManagedResource<vk::Buffer> vertex_buffer;
+    ManagedResource<vk::Buffer> index_buffer;
+    ManagedResource<vk::Buffer> uniform_buffer;
+    ManagedResource<void*> uniform_buffer_map;
+    ManagedResource<vk::DescriptorSet> descriptor_set;
+    ManagedResource<vk::RenderPass> render_pass;
+    ManagedResource<vk::PipelineLayout> pipeline_layout;
+    ManagedResource<vk::Pipeline> pipeline;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+
+    ManagedResource<vk::CommandPool> compute_command_pool;
+    ManagedResource<vk::Buffer> particle_buffer;
+    ManagedResource<vk::Image> storage_image;
+    ManagedResource<vk::ImageView> storage_image_view;
+    ManagedResource<vk::DescriptorSet> compute_descriptor_set;
+    ManagedResource<vk::PipelineLayout> compute_pipeline_layout;
+    ManagedResource<vk::Pipeline> compute_pipeline;
+
+    ManagedResource<vk::QueryPool> query_pool;
+    std::vector<Frame> frames;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+    // Signaled by the rendering, to serialize the compute work after it
+    ManagedResource<vk::Semaphore> render_semaphore;
+    // Signaled by the compute work, alternating between frames, since the
+    // rendering waits for the compute work of the previous frame
+    std::vector<ManagedResource<vk::Semaphore>> compute_semaphores;
+    uint64_t frame_count;
+
+    vk::DeviceMemory uniform_buffer_memory;
+    vk::DescriptorSetLayout descriptor_set_layout;
+    vk::DescriptorSetLayout compute_descriptor_set_layout;
+
+    bool timestamps_supported;
+    double timestamp_period;
+    uint64_t graphics_timestamp_mask;
+    uint64_t compute_timestamp_mask;
+    double graphics_time_ns;
+    double compute_time_ns;
+    uint64_t num_timed_frames;
+
+    float rotation;
+};
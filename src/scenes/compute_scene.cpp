@@ -0,0 +1,503 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compute_scene.h"
+
+#include "mesh.h"
+#include "particles.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+uint32_t const max_particles = 10000000;
+uint32_t const max_steps = 1000;
+// Simulated time per frame, split evenly between the integration steps
+float const frame_time_step = 0.01f;
+// Must match the constants in particles.comp
+float const gravity = 0.1f;
+float const softening = 0.01f;
+
+std::unique_ptr<Mesh> create_quad_mesh()
+{
+    auto mesh = std::make_unique<Mesh>(
+        std::vector<vk::Format>{vk::Format::eR32G32Sfloat, vk::Format::eR32G32Sfloat});
+
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,-1});
+    mesh->set_attribute(1, {0,0});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,1});
+    mesh->set_attribute(1, {0,1});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,1});
+    mesh->set_attribute(1, {1,1});
+
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,-1});
+    mesh->set_attribute(1, {0,0});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,1});
+    mesh->set_attribute(1, {1,1});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,-1});
+    mesh->set_attribute(1, {1,0});
+
+    mesh->set_interleave(true);
+
+    return mesh;
+}
+
+// Places the particles in a thin disc, moving in circular orbits
+void generate_particles(Particle* particles, size_t count)
+{
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> unit{0.0f, 1.0f};
+    std::uniform_real_distribution<float> thickness{-0.02f, 0.02f};
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Uniformly distributed over the area of the disc
+        auto const r = std::sqrt(0.01f + 0.8f * unit(rng));
+        auto const angle = 2.0f * static_cast<float>(M_PI) * unit(rng);
+        // Speed at which the gravitational acceleration provides the
+        // centripetal acceleration
+        auto const r2 = r * r + softening;
+        auto const speed = r * std::sqrt(gravity / (r2 * std::sqrt(r2)));
+
+        particles[i] = Particle{
+            {r * std::cos(angle), r * std::sin(angle), thickness(rng), 1.0f},
+            {-speed * std::sin(angle), speed * std::cos(angle), 0.0f, 0.0f}};
+    }
+}
+
+}
+
+ComputeScene::ComputeScene() : Scene{"compute"}
+{
+    options_["particles"] =
+        SceneOption("particles", "100000",
+                    "The number of particles to simulate (1 to 10000000)");
+
+    options_["workgroup-size"] =
+        SceneOption("workgroup-size", "64",
+                    "The number of particles processed by each compute workgroup "
+                    "(1 to the device limit)");
+
+    options_["steps"] =
+        SceneOption("steps", "1",
+                    "The number of integration steps per frame (1 to 1000)");
+}
+
+ComputeScene::~ComputeScene() = default;
+
+void ComputeScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    Util::read_data_file("shaders/particles.comp.spv");
+    Util::read_data_file("shaders/effect2d.vert.spv");
+    Util::read_data_file("shaders/texture-view.frag.spv");
+}
+
+void ComputeScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    Scene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+
+    num_particles = Util::ranged_option_value<uint32_t>(
+        "particles", options_["particles"].value, 1, max_particles);
+    num_steps = Util::ranged_option_value<uint32_t>(
+        "steps", options_["steps"].value, 1, max_steps);
+
+    auto const& limits = vulkan->physical_device().getProperties().limits;
+    auto const max_workgroup_size = std::min(
+        limits.maxComputeWorkGroupSize[0], limits.maxComputeWorkGroupInvocations);
+
+    workgroup_size = Util::ranged_option_value<uint32_t>(
+        "workgroup-size", options_["workgroup-size"].value, 1, max_workgroup_size);
+
+    auto const num_workgroups = (num_particles + workgroup_size - 1) / workgroup_size;
+
+    if (num_workgroups > limits.maxComputeWorkGroupCount[0])
+    {
+        throw std::runtime_error(
+            "Dispatching " + std::to_string(num_workgroups) + " workgroups exceeds the "
+            "device limit of " + std::to_string(limits.maxComputeWorkGroupCount[0]) +
+            ", use a larger \"workgroup-size\"");
+    }
+
+    mesh = create_quad_mesh();
+
+    setup_particle_buffer();
+    setup_vertex_buffer();
+    setup_storage_image();
+    setup_sampler();
+    setup_descriptor_sets();
+    setup_render_pass();
+    setup_compute_pipeline();
+    setup_pipeline();
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+}
+
+void ComputeScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
+    framebuffers.clear();
+    image_views.clear();
+    pipeline = {};
+    pipeline_layout = {};
+    compute_pipeline = {};
+    compute_pipeline_layout = {};
+    render_pass = {};
+    descriptor_set = {};
+    compute_descriptor_set = {};
+    sampler = {};
+    storage_image_view = {};
+    storage_image = {};
+    vertex_buffer = {};
+    particle_buffer = {};
+
+    Scene::teardown();
+}
+
+VulkanImage ComputeScene::draw(VulkanImage const& image)
+{
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&command_buffers[image.index])
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, {});
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+std::string ComputeScene::extra_results() const
+{
+    std::stringstream ss;
+    ss << "Particles: " << num_particles << " Workgroup size: " << workgroup_size
+       << " Throughput: " << std::fixed << std::setprecision(2)
+       << static_cast<double>(num_particles) * num_steps * average_fps() / 1000000.0
+       << " Msteps/s";
+    return ss.str();
+}
+
+void ComputeScene::setup_particle_buffer()
+{
+    particle_buffer = vkutil::create_device_local_buffer(
+        *vulkan, num_particles * sizeof(Particle),
+        vk::BufferUsageFlagBits::eStorageBuffer,
+        [this] (void* dst)
+        {
+            generate_particles(static_cast<Particle*>(dst), num_particles);
+        });
+}
+
+void ComputeScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
+
+void ComputeScene::setup_storage_image()
+{
+    storage_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(vk::Format::eR8G8B8A8Unorm)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(
+            vk::ImageUsageFlagBits::eStorage |
+            vk::ImageUsageFlagBits::eSampled |
+            vk::ImageUsageFlagBits::eTransferDst)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    storage_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(storage_image)
+        .set_format(vk::Format::eR8G8B8A8Unorm)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+        .build();
+}
+
+void ComputeScene::setup_sampler()
+{
+    auto const sampler_create_info = vk::SamplerCreateInfo{}
+        .setMagFilter(vk::Filter::eNearest)
+        .setMinFilter(vk::Filter::eNearest)
+        .setAddressModeU(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeV(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeW(vk::SamplerAddressMode::eClampToEdge)
+        .setAnisotropyEnable(false)
+        .setUnnormalizedCoordinates(false)
+        .setCompareEnable(false)
+        .setMinLod(0.0f)
+        .setMaxLod(0.25f)
+        .setMipmapMode(vk::SamplerMipmapMode::eNearest);
+
+    sampler = ManagedResource<vk::Sampler>{
+        vulkan->device().createSampler(sampler_create_info),
+        [this] (auto const& s) { vulkan->device().destroySampler(s); }};
+}
+
+void ComputeScene::setup_descriptor_sets()
+{
+    compute_descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eStorageBuffer)
+        .set_stage_flags(vk::ShaderStageFlagBits::eCompute)
+        .set_buffer(particle_buffer, 0, num_particles * sizeof(Particle))
+        .next_binding()
+        .set_type(vk::DescriptorType::eStorageImage)
+        .set_stage_flags(vk::ShaderStageFlagBits::eCompute)
+        .set_image_view(storage_image_view, vk::ImageLayout::eGeneral)
+        .set_layout_out(compute_descriptor_set_layout)
+        .build();
+
+    descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eCombinedImageSampler)
+        .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+        .set_image_view(storage_image_view, sampler)
+        .set_layout_out(descriptor_set_layout)
+        .build();
+}
+
+void ComputeScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_color_load_op(vk::AttachmentLoadOp::eDontCare)
+        .build();
+}
+
+void ComputeScene::setup_compute_pipeline()
+{
+    auto const push_constant_range = vk::PushConstantRange{}
+        .setStageFlags(vk::ShaderStageFlagBits::eCompute)
+        .setOffset(0)
+        .setSize(sizeof(ParticlePushConstants));
+
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&compute_descriptor_set_layout)
+        .setPushConstantRangeCount(1)
+        .setPPushConstantRanges(&push_constant_range);
+    compute_pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    compute_pipeline = vkutil::ComputePipelineBuilder{*vulkan}
+        .set_layout(compute_pipeline_layout)
+        .set_shader(Util::read_data_file("shaders/particles.comp.spv"))
+        .set_specialization_constants({workgroup_size})
+        .build();
+}
+
+void ComputeScene::setup_pipeline()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    pipeline = vkutil::PipelineBuilder{*vulkan}
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_vertex_shader(Util::read_data_file("shaders/effect2d.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/texture-view.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .build();
+}
+
+void ComputeScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views({image_view})
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void ComputeScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(framebuffers.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+
+    ParticlePushConstants push_constants;
+    push_constants.particle_count = num_particles;
+    push_constants.steps = num_steps;
+    push_constants.time_step = frame_time_step / num_steps;
+    push_constants.scale = 0.45f * std::min(extent.width, extent.height);
+    push_constants.image_size[0] = extent.width;
+    push_constants.image_size[1] = extent.height;
+
+    auto const num_workgroups = (num_particles + workgroup_size - 1) / workgroup_size;
+
+    auto const subresource_range = vk::ImageSubresourceRange{}
+        .setAspectMask(vk::ImageAspectFlagBits::eColor)
+        .setBaseMipLevel(0)
+        .setLevelCount(1)
+        .setBaseArrayLayer(0)
+        .setLayerCount(1);
+
+    // The previous contents of the image are discarded, but the clear has to
+    // wait for the display pass of the previous frame to finish reading it
+    auto const clear_barrier = vk::ImageMemoryBarrier{}
+        .setImage(storage_image)
+        .setOldLayout(vk::ImageLayout::eUndefined)
+        .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setSrcAccessMask({})
+        .setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setSubresourceRange(subresource_range);
+
+    auto const compute_barrier = vk::ImageMemoryBarrier{}
+        .setImage(storage_image)
+        .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setNewLayout(vk::ImageLayout::eGeneral)
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderWrite)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setSubresourceRange(subresource_range);
+
+    // The particles are updated in place, so each dispatch has to see the
+    // results of the previous one
+    auto const particle_barrier = vk::MemoryBarrier{}
+        .setSrcAccessMask(vk::AccessFlagBits::eShaderWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite);
+
+    auto const display_barrier = vk::ImageMemoryBarrier{}
+        .setImage(storage_image)
+        .setOldLayout(vk::ImageLayout::eGeneral)
+        .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setSrcAccessMask(vk::AccessFlagBits::eShaderWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setSubresourceRange(subresource_range);
+
+    for (size_t i = 0; i < command_buffers.size(); ++i)
+    {
+        auto const begin_info = vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eSimultaneousUse);
+
+        command_buffers[i].begin(begin_info);
+
+        // Simulate and splat the particles
+        command_buffers[i].pipelineBarrier(
+            vk::PipelineStageFlagBits::eFragmentShader,
+            vk::PipelineStageFlagBits::eTransfer,
+            {}, {}, {}, clear_barrier);
+
+        command_buffers[i].clearColorImage(
+            storage_image,
+            vk::ImageLayout::eTransferDstOptimal,
+            vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+            subresource_range);
+
+        command_buffers[i].pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eComputeShader,
+            vk::PipelineStageFlagBits::eComputeShader,
+            {}, particle_barrier, {}, compute_barrier);
+
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eCompute, compute_pipeline);
+        command_buffers[i].bindDescriptorSets(
+            vk::PipelineBindPoint::eCompute, compute_pipeline_layout, 0,
+            compute_descriptor_set.raw, {});
+        command_buffers[i].pushConstants(
+            compute_pipeline_layout, vk::ShaderStageFlagBits::eCompute,
+            0, sizeof(push_constants), &push_constants);
+        command_buffers[i].dispatch(num_workgroups, 1, 1);
+
+        command_buffers[i].pipelineBarrier(
+            vk::PipelineStageFlagBits::eComputeShader,
+            vk::PipelineStageFlagBits::eFragmentShader,
+            {}, {}, {}, display_barrier);
+
+        // Display the image
+        auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(render_pass)
+            .setFramebuffer(framebuffers[i])
+            .setRenderArea({{0,0}, extent});
+
+        command_buffers[i].beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+
+        command_buffers[i].bindVertexBuffers(
+            0,
+            std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+            binding_offsets
+            );
+
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+        command_buffers[i].bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, descriptor_set.raw, {});
+        command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+
+        command_buffers[i].endRenderPass();
+        command_buffers[i].end();
+    }
+}
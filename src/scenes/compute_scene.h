@@ -0,0 +1,88 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "scene.h"
+#include "managed_resource.h"
+
+#include <memory>
+
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+// Integrates the motion of particles orbiting a central mass with a compute
+// shader, splatting them into a storage image which is then displayed with a
+// fullscreen pass
+class ComputeScene : public Scene
+{
+public:
+    ComputeScene();
+    ~ComputeScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+
+    std::string extra_results() const override;
+
+private:
+    void setup_particle_buffer();
+    void setup_vertex_buffer();
+    void setup_storage_image();
+    void setup_sampler();
+    void setup_descriptor_sets();
+    void setup_render_pass();
+    void setup_compute_pipeline();
+    void setup_pipeline();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_command_buffers();
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+
+    std::unique_ptr<Mesh> mesh;
+    uint32_t num_particles;
+    uint32_t workgroup_size;
+    uint32_t num_steps;
+
+    ManagedResource<vk::Buffer> particle_buffer;
+    ManagedResource<vk::Buffer> vertex_buffer;
+    ManagedResource<vk::Image> storage_image;
+    ManagedResource<vk::ImageView> storage_image_view;
+    ManagedResource<vk::Sampler> sampler;
+    ManagedResource<vk::DescriptorSet> compute_descriptor_set;
+    ManagedResource<vk::DescriptorSet> descriptor_set;
+    ManagedResource<vk::RenderPass> render_pass;
+    ManagedResource<vk::PipelineLayout> compute_pipeline_layout;
+    ManagedResource<vk::Pipeline> compute_pipeline;
+    ManagedResource<vk::PipelineLayout> pipeline_layout;
+    ManagedResource<vk::Pipeline> pipeline;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    std::vector<vk::CommandBuffer> command_buffers;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+
+    vk::DescriptorSetLayout compute_descriptor_set_layout;
+    vk::DescriptorSetLayout descriptor_set_layout;
+};
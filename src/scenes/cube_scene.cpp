@@ -45,36 +45,55 @@ struct Uniforms
     glm::mat4 normal;
 };
 
+std::shared_ptr<Mesh const> load_mesh(bool indexed)
+{
+    return Model::load_mesh(
+        "kmscube.ply",
+        ModelAttribMap{}
+            .with_position(vk::Format::eR32G32B32Sfloat)
+            .with_color(vk::Format::eR32G32B32Sfloat)
+            .with_normal(vk::Format::eR32G32B32Sfloat),
+        indexed);
+}
+
 }
 
-CubeScene::CubeScene() : Scene{"cube"}
+CubeScene::CubeScene() : MultisampleScene{"cube"}
 {
+    options_["indexed"] =
+        SceneOption("indexed", "false",
+                    "Whether to draw with an index buffer, sharing vertices between faces");
 }
 
 CubeScene::~CubeScene() = default;
 
+void CubeScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    load_mesh(options.at("indexed").value == "true");
+    Util::read_data_file("shaders/vkcube.vert.spv");
+    Util::read_data_file("shaders/vkcube.frag.spv");
+}
+
 void CubeScene::setup(
     VulkanState& vulkan_,
     std::vector<VulkanImage> const& vulkan_images)
 {
-    Scene::setup(vulkan_, vulkan_images);
+    MultisampleScene::setup(vulkan_, vulkan_images);
 
     vulkan = &vulkan_;
     extent = vulkan_images[0].extent;
     format = vulkan_images[0].format;
     aspect = static_cast<float>(extent.height) / extent.width;
 
-    mesh = Model{"kmscube.ply"}.to_mesh(
-        ModelAttribMap{}
-            .with_position(vk::Format::eR32G32B32Sfloat)
-            .with_color(vk::Format::eR32G32B32Sfloat)
-            .with_normal(vk::Format::eR32G32B32Sfloat));
+    mesh = load_mesh(options_["indexed"].value == "true");
 
     setup_vertex_buffer();
+    setup_index_buffer();
     setup_uniform_buffer();
     setup_uniform_descriptor_set();
     setup_render_pass();
     setup_pipeline();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
     setup_framebuffers(vulkan_images);
     setup_command_buffers();
 
@@ -90,12 +109,14 @@ void CubeScene::teardown()
     vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
     framebuffers.clear();
     image_views.clear();
+    color_target = {};
     pipeline = {};
     pipeline_layout = {};
     render_pass = {};
     descriptor_set = {};
     uniform_buffer_map = {};
     uniform_buffer = {};
+    index_buffer = {};
     vertex_buffer = {};
 
     Scene::teardown();
@@ -131,20 +152,12 @@ void CubeScene::update()
 
 void CubeScene::setup_vertex_buffer()
 {
-    vk::DeviceMemory vertex_buffer_memory;
-
-    vertex_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(vk::BufferUsageFlagBits::eVertexBuffer)
-        .set_memory_properties(
-            vk::MemoryPropertyFlagBits::eHostVisible |
-            vk::MemoryPropertyFlagBits::eHostCoherent)
-        .set_memory_out(vertex_buffer_memory)
-        .build();
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
 
-    auto const vertex_buffer_map = vkutil::map_memory(
-        *vulkan, vertex_buffer_memory, 0, mesh->vertex_data_size());
-    mesh->copy_vertex_data_to(vertex_buffer_map);
+void CubeScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(*vulkan, *mesh);
 }
 
 void CubeScene::setup_uniform_buffer()
@@ -177,6 +190,7 @@ void CubeScene::setup_render_pass()
 {
     render_pass = vkutil::RenderPassBuilder(*vulkan)
         .set_color_format(format)
+        .set_samples(samples)
         .set_color_load_op(vk::AttachmentLoadOp::eClear)
         .build();
 }
@@ -194,6 +208,7 @@ void CubeScene::setup_pipeline()
         .set_extent(extent)
         .set_layout(pipeline_layout)
         .set_render_pass(render_pass)
+        .set_samples(samples)
         .set_vertex_shader(Util::read_data_file("shaders/vkcube.vert.spv"))
         .set_fragment_shader(Util::read_data_file("shaders/vkcube.frag.spv"))
         .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
@@ -214,10 +229,14 @@ void CubeScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images
 
     for (auto const& image_view : image_views)
     {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, image_view};
+
         framebuffers.push_back(
             vkutil::FramebufferBuilder{*vulkan}
                 .set_render_pass(render_pass)
-                .set_image_views({image_view})
+                .set_image_views(attachments)
                 .set_extent(extent)
                 .build());
     }
@@ -261,7 +280,15 @@ void CubeScene::setup_command_buffers()
             binding_offsets
             );
 
-        command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+        if (mesh->num_indices() > 0)
+        {
+            command_buffers[i].bindIndexBuffer(index_buffer, 0, mesh->index_type());
+            command_buffers[i].drawIndexed(mesh->num_indices(), 1, 0, 0, 0);
+        }
+        else
+        {
+            command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+        }
 
         command_buffers[i].endRenderPass();
         command_buffers[i].end();
@@ -22,8 +22,9 @@
 
 #pragma once
 
-#include "scene.h"
+#include "multisample_scene.h"
 #include "managed_resource.h"
+#include "vkutil/msaa_color_target.h"
 
 #include <memory>
 
@@ -33,12 +34,13 @@
 
 class Mesh;
 
-class CubeScene : public Scene
+class CubeScene : public MultisampleScene
 {
 public:
     CubeScene();
     ~CubeScene();
 
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
     void setup(VulkanState&, std::vector<VulkanImage> const&) override;
     void teardown() override;
 
@@ -47,6 +49,7 @@ public:
 
 private:
     void setup_vertex_buffer();
+    void setup_index_buffer();
     void setup_uniform_buffer();
     void setup_uniform_descriptor_set();
     void setup_render_pass();
@@ -60,15 +63,17 @@ private:
     vk::Format format;
     float aspect;
 
-    std::unique_ptr<Mesh> mesh;
+    std::shared_ptr<Mesh const> mesh;
 
     ManagedResource<vk::Buffer> vertex_buffer;
+    ManagedResource<vk::Buffer> index_buffer;
     ManagedResource<vk::Buffer> uniform_buffer;
     ManagedResource<void*> uniform_buffer_map;
     ManagedResource<vk::DescriptorSet> descriptor_set;
     ManagedResource<vk::RenderPass> render_pass;
     ManagedResource<vk::PipelineLayout> pipeline_layout;
     ManagedResource<vk::Pipeline> pipeline;
+    vkutil::MsaaColorTarget color_target;
     std::vector<ManagedResource<vk::ImageView>> image_views;
     std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
     std::vector<vk::CommandBuffer> command_buffers;
@@ -0,0 +1,648 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "deferred_scene.h"
+
+#include "mesh.h"
+#include "procedural_mesh.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <sstream>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 modelview;
+    glm::mat4 normal;
+    glm::vec4 material_diffuse;
+};
+
+// Matches the std430 layout of the lights buffer in the lighting shaders
+struct Light
+{
+    // The w component of the position is the light radius
+    glm::vec4 position;
+    glm::vec4 color;
+};
+
+size_t const light_array_offset = 16;
+uint32_t const max_lights = 10000;
+float const light_radius = 0.35f;
+
+std::unique_ptr<Mesh> create_quad_mesh()
+{
+    auto mesh = std::make_unique<Mesh>(
+        std::vector<vk::Format>{vk::Format::eR32G32Sfloat, vk::Format::eR32G32Sfloat});
+
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,-1});
+    mesh->set_attribute(1, {0,0});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,1});
+    mesh->set_attribute(1, {0,1});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,1});
+    mesh->set_attribute(1, {1,1});
+
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,-1});
+    mesh->set_attribute(1, {0,0});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,1});
+    mesh->set_attribute(1, {1,1});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,-1});
+    mesh->set_attribute(1, {1,0});
+
+    mesh->set_interleave(true);
+
+    return mesh;
+}
+
+}
+
+DeferredScene::DeferredScene() : Scene{"deferred"}
+{
+    options_["lights"] =
+        SceneOption("lights", "64",
+                    "The number of point lights (1 to 10000)");
+    options_["passes"] =
+        SceneOption("passes", "subpasses",
+                    "Whether the G-buffer is read as input attachments by a second "
+                    "subpass, or as textures by a separate render pass",
+                    "subpasses,separate");
+}
+
+DeferredScene::~DeferredScene() = default;
+
+void DeferredScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    Util::read_data_file("shaders/deferred-gbuffer.vert.spv");
+    Util::read_data_file("shaders/deferred-gbuffer.frag.spv");
+    Util::read_data_file("shaders/effect2d.vert.spv");
+
+    if (options.at("passes").value == "subpasses")
+        Util::read_data_file("shaders/deferred-light-input.frag.spv");
+    else
+        Util::read_data_file("shaders/deferred-light-texture.frag.spv");
+}
+
+void DeferredScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    Scene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+    // Albedo, eye space normal and eye space position
+    gbuffer_formats = {
+        vk::Format::eR8G8B8A8Unorm,
+        vk::Format::eR16G16B16A16Sfloat,
+        vk::Format::eR16G16B16A16Sfloat};
+    use_subpasses = options_["passes"].value == "subpasses";
+    num_lights = Util::ranged_option_value<uint32_t>(
+        "lights", options_["lights"].value, 1, max_lights);
+
+    mesh = generate_procedural_mesh("heightfield", 100000);
+    mesh->set_interleave(true);
+    quad_mesh = create_quad_mesh();
+
+    // Model projection
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    auto const diameter = glm::length(max_bound - min_bound);
+    auto const aspect = static_cast<float>(extent.width)/static_cast<float>(extent.height);
+    auto const center = (max_bound + min_bound) / 2.0f;
+    auto const radius = diameter / 2.0f;
+    auto const fovy = 2.0f * atanf(radius / (2.0f + radius));
+    projection = glm::perspective(fovy, aspect, 2.0f, 2.0f + diameter);
+
+    modelview = glm::mat4{1.0};
+    modelview = glm::translate(modelview, glm::vec3{-center.x, -center.y, -(center.z + 2.0 + radius)});
+    // Tilt the mesh towards the viewer, so that the heightfield is visible
+    modelview = glm::rotate(modelview, glm::radians(-30.0f), {1.0f, 0.0f, 0.0f});
+
+    setup_lights();
+    setup_vertex_buffers();
+    setup_uniform_buffer();
+    setup_light_buffer();
+    setup_gbuffer_images();
+    setup_descriptor_sets();
+    setup_render_passes();
+    setup_pipelines();
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    light_time = 0.0f;
+}
+
+void DeferredScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
+    framebuffers.clear();
+    image_views.clear();
+    gbuffer_framebuffer = {};
+    light_pipeline = {};
+    gbuffer_pipeline = {};
+    light_pipeline_layout = {};
+    gbuffer_pipeline_layout = {};
+    light_render_pass = {};
+    gbuffer_render_pass = {};
+    light_descriptor_set = {};
+    gbuffer_descriptor_set = {};
+    sampler = {};
+    depth_image_view = {};
+    depth_image = {};
+    gbuffer_image_views.clear();
+    gbuffer_images.clear();
+    light_buffer_map = {};
+    light_buffer = {};
+    uniform_buffer_map = {};
+    uniform_buffer = {};
+    quad_vertex_buffer = {};
+    index_buffer = {};
+    vertex_buffer = {};
+    light_colors.clear();
+    light_origins.clear();
+    quad_mesh.reset();
+    mesh.reset();
+
+    Scene::teardown();
+}
+
+VulkanImage DeferredScene::draw(VulkanImage const& image)
+{
+    update_uniforms();
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&command_buffers[image.index])
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, {});
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void DeferredScene::update()
+{
+    light_time = (Util::get_timestamp_us() - start_time) / 1000000.0f;
+
+    Scene::update();
+}
+
+std::string DeferredScene::extra_results() const
+{
+    std::stringstream ss;
+    ss << "Lights: " << num_lights
+       << " Passes: " << (use_subpasses ? "subpasses" : "separate");
+    return ss.str();
+}
+
+void DeferredScene::setup_lights()
+{
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> position_dist{-1.0f, 1.0f};
+    std::uniform_real_distribution<float> phase_dist{0.0f, 2.0f * static_cast<float>(M_PI)};
+    std::uniform_real_distribution<float> color_dist{0.2f, 1.0f};
+
+    // The lights hover just above the heightfield, which spans [-1,1] in x
+    // and z, with up being -y
+    for (auto i = 0u; i < num_lights; ++i)
+    {
+        light_origins.push_back(
+            glm::vec4{position_dist(rng), -0.15f, position_dist(rng), phase_dist(rng)});
+        light_colors.push_back(
+            glm::vec4{color_dist(rng), color_dist(rng), color_dist(rng), 1.0f});
+    }
+}
+
+void DeferredScene::setup_vertex_buffers()
+{
+    vertex_buffer = vkutil::create_device_local_buffer(
+        *vulkan, mesh->vertex_data_size(), vk::BufferUsageFlagBits::eVertexBuffer,
+        [this] (void* dst) { mesh->copy_vertex_data_to(dst); });
+
+    index_buffer = vkutil::create_device_local_buffer(
+        *vulkan, mesh->index_data_size(), vk::BufferUsageFlagBits::eIndexBuffer,
+        [this] (void* dst) { mesh->copy_index_data_to(dst); });
+
+    quad_vertex_buffer = vkutil::create_device_local_buffer(
+        *vulkan, quad_mesh->vertex_data_size(), vk::BufferUsageFlagBits::eVertexBuffer,
+        [this] (void* dst) { quad_mesh->copy_vertex_data_to(dst); });
+}
+
+void DeferredScene::setup_uniform_buffer()
+{
+    uniform_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(sizeof(Uniforms))
+        .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(uniform_buffer_memory)
+        .build();
+
+    uniform_buffer_map = vkutil::map_memory(
+        *vulkan, uniform_buffer_memory, 0, sizeof(Uniforms));
+}
+
+void DeferredScene::setup_light_buffer()
+{
+    auto const size = light_array_offset + num_lights * sizeof(Light);
+
+    light_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(size)
+        .set_usage(vk::BufferUsageFlagBits::eStorageBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(light_buffer_memory)
+        .build();
+
+    light_buffer_map = vkutil::map_memory(*vulkan, light_buffer_memory, 0, size);
+
+    auto const light_count = static_cast<int32_t>(num_lights);
+    memcpy(light_buffer_map, &light_count, sizeof(light_count));
+}
+
+void DeferredScene::setup_gbuffer_images()
+{
+    // With subpasses the G-buffer and depth contents never leave the render
+    // pass, so they are transient attachments, which get lazily allocated
+    // memory where available and may then stay in tile memory on tiled GPUs
+    auto const gbuffer_usage = use_subpasses ?
+        vk::ImageUsageFlagBits::eColorAttachment |
+        vk::ImageUsageFlagBits::eInputAttachment |
+        vk::ImageUsageFlagBits::eTransientAttachment :
+        vk::ImageUsageFlagBits::eColorAttachment |
+        vk::ImageUsageFlagBits::eSampled;
+    auto const depth_usage = use_subpasses ?
+        vk::ImageUsageFlagBits::eDepthStencilAttachment |
+        vk::ImageUsageFlagBits::eTransientAttachment :
+        vk::ImageUsageFlags{vk::ImageUsageFlagBits::eDepthStencilAttachment};
+
+    for (auto const gbuffer_format : gbuffer_formats)
+    {
+        gbuffer_images.push_back(
+            vkutil::ImageBuilder{*vulkan}
+                .set_extent(extent)
+                .set_format(gbuffer_format)
+                .set_tiling(vk::ImageTiling::eOptimal)
+                .set_usage(gbuffer_usage)
+                .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+                .set_initial_layout(vk::ImageLayout::eUndefined)
+                .build());
+
+        gbuffer_image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(gbuffer_images.back())
+                .set_format(gbuffer_format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(depth_usage)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    if (use_subpasses)
+        return;
+
+    auto const sampler_create_info = vk::SamplerCreateInfo{}
+        .setMagFilter(vk::Filter::eNearest)
+        .setMinFilter(vk::Filter::eNearest)
+        .setAddressModeU(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeV(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeW(vk::SamplerAddressMode::eClampToEdge)
+        .setAnisotropyEnable(false)
+        .setUnnormalizedCoordinates(false)
+        .setCompareEnable(false)
+        .setMinLod(0.0f)
+        .setMaxLod(0.25f)
+        .setMipmapMode(vk::SamplerMipmapMode::eNearest);
+
+    sampler = ManagedResource<vk::Sampler>{
+        vulkan->device().createSampler(sampler_create_info),
+        [this] (auto const& s) { vulkan->device().destroySampler(s); }};
+}
+
+void DeferredScene::setup_descriptor_sets()
+{
+    gbuffer_descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eUniformBuffer)
+        .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+        .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+        .set_layout_out(gbuffer_descriptor_set_layout)
+        .build();
+
+    vkutil::DescriptorSetBuilder builder{*vulkan};
+
+    for (auto& image_view : gbuffer_image_views)
+    {
+        if (use_subpasses)
+        {
+            builder.set_type(vk::DescriptorType::eInputAttachment)
+                .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+                .set_image_view(image_view, vk::ImageLayout::eShaderReadOnlyOptimal);
+        }
+        else
+        {
+            builder.set_type(vk::DescriptorType::eCombinedImageSampler)
+                .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+                .set_image_view(image_view, sampler);
+        }
+
+        builder.next_binding();
+    }
+
+    light_descriptor_set = builder
+        .set_type(vk::DescriptorType::eStorageBuffer)
+        .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+        .set_buffer(light_buffer, 0, light_array_offset + num_lights * sizeof(Light))
+        .set_layout_out(light_descriptor_set_layout)
+        .build();
+}
+
+void DeferredScene::setup_render_passes()
+{
+    if (use_subpasses)
+    {
+        gbuffer_render_pass = vkutil::RenderPassBuilder(*vulkan)
+            .set_color_formats(gbuffer_formats)
+            .set_depth_format(depth_format)
+            .set_second_subpass_format(format)
+            .set_color_load_op(vk::AttachmentLoadOp::eClear)
+            .build();
+        return;
+    }
+
+    gbuffer_render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_formats(gbuffer_formats)
+        .set_depth_format(depth_format)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .set_color_final_layout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .build();
+
+    light_render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_color_load_op(vk::AttachmentLoadOp::eDontCare)
+        .build();
+}
+
+void DeferredScene::setup_pipelines()
+{
+    auto const gbuffer_pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&gbuffer_descriptor_set_layout);
+    gbuffer_pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(gbuffer_pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    auto const light_pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&light_descriptor_set_layout);
+    light_pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(light_pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    gbuffer_pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(gbuffer_pipeline_layout)
+        .set_render_pass(gbuffer_render_pass)
+        .set_color_attachment_count(gbuffer_formats.size())
+        .set_vertex_shader(Util::read_data_file("shaders/deferred-gbuffer.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/deferred-gbuffer.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .set_depth_test(true)
+        .build();
+
+    // All lights are accumulated by a single fullscreen pass
+    light_pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(light_pipeline_layout)
+        .set_render_pass(use_subpasses ? gbuffer_render_pass : light_render_pass)
+        .set_subpass(use_subpasses ? 1 : 0)
+        .set_vertex_shader(Util::read_data_file("shaders/effect2d.vert.spv"))
+        .set_fragment_shader(
+            Util::read_data_file(use_subpasses ?
+                                 "shaders/deferred-light-input.frag.spv" :
+                                 "shaders/deferred-light-texture.frag.spv"))
+        .set_vertex_input(quad_mesh->binding_descriptions(), quad_mesh->attribute_descriptions())
+        .build();
+}
+
+void DeferredScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    std::vector<vk::ImageView> gbuffer_attachments;
+    for (auto const& image_view : gbuffer_image_views)
+        gbuffer_attachments.push_back(image_view);
+    gbuffer_attachments.push_back(depth_image_view);
+
+    if (!use_subpasses)
+    {
+        gbuffer_framebuffer = vkutil::FramebufferBuilder{*vulkan}
+            .set_render_pass(gbuffer_render_pass)
+            .set_image_views(gbuffer_attachments)
+            .set_extent(extent)
+            .build();
+    }
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto attachments = std::vector<vk::ImageView>{image_view};
+        if (use_subpasses)
+        {
+            attachments = gbuffer_attachments;
+            attachments.push_back(image_view);
+        }
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(use_subpasses ? gbuffer_render_pass : light_render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void DeferredScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(framebuffers.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+    auto const quad_binding_offsets = quad_mesh->vertex_data_binding_offsets();
+
+    std::array<vk::ClearValue, 4> clear_values{{
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 0.0f}}},
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+        vk::ClearDepthStencilValue{1.0f, 0}}};
+
+    auto const gbuffer_barrier = vk::MemoryBarrier{}
+        .setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+
+    for (size_t i = 0; i < command_buffers.size(); ++i)
+    {
+        auto const begin_info = vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eSimultaneousUse);
+
+        command_buffers[i].begin(begin_info);
+
+        // The G-buffer is shared by all frames, and the lighting of the
+        // previous frame has to finish reading it before drawing to it
+        command_buffers[i].pipelineBarrier(
+            vk::PipelineStageFlagBits::eFragmentShader,
+            vk::PipelineStageFlagBits::eColorAttachmentOutput,
+            {}, {}, {}, {});
+
+        auto const gbuffer_render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(gbuffer_render_pass)
+            .setFramebuffer(use_subpasses ? framebuffers[i].raw : gbuffer_framebuffer.raw)
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(clear_values.size())
+            .setPClearValues(clear_values.data());
+
+        command_buffers[i].beginRenderPass(gbuffer_render_pass_begin_info, vk::SubpassContents::eInline);
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, gbuffer_pipeline);
+        command_buffers[i].bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, gbuffer_pipeline_layout, 0,
+            gbuffer_descriptor_set.raw, {});
+        command_buffers[i].bindVertexBuffers(
+            0,
+            std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+            binding_offsets);
+        command_buffers[i].bindIndexBuffer(index_buffer, 0, mesh->index_type());
+        command_buffers[i].drawIndexed(mesh->num_indices(), 1, 0, 0, 0);
+
+        if (use_subpasses)
+        {
+            command_buffers[i].nextSubpass(vk::SubpassContents::eInline);
+        }
+        else
+        {
+            command_buffers[i].endRenderPass();
+
+            command_buffers[i].pipelineBarrier(
+                vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                {}, gbuffer_barrier, {}, {});
+
+            auto const light_render_pass_begin_info = vk::RenderPassBeginInfo{}
+                .setRenderPass(light_render_pass)
+                .setFramebuffer(framebuffers[i])
+                .setRenderArea({{0,0}, extent});
+
+            command_buffers[i].beginRenderPass(light_render_pass_begin_info, vk::SubpassContents::eInline);
+        }
+
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, light_pipeline);
+        command_buffers[i].bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, light_pipeline_layout, 0,
+            light_descriptor_set.raw, {});
+        command_buffers[i].bindVertexBuffers(
+            0,
+            std::vector<vk::Buffer>{quad_binding_offsets.size(), quad_vertex_buffer.raw},
+            quad_binding_offsets);
+        command_buffers[i].draw(quad_mesh->num_vertices(), 1, 0, 0);
+        command_buffers[i].endRenderPass();
+
+        command_buffers[i].end();
+    }
+}
+
+void DeferredScene::update_uniforms()
+{
+    Uniforms ubo;
+
+    ubo.modelviewprojection = projection * modelview;
+    ubo.modelview = modelview;
+    ubo.normal = glm::inverseTranspose(modelview);
+    ubo.material_diffuse = glm::vec4{0.7f, 0.7f, 0.7f, 1.0};
+
+    memcpy(uniform_buffer_map, &ubo, sizeof(ubo));
+
+    // Each light circles around its origin, and the lighting shaders work
+    // in eye space
+    std::vector<Light> lights(num_lights);
+
+    for (auto i = 0u; i < num_lights; ++i)
+    {
+        auto const angle = light_time + light_origins[i].w;
+        auto const position = glm::vec3{light_origins[i]} +
+            0.2f * glm::vec3{cosf(angle), 0.0f, sinf(angle)};
+
+        lights[i].position = glm::vec4{glm::vec3{modelview * glm::vec4{position, 1.0f}},
+                                       light_radius};
+        lights[i].color = light_colors[i];
+    }
+
+    memcpy(static_cast<char*>(light_buffer_map.raw) + light_array_offset,
+           lights.data(), lights.size() * sizeof(Light));
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "scene.h"
+#include "managed_resource.h"
+
+#include <memory>
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+class DeferredScene : public Scene
+{
+public:
+    DeferredScene();
+    ~DeferredScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+    void update() override;
+
+    std::string extra_results() const override;
+
+private:
+    void setup_lights();
+    void setup_vertex_buffers();
+    void setup_uniform_buffer();
+    void setup_light_buffer();
+    void setup_gbuffer_images();
+    void setup_descriptor_sets();
+    void setup_render_passes();
+    void setup_pipelines();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_command_buffers();
+    void update_uniforms();
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+    vk::Format depth_format;
+    std::vector<vk::Format> gbuffer_formats;
+    bool use_subpasses;
+    uint32_t num_lights;
+    glm::mat4 projection;
+    glm::mat4 modelview;
+
+    std::unique_ptr<Mesh> mesh;
+    std::unique_ptr<Mesh> quad_mesh;
+    // The w component of the light origins is the phase of the light motion
+    std::vector<glm::vec4> light_origins;
+    std::vector<glm::vec4> light_colors;
+
+    ManagedResource<vk::Buffer> vertex_buffer;
+    ManagedResource<vk::Buffer> index_buffer;
+    ManagedResource<vk::Buffer> quad_vertex_buffer;
+    ManagedResource<vk::Buffer> uniform_buffer;
+    ManagedResource<void*> uniform_buffer_map;
+    ManagedResource<vk::Buffer> light_buffer;
+    ManagedResource<void*> light_buffer_map;
+    std::vector<ManagedResource<vk::Image>> gbuffer_images;
+    std::vector<ManagedResource<vk::ImageView>> gbuffer_image_views;
+    ManagedResource<vk::Image> depth_image;
+    ManagedResource<vk::ImageView> depth_image_view;
+    ManagedResource<vk::Sampler> sampler;
+    ManagedResource<vk::DescriptorSet> gbuffer_descriptor_set;
+    ManagedResource<vk::DescriptorSet> light_descriptor_set;
+    ManagedResource<vk::RenderPass> gbuffer_render_pass;
+    ManagedResource<vk::RenderPass> light_render_pass;
+    ManagedResource<vk::PipelineLayout> gbuffer_pipeline_layout;
+    ManagedResource<vk::PipelineLayout> light_pipeline_layout;
+    ManagedResource<vk::Pipeline> gbuffer_pipeline;
+    ManagedResource<vk::Pipeline> light_pipeline;
+    ManagedResource<vk::Framebuffer> gbuffer_framebuffer;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    std::vector<vk::CommandBuffer> command_buffers;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+
+    vk::DeviceMemory uniform_buffer_memory;
+    vk::DeviceMemory light_buffer_memory;
+    vk::DescriptorSetLayout gbuffer_descriptor_set_layout;
+    vk::DescriptorSetLayout light_descriptor_set_layout;
+
+    float light_time;
+};
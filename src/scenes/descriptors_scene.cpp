@@ -0,0 +1,643 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "descriptors_scene.h"
+
+#include "mesh.h"
+#include "model.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 normal;
+    glm::vec4 material_diffuse;
+};
+
+// The descriptors of an object, as laid out for the descriptor update template
+struct DescriptorData
+{
+    VkDescriptorBufferInfo buffer_info;
+    VkDescriptorImageInfo image_info;
+};
+
+size_t const max_objects = 10000;
+// The uniform buffer and the texture
+uint32_t const descriptors_per_object = 2;
+
+std::shared_ptr<Mesh const> load_mesh()
+{
+    return Model::load_mesh(
+        "cube.3ds",
+        ModelAttribMap{}
+            .with_position(vk::Format::eR32G32B32Sfloat)
+            .with_normal(vk::Format::eR32G32B32Sfloat)
+            .with_texcoord(vk::Format::eR32G32Sfloat)
+            .with_interleave(true),
+        true);
+}
+
+ManagedResource<vk::DescriptorPool> create_descriptor_pool(VulkanState& vulkan, size_t num_sets)
+{
+    std::array<vk::DescriptorPoolSize, 2> const pool_sizes{{
+        vk::DescriptorPoolSize{}
+            .setType(vk::DescriptorType::eUniformBuffer)
+            .setDescriptorCount(num_sets),
+        vk::DescriptorPoolSize{}
+            .setType(vk::DescriptorType::eCombinedImageSampler)
+            .setDescriptorCount(num_sets)}};
+
+    auto const descriptor_pool_create_info = vk::DescriptorPoolCreateInfo{}
+        .setPoolSizeCount(pool_sizes.size())
+        .setPPoolSizes(pool_sizes.data())
+        .setMaxSets(num_sets);
+
+    return ManagedResource<vk::DescriptorPool>{
+        vulkan.device().createDescriptorPool(descriptor_pool_create_info),
+        [vptr=&vulkan] (auto const& dp) { vptr->device().destroyDescriptorPool(dp); }};
+}
+
+}
+
+DescriptorsScene::DescriptorsScene() : MultisampleScene{"descriptors"}
+{
+    options_["objects"] =
+        SceneOption("objects", "1000",
+                    "The number of objects drawn, each with its own descriptor set (1 to 10000)");
+    options_["update"] =
+        SceneOption("update", "pool-reset",
+                    "How the descriptors of the objects are provided every frame",
+                    "pool-reset,template,push");
+}
+
+DescriptorsScene::~DescriptorsScene() = default;
+
+void DescriptorsScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    load_mesh();
+    Util::read_data_file("shaders/light-basic-tex.vert.spv");
+    Util::read_data_file("shaders/light-basic-tex.frag.spv");
+    Util::read_image_file("textures/crate-base.jpg");
+}
+
+void DescriptorsScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    MultisampleScene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+
+    num_objects = Util::ranged_option_value<size_t>(
+        "objects", options_["objects"].value, 1, max_objects);
+    update_mode = options_["update"].value;
+
+    if (update_mode == "template" &&
+        !vulkan->has_device_extension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+    {
+        throw std::runtime_error(
+            "\"update\" option value template requires the "
+            VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME " device extension");
+    }
+
+    if (update_mode == "push" &&
+        !vulkan->has_device_extension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+    {
+        throw std::runtime_error(
+            "\"update\" option value push requires the "
+            VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME " device extension");
+    }
+
+    update_descriptor_set_with_template =
+        reinterpret_cast<PFN_vkUpdateDescriptorSetWithTemplateKHR>(
+            vulkan->device().getProcAddr("vkUpdateDescriptorSetWithTemplateKHR"));
+    cmd_push_descriptor_set =
+        reinterpret_cast<PFN_vkCmdPushDescriptorSetKHR>(
+            vulkan->device().getProcAddr("vkCmdPushDescriptorSetKHR"));
+
+    mesh = load_mesh();
+    setup_vertex_buffer();
+    setup_index_buffer();
+    setup_uniform_buffer();
+    setup_texture();
+    setup_descriptor_set_layout();
+    setup_descriptor_update_template();
+    setup_render_pass();
+    setup_pipeline();
+    setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
+    setup_framebuffers(vulkan_images);
+    setup_frames();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+}
+
+void DescriptorsScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    for (auto const& frame : frames)
+    {
+        if (frame.fence)
+            vulkan->device().destroyFence(frame.fence);
+    }
+    frames.clear();
+    framebuffers.clear();
+    image_views.clear();
+    color_target = {};
+    depth_image_view = {};
+    depth_image = {};
+    pipeline = {};
+    pipeline_layout = {};
+    render_pass = {};
+    descriptor_update_template = {};
+    descriptor_set_layout = {};
+    texture = {};
+    uniform_buffer_map = {};
+    uniform_buffer = {};
+    index_buffer = {};
+    vertex_buffer = {};
+    mesh.reset();
+
+    Scene::teardown();
+}
+
+VulkanImage DescriptorsScene::draw(VulkanImage const& image)
+{
+    auto& frame = frames[image.index];
+
+    if (!frame.fence)
+    {
+        frame.fence = vulkan->device().createFence(vk::FenceCreateInfo());
+    }
+    else
+    {
+        vulkan->device().waitForFences(frame.fence, true, INT64_MAX);
+        vulkan->device().resetFences(frame.fence);
+    }
+
+    update_descriptor_sets(image.index);
+    record_command_buffer(image.index);
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&frame.command_buffer)
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, frame.fence);
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+std::string DescriptorsScene::extra_results() const
+{
+    std::stringstream ss;
+    ss << "Objects: " << num_objects << " Update: " << update_mode
+       << " Descriptor updates: " << std::fixed << std::setprecision(2)
+       << descriptors_per_object * num_objects * average_fps() / 1000000.0 << " M/s";
+    return ss.str();
+}
+
+void DescriptorsScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
+
+void DescriptorsScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(*vulkan, *mesh);
+}
+
+void DescriptorsScene::setup_uniform_buffer()
+{
+    auto const alignment =
+        vulkan->physical_device().getProperties().limits.minUniformBufferOffsetAlignment;
+    uniforms_stride = (sizeof(Uniforms) + alignment - 1) / alignment * alignment;
+
+    auto const size = uniforms_stride * num_objects;
+    vk::DeviceMemory uniform_buffer_memory;
+
+    uniform_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(size)
+        .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(uniform_buffer_memory)
+        .build();
+
+    uniform_buffer_map = vkutil::map_memory(*vulkan, uniform_buffer_memory, 0, size);
+
+    // The objects don't move, since only the cost of providing their
+    // descriptors is of interest. Place them in the cells of a square grid
+    // of unit cells, scaling the mesh to fit comfortably in a cell.
+    auto const grid = static_cast<size_t>(std::ceil(std::sqrt(num_objects)));
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    auto const scale = 0.6f / glm::length(max_bound - min_bound);
+    auto const center = (max_bound + min_bound) / 2.0f;
+    auto const grid_center = (grid - 1) / 2.0f;
+
+    auto const radius = grid / 2.0f + 1.0f;
+    auto const aspect = static_cast<float>(extent.width) / extent.height;
+    auto const projection = glm::ortho(-radius * aspect, radius * aspect, -radius, radius,
+                                       -radius, radius);
+
+    auto const uniforms = static_cast<char*>(uniform_buffer_map.raw);
+
+    for (size_t i = 0; i < num_objects; ++i)
+    {
+        glm::vec3 const cell(i % grid, i / grid, 0.0f);
+
+        glm::mat4 modelview{1.0};
+        modelview = glm::translate(modelview, cell - glm::vec3{grid_center, grid_center, 0.0f});
+        modelview = glm::rotate(modelview, glm::radians(30.0f + i % 12 * 30.0f),
+                                {1.0f, 1.0f, 0.0f});
+        modelview = glm::scale(modelview, glm::vec3{scale});
+        modelview = glm::translate(modelview, -center);
+
+        Uniforms ubo;
+
+        ubo.modelviewprojection = projection * modelview;
+        ubo.normal = glm::inverseTranspose(modelview);
+        ubo.material_diffuse = {1.0f, 1.0f, 1.0f, 1.0f};
+
+        memcpy(uniforms + i * uniforms_stride, &ubo, sizeof(ubo));
+    }
+}
+
+void DescriptorsScene::setup_texture()
+{
+    texture = vkutil::TextureBuilder{*vulkan}
+        .set_file("textures/crate-base.jpg")
+        .set_filter(vk::Filter::eLinear)
+        .build();
+}
+
+void DescriptorsScene::setup_descriptor_set_layout()
+{
+    std::array<vk::DescriptorSetLayoutBinding, 2> const bindings{{
+        vk::DescriptorSetLayoutBinding{}
+            .setBinding(0)
+            .setDescriptorType(vk::DescriptorType::eUniformBuffer)
+            .setDescriptorCount(1)
+            .setStageFlags(vk::ShaderStageFlagBits::eVertex),
+        vk::DescriptorSetLayoutBinding{}
+            .setBinding(1)
+            .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
+            .setDescriptorCount(1)
+            .setStageFlags(vk::ShaderStageFlagBits::eFragment)}};
+
+    auto const descriptor_set_layout_create_info = vk::DescriptorSetLayoutCreateInfo{}
+        .setFlags(update_mode == "push" ?
+                  vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR :
+                  vk::DescriptorSetLayoutCreateFlags{})
+        .setBindingCount(bindings.size())
+        .setPBindings(bindings.data());
+
+    descriptor_set_layout = ManagedResource<vk::DescriptorSetLayout>{
+        vulkan->device().createDescriptorSetLayout(descriptor_set_layout_create_info),
+        [this] (auto const& dsl) { vulkan->device().destroyDescriptorSetLayout(dsl); }};
+}
+
+void DescriptorsScene::setup_descriptor_update_template()
+{
+    if (update_mode != "template")
+        return;
+
+    auto const create_template =
+        reinterpret_cast<PFN_vkCreateDescriptorUpdateTemplateKHR>(
+            vulkan->device().getProcAddr("vkCreateDescriptorUpdateTemplateKHR"));
+    auto const destroy_template =
+        reinterpret_cast<PFN_vkDestroyDescriptorUpdateTemplateKHR>(
+            vulkan->device().getProcAddr("vkDestroyDescriptorUpdateTemplateKHR"));
+
+    std::array<VkDescriptorUpdateTemplateEntryKHR, 2> const entries{{
+        {0, 0, 1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+         offsetof(DescriptorData, buffer_info), sizeof(DescriptorData)},
+        {1, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+         offsetof(DescriptorData, image_info), sizeof(DescriptorData)}}};
+
+    VkDescriptorUpdateTemplateCreateInfoKHR create_info{};
+    create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+    create_info.descriptorUpdateEntryCount = entries.size();
+    create_info.pDescriptorUpdateEntries = entries.data();
+    create_info.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+    create_info.descriptorSetLayout =
+        static_cast<VkDescriptorSetLayout>(descriptor_set_layout.raw);
+
+    VkDescriptorUpdateTemplateKHR update_template;
+    auto const device = static_cast<VkDevice>(vulkan->device());
+
+    if (create_template(device, &create_info, nullptr, &update_template) != VK_SUCCESS)
+        throw std::runtime_error{"Failed to create descriptor update template"};
+
+    descriptor_update_template = ManagedResource<VkDescriptorUpdateTemplateKHR>{
+        std::move(update_template),
+        [device,destroy_template] (auto const& t) { destroy_template(device, t, nullptr); }};
+}
+
+void DescriptorsScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_depth_format(depth_format)
+        .set_samples(samples)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void DescriptorsScene::setup_pipeline()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout.raw);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_samples(samples)
+        .set_vertex_shader(Util::read_data_file("shaders/light-basic-tex.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/light-basic-tex.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .set_depth_test(true)
+        .build();
+}
+
+void DescriptorsScene::setup_depth_image()
+{
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        depth_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::ImageAspectFlagBits::eDepth);
+}
+
+void DescriptorsScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void DescriptorsScene::setup_frames()
+{
+    frames.resize(framebuffers.size());
+
+    for (auto& frame : frames)
+    {
+        frame.command_pool = vkutil::create_command_pool(*vulkan);
+
+        auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+            .setCommandPool(frame.command_pool)
+            .setCommandBufferCount(1)
+            .setLevel(vk::CommandBufferLevel::ePrimary);
+
+        frame.command_buffer =
+            vulkan->device().allocateCommandBuffers(command_buffer_allocate_info)[0];
+
+        // Push descriptors don't need descriptor sets
+        if (update_mode != "push")
+            frame.descriptor_pool = create_descriptor_pool(*vulkan, num_objects);
+    }
+}
+
+void DescriptorsScene::update_descriptor_sets(size_t image_index)
+{
+    if (update_mode == "push")
+        return;
+
+    auto& frame = frames[image_index];
+
+    // Free all the descriptor sets of the previous use of the frame at once,
+    // and allocate new ones
+    vulkan->device().resetDescriptorPool(frame.descriptor_pool);
+
+    std::vector<vk::DescriptorSetLayout> const layouts(num_objects, descriptor_set_layout.raw);
+    auto const descriptor_set_allocate_info = vk::DescriptorSetAllocateInfo{}
+        .setDescriptorPool(frame.descriptor_pool)
+        .setDescriptorSetCount(layouts.size())
+        .setPSetLayouts(layouts.data());
+
+    frame.descriptor_sets = vulkan->device().allocateDescriptorSets(descriptor_set_allocate_info);
+
+    if (update_mode == "template")
+    {
+        auto const device = static_cast<VkDevice>(vulkan->device());
+        DescriptorData data;
+
+        data.image_info.sampler = static_cast<VkSampler>(texture.sampler.raw);
+        data.image_info.imageView = static_cast<VkImageView>(texture.image_view.raw);
+        data.image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        data.buffer_info.buffer = static_cast<VkBuffer>(uniform_buffer.raw);
+        data.buffer_info.range = sizeof(Uniforms);
+
+        for (size_t i = 0; i < num_objects; ++i)
+        {
+            data.buffer_info.offset = i * uniforms_stride;
+            update_descriptor_set_with_template(
+                device, static_cast<VkDescriptorSet>(frame.descriptor_sets[i]),
+                descriptor_update_template.raw, &data);
+        }
+    }
+    else
+    {
+        auto const image_info = vk::DescriptorImageInfo{}
+            .setSampler(texture.sampler)
+            .setImageView(texture.image_view)
+            .setImageLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
+
+        std::vector<vk::DescriptorBufferInfo> buffer_infos(num_objects);
+        std::vector<vk::WriteDescriptorSet> writes;
+        writes.reserve(descriptors_per_object * num_objects);
+
+        for (size_t i = 0; i < num_objects; ++i)
+        {
+            buffer_infos[i]
+                .setBuffer(uniform_buffer)
+                .setOffset(i * uniforms_stride)
+                .setRange(sizeof(Uniforms));
+
+            writes.push_back(
+                vk::WriteDescriptorSet{}
+                    .setDstSet(frame.descriptor_sets[i])
+                    .setDstBinding(0)
+                    .setDescriptorCount(1)
+                    .setDescriptorType(vk::DescriptorType::eUniformBuffer)
+                    .setPBufferInfo(&buffer_infos[i]));
+            writes.push_back(
+                vk::WriteDescriptorSet{}
+                    .setDstSet(frame.descriptor_sets[i])
+                    .setDstBinding(1)
+                    .setDescriptorCount(1)
+                    .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
+                    .setPImageInfo(&image_info));
+        }
+
+        vulkan->device().updateDescriptorSets(writes, {});
+    }
+}
+
+void DescriptorsScene::record_command_buffer(size_t image_index)
+{
+    auto& frame = frames[image_index];
+    auto const command_buffer = frame.command_buffer;
+
+    vulkan->device().resetCommandPool(frame.command_pool, {});
+
+    auto const begin_info = vk::CommandBufferBeginInfo{}
+        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+    command_buffer.begin(begin_info);
+
+    std::array<vk::ClearValue, 2> clear_values{{
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+        vk::ClearDepthStencilValue{1.0f, 0}}};
+
+    auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+        .setRenderPass(render_pass)
+        .setFramebuffer(framebuffers[image_index])
+        .setRenderArea({{0,0}, extent})
+        .setClearValueCount(clear_values.size())
+        .setPClearValues(clear_values.data());
+
+    command_buffer.beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+    command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+    command_buffer.bindVertexBuffers(
+        0,
+        std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+        binding_offsets);
+    command_buffer.bindIndexBuffer(index_buffer, 0, mesh->index_type());
+
+    auto const num_indices = static_cast<uint32_t>(mesh->num_indices());
+
+    // The descriptors pushed for each draw, of which only the uniform buffer
+    // offset changes
+    auto const image_info = vk::DescriptorImageInfo{}
+        .setSampler(texture.sampler)
+        .setImageView(texture.image_view)
+        .setImageLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
+    auto buffer_info = vk::DescriptorBufferInfo{}
+        .setBuffer(uniform_buffer)
+        .setRange(sizeof(Uniforms));
+    std::array<vk::WriteDescriptorSet, descriptors_per_object> const writes{{
+        vk::WriteDescriptorSet{}
+            .setDstBinding(0)
+            .setDescriptorCount(1)
+            .setDescriptorType(vk::DescriptorType::eUniformBuffer)
+            .setPBufferInfo(&buffer_info),
+        vk::WriteDescriptorSet{}
+            .setDstBinding(1)
+            .setDescriptorCount(1)
+            .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
+            .setPImageInfo(&image_info)}};
+
+    for (size_t i = 0; i < num_objects; ++i)
+    {
+        if (update_mode == "push")
+        {
+            buffer_info.setOffset(i * uniforms_stride);
+            cmd_push_descriptor_set(
+                static_cast<VkCommandBuffer>(command_buffer),
+                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                static_cast<VkPipelineLayout>(pipeline_layout.raw),
+                0, writes.size(),
+                reinterpret_cast<VkWriteDescriptorSet const*>(writes.data()));
+        }
+        else
+        {
+            command_buffer.bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
+                frame.descriptor_sets[i], {});
+        }
+
+        command_buffer.drawIndexed(num_indices, 1, 0, 0, 0);
+    }
+
+    command_buffer.endRenderPass();
+    command_buffer.end();
+}
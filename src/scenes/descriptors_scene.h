@@ -0,0 +1,108 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "multisample_scene.h"
+#include "managed_resource.h"
+#include "vkutil/msaa_color_target.h"
+#include "vkutil/texture.h"
+
+#include <memory>
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+// Measures the CPU cost of descriptor management, by providing fresh
+// descriptors for every object every frame
+class DescriptorsScene : public MultisampleScene
+{
+public:
+    DescriptorsScene();
+    ~DescriptorsScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+
+    std::string extra_results() const override;
+
+private:
+    // The command buffer and descriptor sets used for a swapchain image,
+    // re-created every frame
+    struct Frame
+    {
+        ManagedResource<vk::CommandPool> command_pool;
+        vk::CommandBuffer command_buffer;
+        ManagedResource<vk::DescriptorPool> descriptor_pool;
+        std::vector<vk::DescriptorSet> descriptor_sets;
+        vk::Fence fence;
+    };
+
+    void setup_vertex_buffer();
+    void setup_index_buffer();
+    void setup_uniform_buffer();
+    void setup_texture();
+    void setup_descriptor_set_layout();
+    void setup_descriptor_update_template();
+    void setup_render_pass();
+    void setup_pipeline();
+    void setup_depth_image();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_frames();
+    void update_descriptor_sets(size_t image_index);
+    void record_command_buffer(size_t image_index);
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+    vk::Format depth_format;
+    size_t num_objects;
+    std::string update_mode;
+    vk::DeviceSize uniforms_stride;
+
+    std::shared_ptr<Mesh const> mesh;
+
+    ManagedResource<vk::Buffer> vertex_buffer;
+    ManagedResource<vk::Buffer> index_buffer;
+    ManagedResource<vk::Buffer> uniform_buffer;
+    ManagedResource<void*> uniform_buffer_map;
+    vkutil::Texture texture;
+    ManagedResource<vk::DescriptorSetLayout> descriptor_set_layout;
+    ManagedResource<VkDescriptorUpdateTemplateKHR> descriptor_update_template;
+    ManagedResource<vk::RenderPass> render_pass;
+    ManagedResource<vk::PipelineLayout> pipeline_layout;
+    ManagedResource<vk::Pipeline> pipeline;
+    vkutil::MsaaColorTarget color_target;
+    ManagedResource<vk::Image> depth_image;
+    ManagedResource<vk::ImageView> depth_image_view;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    std::vector<Frame> frames;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+
+    // Extension entry points, which are not exported by the loader
+    PFN_vkUpdateDescriptorSetWithTemplateKHR update_descriptor_set_with_template;
+    PFN_vkCmdPushDescriptorSetKHR cmd_push_descriptor_set;
+};
@@ -172,6 +172,15 @@ DesktopScene::DesktopScene() : Scene{"desktop"}
 
 DesktopScene::~DesktopScene() = default;
 
+void DesktopScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    Util::read_image_file(
+        "textures/desktop-background-" + options.at("background-resolution").value + ".png");
+    Util::read_image_file("textures/desktop-window.png");
+    Util::read_data_file("shaders/desktop.vert.spv");
+    Util::read_data_file("shaders/desktop.frag.spv");
+}
+
 void DesktopScene::setup(
     VulkanState& vulkan_,
     std::vector<VulkanImage> const& vulkan_images)
@@ -268,35 +277,7 @@ void DesktopScene::update()
 
 void DesktopScene::setup_vertex_buffer()
 {
-    vk::DeviceMemory staging_buffer_memory;
-    vk::BufferUsageFlags staging_usage_flags =
-        vk::BufferUsageFlagBits::eVertexBuffer |
-        vk::BufferUsageFlagBits::eTransferSrc;
-
-    auto staging_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(staging_usage_flags)
-        .set_memory_properties(
-            vk::MemoryPropertyFlagBits::eHostVisible |
-            vk::MemoryPropertyFlagBits::eHostCoherent)
-        .set_memory_out(staging_buffer_memory)
-        .build();
-
-    {
-        auto const staging_buffer_map = vkutil::map_memory(
-            *vulkan, staging_buffer_memory, 0, mesh->vertex_data_size());
-        mesh->copy_vertex_data_to(staging_buffer_map);
-    }
-
-    vertex_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(
-            vk::BufferUsageFlagBits::eVertexBuffer |
-            vk::BufferUsageFlagBits::eTransferDst)
-        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
-        .build();
-
-    vkutil::copy_buffer(*vulkan, staging_buffer, vertex_buffer, mesh->vertex_data_size());
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
 }
 
 void DesktopScene::setup_render_pass()
@@ -39,6 +39,7 @@ public:
     DesktopScene();
     ~DesktopScene();
 
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
     void setup(VulkanState&, std::vector<VulkanImage> const&) override;
     void teardown() override;
 
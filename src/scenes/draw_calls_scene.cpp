@@ -0,0 +1,631 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "draw_calls_scene.h"
+
+#include "mesh.h"
+#include "model.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 normal;
+    glm::vec4 material_diffuse;
+};
+
+size_t const max_draws = 1000000;
+size_t const max_threads = 64;
+
+std::shared_ptr<Mesh const> load_mesh()
+{
+    return Model::load_mesh(
+        "cube.3ds",
+        ModelAttribMap{}
+            .with_position(vk::Format::eR32G32B32Sfloat)
+            .with_normal(vk::Format::eR32G32B32Sfloat)
+            .with_interleave(true),
+        true);
+}
+
+vk::CommandBuffer allocate_command_buffer(
+    VulkanState& vulkan, vk::CommandPool const& command_pool, vk::CommandBufferLevel level)
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(command_pool)
+        .setCommandBufferCount(1)
+        .setLevel(level);
+
+    return vulkan.device().allocateCommandBuffers(command_buffer_allocate_info)[0];
+}
+
+}
+
+DrawCallsScene::DrawCallsScene() : MultisampleScene{"draw-calls"}
+{
+    options_["draws"] =
+        SceneOption("draws", "10000", "The number of draw calls per frame (1 to 1000000)");
+
+    options_["threads"] =
+        SceneOption("threads", "1",
+                    "The number of threads recording the draw calls in secondary command "
+                    "buffers every frame (1 to 64)");
+
+    options_["state-changes"] =
+        SceneOption("state-changes", "none",
+                    "The state to change between draw calls",
+                    "none,pipeline,descriptor-set,vertex-buffer,all");
+}
+
+DrawCallsScene::~DrawCallsScene() = default;
+
+void DrawCallsScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    load_mesh();
+    Util::read_data_file("shaders/instancing-attribute.vert.spv");
+    Util::read_data_file("shaders/light-basic.frag.spv");
+}
+
+void DrawCallsScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    MultisampleScene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+
+    num_draws = Util::ranged_option_value<size_t>(
+        "draws", options_["draws"].value, 1, max_draws);
+    num_workers = Util::ranged_option_value<size_t>(
+        "threads", options_["threads"].value, 1, max_threads);
+
+    auto const state_changes = options_["state-changes"].value;
+    change_pipeline = state_changes == "pipeline" || state_changes == "all";
+    change_descriptor_set = state_changes == "descriptor-set" || state_changes == "all";
+    change_vertex_buffer = state_changes == "vertex-buffer" || state_changes == "all";
+
+    mesh = load_mesh();
+    setup_draws();
+    setup_vertex_buffers();
+    setup_index_buffer();
+    setup_instance_buffer();
+    setup_uniform_buffers();
+    setup_descriptor_sets();
+    setup_render_pass();
+    setup_pipelines();
+    setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
+    setup_framebuffers(vulkan_images);
+    setup_frames();
+    start_workers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    rotation = 0.0;
+}
+
+void DrawCallsScene::teardown()
+{
+    stop_workers();
+
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    for (auto const& frame : frames)
+    {
+        if (frame.fence)
+            vulkan->device().destroyFence(frame.fence);
+    }
+    frames.clear();
+    framebuffers.clear();
+    image_views.clear();
+    color_target = {};
+    depth_image_view = {};
+    depth_image = {};
+    pipelines.clear();
+    pipeline_layout = {};
+    render_pass = {};
+    descriptor_sets.clear();
+    uniform_buffer_maps.clear();
+    uniform_buffers.clear();
+    instance_buffer = {};
+    index_buffer = {};
+    vertex_buffers.clear();
+    objects.clear();
+    mesh.reset();
+
+    Scene::teardown();
+}
+
+VulkanImage DrawCallsScene::draw(VulkanImage const& image)
+{
+    update_uniforms();
+    record_command_buffer(image.index);
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&frames[image.index].command_buffer)
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, frames[image.index].fence);
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void DrawCallsScene::update()
+{
+    auto const t = (Util::get_timestamp_us() - start_time) / 1000000.0f;
+
+    rotation = 36.0f * t;
+
+    Scene::update();
+}
+
+std::string DrawCallsScene::extra_results() const
+{
+    std::stringstream ss;
+    ss << "Draws: " << num_draws << " Threads: " << num_workers
+       << " Throughput: " << std::fixed << std::setprecision(2)
+       << num_draws * average_fps() / 1000000.0 << " Mdraws/s";
+    return ss.str();
+}
+
+void DrawCallsScene::setup_draws()
+{
+    // Place the objects in the cells of a square grid of unit cells,
+    // scaling the mesh to fit comfortably in a cell
+    auto const grid = static_cast<size_t>(std::ceil(std::sqrt(num_draws)));
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    auto const scale = 0.8f / glm::length(max_bound - min_bound);
+    auto const center = (max_bound + min_bound) / 2.0f * scale;
+    auto const grid_center = (grid - 1) / 2.0f;
+
+    objects.reserve(num_draws);
+
+    for (size_t i = 0; i < num_draws; ++i)
+    {
+        glm::vec3 const cell(i % grid, i / grid, 0.0f);
+        objects.emplace_back(cell - glm::vec3{grid_center, grid_center, 0.0f} - center, scale);
+    }
+
+    // Keep the whole grid in view while it rotates
+    auto const radius = grid * std::sqrt(2.0f) / 2.0f + 1.0f;
+    auto const aspect = static_cast<float>(extent.width) / extent.height;
+    projection = glm::ortho(-radius * aspect, radius * aspect, -radius, radius,
+                            -radius, radius);
+}
+
+void DrawCallsScene::setup_vertex_buffers()
+{
+    for (size_t i = 0; i < 2; ++i)
+    {
+        vertex_buffers.push_back(
+            vkutil::create_device_local_buffer(
+                *vulkan, mesh->vertex_data_size(), vk::BufferUsageFlagBits::eVertexBuffer,
+                [this] (void* dst) { mesh->copy_vertex_data_to(dst); }));
+    }
+}
+
+void DrawCallsScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_device_local_buffer(
+        *vulkan, mesh->index_data_size(), vk::BufferUsageFlagBits::eIndexBuffer,
+        [this] (void* dst) { mesh->copy_index_data_to(dst); });
+}
+
+void DrawCallsScene::setup_instance_buffer()
+{
+    // Each draw call selects its object through firstInstance
+    auto const size = objects.size() * sizeof(objects[0]);
+
+    instance_buffer = vkutil::create_device_local_buffer(
+        *vulkan, size, vk::BufferUsageFlagBits::eVertexBuffer,
+        [this,size] (void* dst) { memcpy(dst, objects.data(), size); });
+}
+
+void DrawCallsScene::setup_uniform_buffers()
+{
+    for (size_t i = 0; i < 2; ++i)
+    {
+        vk::DeviceMemory uniform_buffer_memory;
+
+        uniform_buffers.push_back(
+            vkutil::BufferBuilder{*vulkan}
+                .set_size(sizeof(Uniforms))
+                .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+                .set_memory_properties(
+                    vk::MemoryPropertyFlagBits::eHostVisible |
+                    vk::MemoryPropertyFlagBits::eHostCoherent)
+                .set_memory_out(uniform_buffer_memory)
+                .build());
+
+        uniform_buffer_maps.push_back(
+            vkutil::map_memory(*vulkan, uniform_buffer_memory, 0, sizeof(Uniforms)));
+    }
+}
+
+void DrawCallsScene::setup_descriptor_sets()
+{
+    // The descriptor set layouts are identical, so the descriptor sets can be
+    // used with either pipeline
+    for (auto& uniform_buffer : uniform_buffers)
+    {
+        descriptor_sets.push_back(
+            vkutil::DescriptorSetBuilder{*vulkan}
+                .set_type(vk::DescriptorType::eUniformBuffer)
+                .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+                .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+                .set_layout_out(descriptor_set_layout)
+                .build());
+    }
+}
+
+void DrawCallsScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_depth_format(depth_format)
+        .set_samples(samples)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void DrawCallsScene::setup_pipelines()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    auto binding_descriptions = mesh->binding_descriptions();
+    auto attribute_descriptions = mesh->attribute_descriptions();
+    uint32_t const instance_binding = binding_descriptions.size();
+
+    binding_descriptions.push_back(
+        vk::VertexInputBindingDescription{}
+            .setBinding(instance_binding)
+            .setStride(sizeof(objects[0]))
+            .setInputRate(vk::VertexInputRate::eInstance));
+    attribute_descriptions.push_back(
+        vk::VertexInputAttributeDescription{}
+            .setBinding(instance_binding)
+            .setLocation(attribute_descriptions.size())
+            .setFormat(vk::Format::eR32G32B32A32Sfloat)
+            .setOffset(0));
+
+    // Two identical pipelines, which are still distinct objects for the driver
+    for (size_t i = 0; i < 2; ++i)
+    {
+        pipelines.push_back(
+            vkutil::PipelineBuilder(*vulkan)
+                .set_extent(extent)
+                .set_layout(pipeline_layout)
+                .set_render_pass(render_pass)
+                .set_samples(samples)
+                .set_vertex_shader(Util::read_data_file("shaders/instancing-attribute.vert.spv"))
+                .set_fragment_shader(Util::read_data_file("shaders/light-basic.frag.spv"))
+                .set_vertex_input(binding_descriptions, attribute_descriptions)
+                .set_depth_test(true)
+                .build());
+    }
+}
+
+void DrawCallsScene::setup_depth_image()
+{
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        depth_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::ImageAspectFlagBits::eDepth);
+}
+
+void DrawCallsScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void DrawCallsScene::setup_frames()
+{
+    frames.resize(framebuffers.size());
+
+    for (auto& frame : frames)
+    {
+        frame.command_pool = vkutil::create_command_pool(*vulkan);
+        frame.command_buffer = allocate_command_buffer(
+            *vulkan, frame.command_pool, vk::CommandBufferLevel::ePrimary);
+
+        for (size_t i = 0; i < num_workers; ++i)
+        {
+            frame.worker_command_pools.push_back(vkutil::create_command_pool(*vulkan));
+            frame.worker_command_buffers.push_back(
+                allocate_command_buffer(
+                    *vulkan, frame.worker_command_pools.back(),
+                    vk::CommandBufferLevel::eSecondary));
+        }
+    }
+}
+
+void DrawCallsScene::start_workers()
+{
+    work_generation = 0;
+    work_pending = 0;
+    work_stop = false;
+    work_error = nullptr;
+
+    for (size_t i = 0; i < num_workers; ++i)
+        workers.emplace_back(&DrawCallsScene::worker_loop, this, i);
+}
+
+void DrawCallsScene::stop_workers()
+{
+    {
+        std::lock_guard<std::mutex> lock{work_mutex};
+        work_stop = true;
+    }
+
+    work_cv.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+
+    workers.clear();
+}
+
+void DrawCallsScene::worker_loop(size_t worker)
+{
+    uint64_t generation = 0;
+
+    while (true)
+    {
+        size_t image_index;
+
+        {
+            std::unique_lock<std::mutex> lock{work_mutex};
+            work_cv.wait(lock, [&] { return work_stop || work_generation != generation; });
+            if (work_stop)
+                return;
+            generation = work_generation;
+            image_index = work_image_index;
+        }
+
+        std::exception_ptr error;
+
+        try
+        {
+            record_secondary_command_buffer(image_index, worker);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{work_mutex};
+            if (error)
+                work_error = error;
+            if (--work_pending == 0)
+                work_done_cv.notify_one();
+        }
+    }
+}
+
+void DrawCallsScene::record_secondary_command_buffer(size_t image_index, size_t worker)
+{
+    auto const& frame = frames[image_index];
+    auto const command_buffer = frame.worker_command_buffers[worker];
+
+    vulkan->device().resetCommandPool(frame.worker_command_pools[worker], {});
+
+    auto const inheritance_info = vk::CommandBufferInheritanceInfo{}
+        .setRenderPass(render_pass)
+        .setSubpass(0)
+        .setFramebuffer(framebuffers[image_index]);
+
+    auto const begin_info = vk::CommandBufferBeginInfo{}
+        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                  vk::CommandBufferUsageFlagBits::eRenderPassContinue)
+        .setPInheritanceInfo(&inheritance_info);
+
+    command_buffer.begin(begin_info);
+    command_buffer.bindIndexBuffer(index_buffer, 0, mesh->index_type());
+
+    auto const num_indices = static_cast<uint32_t>(mesh->num_indices());
+    auto const first_draw = num_draws * worker / num_workers;
+    auto const end_draw = num_draws * (worker + 1) / num_workers;
+    std::array<vk::DeviceSize, 2> const vertex_buffer_offsets{{0, 0}};
+
+    for (auto i = first_draw; i < end_draw; ++i)
+    {
+        // Bind all the state for the first draw, and afterwards only the
+        // state that alternates between draws
+        auto const alternate = i % 2;
+
+        if (i == first_draw || change_pipeline)
+        {
+            command_buffer.bindPipeline(
+                vk::PipelineBindPoint::eGraphics,
+                pipelines[change_pipeline ? alternate : 0]);
+        }
+
+        if (i == first_draw || change_descriptor_set)
+        {
+            command_buffer.bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
+                descriptor_sets[change_descriptor_set ? alternate : 0].raw, {});
+        }
+
+        if (i == first_draw || change_vertex_buffer)
+        {
+            std::array<vk::Buffer, 2> const buffers{{
+                vertex_buffers[change_vertex_buffer ? alternate : 0], instance_buffer}};
+            command_buffer.bindVertexBuffers(0, buffers, vertex_buffer_offsets);
+        }
+
+        command_buffer.drawIndexed(num_indices, 1, 0, 0, i);
+    }
+
+    command_buffer.end();
+}
+
+void DrawCallsScene::record_command_buffer(size_t image_index)
+{
+    auto& frame = frames[image_index];
+
+    if (!frame.fence)
+    {
+        frame.fence = vulkan->device().createFence(vk::FenceCreateInfo());
+    }
+    else
+    {
+        vulkan->device().waitForFences(frame.fence, true, INT64_MAX);
+        vulkan->device().resetFences(frame.fence);
+    }
+
+    // Record the draws in the secondary command buffers, in parallel
+    {
+        std::lock_guard<std::mutex> lock{work_mutex};
+        work_image_index = image_index;
+        work_pending = num_workers;
+        ++work_generation;
+    }
+
+    work_cv.notify_all();
+
+    {
+        std::unique_lock<std::mutex> lock{work_mutex};
+        work_done_cv.wait(lock, [this] { return work_pending == 0; });
+
+        if (work_error)
+        {
+            auto const error = work_error;
+            work_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    vulkan->device().resetCommandPool(frame.command_pool, {});
+
+    auto const begin_info = vk::CommandBufferBeginInfo{}
+        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+    frame.command_buffer.begin(begin_info);
+
+    std::array<vk::ClearValue, 2> clear_values{{
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+        vk::ClearDepthStencilValue{1.0f, 0}}};
+
+    auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+        .setRenderPass(render_pass)
+        .setFramebuffer(framebuffers[image_index])
+        .setRenderArea({{0,0}, extent})
+        .setClearValueCount(clear_values.size())
+        .setPClearValues(clear_values.data());
+
+    frame.command_buffer.beginRenderPass(
+        render_pass_begin_info, vk::SubpassContents::eSecondaryCommandBuffers);
+    frame.command_buffer.executeCommands(frame.worker_command_buffers);
+    frame.command_buffer.endRenderPass();
+    frame.command_buffer.end();
+}
+
+void DrawCallsScene::update_uniforms()
+{
+    glm::mat4 modelview{1.0};
+    modelview = glm::rotate(modelview, glm::radians(rotation), {0.0f, 0.0f, 1.0f});
+    modelview = glm::rotate(modelview, glm::radians(30.0f), {1.0f, 0.0f, 0.0f});
+
+    // The alternate descriptor set uses a different material color, to make
+    // the descriptor set changes visible
+    std::array<glm::vec4, 2> const material_diffuse{{
+        {0.7f, 0.7f, 0.7f, 1.0f}, {0.7f, 0.5f, 0.3f, 1.0f}}};
+
+    for (size_t i = 0; i < uniform_buffer_maps.size(); ++i)
+    {
+        Uniforms ubo;
+
+        ubo.modelviewprojection = projection * modelview;
+        ubo.normal = glm::inverseTranspose(modelview);
+        ubo.material_diffuse = material_diffuse[i];
+
+        memcpy(uniform_buffer_maps[i], &ubo, sizeof(ubo));
+    }
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "multisample_scene.h"
+#include "managed_resource.h"
+#include "vkutil/msaa_color_target.h"
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+class DrawCallsScene : public MultisampleScene
+{
+public:
+    DrawCallsScene();
+    ~DrawCallsScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+    void update() override;
+
+    std::string extra_results() const override;
+
+private:
+    // The command buffers used for a swapchain image, re-recorded every frame
+    struct Frame
+    {
+        ManagedResource<vk::CommandPool> command_pool;
+        vk::CommandBuffer command_buffer;
+        // One command pool and secondary command buffer per worker thread
+        std::vector<ManagedResource<vk::CommandPool>> worker_command_pools;
+        std::vector<vk::CommandBuffer> worker_command_buffers;
+        vk::Fence fence;
+    };
+
+    void setup_draws();
+    void setup_vertex_buffers();
+    void setup_index_buffer();
+    void setup_instance_buffer();
+    void setup_uniform_buffers();
+    void setup_descriptor_sets();
+    void setup_render_pass();
+    void setup_pipelines();
+    void setup_depth_image();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_frames();
+    void start_workers();
+    void stop_workers();
+    void worker_loop(size_t worker);
+    void record_secondary_command_buffer(size_t image_index, size_t worker);
+    void record_command_buffer(size_t image_index);
+    void update_uniforms();
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+    vk::Format depth_format;
+    glm::mat4 projection;
+    size_t num_draws;
+    size_t num_workers;
+    bool change_pipeline;
+    bool change_descriptor_set;
+    bool change_vertex_buffer;
+
+    std::shared_ptr<Mesh const> mesh;
+    // Position (xyz) and scale (w) of each drawn object
+    std::vector<glm::vec4> objects;
+
+    // Two of each of the resources that can change between draws
+    std::vector<ManagedResource<vk::Buffer>> vertex_buffers;
+    ManagedResource<vk::Buffer> index_buffer;
+    ManagedResource<vk::Buffer> instance_buffer;
+    std::vector<ManagedResource<vk::Buffer>> uniform_buffers;
+    std::vector<ManagedResource<void*>> uniform_buffer_maps;
+    std::vector<ManagedResource<vk::DescriptorSet>> descriptor_sets;
+    ManagedResource<vk::RenderPass> render_pass;
+    ManagedResource<vk::PipelineLayout> pipeline_layout;
+    std::vector<ManagedResource<vk::Pipeline>> pipelines;
+    vkutil::MsaaColorTarget color_target;
+    ManagedResource<vk::Image> depth_image;
+    ManagedResource<vk::ImageView> depth_image_view;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    std::vector<Frame> frames;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+
+    vk::DescriptorSetLayout descriptor_set_layout;
+
+    // Worker threads record their share of the draws for the frame of
+    // work_image_index, whenever work_generation changes
+    std::vector<std::thread> workers;
+    std::mutex work_mutex;
+    std::condition_variable work_cv;
+    std::condition_variable work_done_cv;
+    uint64_t work_generation;
+    size_t work_image_index;
+    size_t work_pending;
+    bool work_stop;
+    std::exception_ptr work_error;
+
+    float rotation;
+};
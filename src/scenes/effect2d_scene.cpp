@@ -22,6 +22,7 @@
 
 #include "effect2d_scene.h"
 
+#include "format_options.h"
 #include "mesh.h"
 #include "util.h"
 #include "vulkan_state.h"
@@ -29,7 +30,10 @@
 #include "vkutil/vkutil.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <cmath>
+#include <sstream>
+#include <stdexcept>
 
 namespace
 {
@@ -40,6 +44,32 @@ struct Uniforms
     float texture_step_y;
 };
 
+std::vector<std::string> chain_option_value(std::string const& value)
+{
+    if (value.empty())
+        return {};
+
+    auto const chain = Util::split(value, ',');
+
+    for (auto const& kernel : chain)
+    {
+        if (kernel != "blur" && kernel != "edge" && kernel != "none")
+            throw std::runtime_error("Unsupported \"chain\" kernel: " + kernel);
+    }
+
+    return chain;
+}
+
+float intermediate_scale_option_value(std::string const& value)
+{
+    auto const scale = Util::from_string<float>(value);
+
+    if (scale < 0.1f || scale > 4.0f)
+        throw std::runtime_error("\"intermediate-scale\" option must be between 0.1 and 4.0");
+
+    return scale;
+}
+
 std::unique_ptr<Mesh> create_quad_mesh()
 {
     auto mesh = std::make_unique<Mesh>(
@@ -82,10 +112,39 @@ Effect2DScene::Effect2DScene() : Scene{"effect2d"}
         SceneOption("background-resolution", "800x600",
                     "the resolution of the background image",
                     "800x600,1920x1080");
+    options_["chain"] =
+        SceneOption("chain", "",
+                    "comma separated kernels (blur, edge or none) to apply in "
+                    "offscreen passes before the final pass, instead of kernel");
+    options_["intermediate-format"] =
+        SceneOption("intermediate-format", "swapchain",
+                    "the format of the offscreen images used by the chain",
+                    "swapchain,rgba8,rgb10a2,rgba16f,rgba32f");
+    options_["intermediate-scale"] =
+        SceneOption("intermediate-scale", "1.0",
+                    "the resolution of the offscreen images used by the chain, "
+                    "relative to the window (0.1 to 4.0)");
 }
 
 Effect2DScene::~Effect2DScene() = default;
 
+void Effect2DScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    Util::read_image_file(
+        "textures/desktop-background-" + options.at("background-resolution").value + ".png");
+    Util::read_data_file("shaders/effect2d.vert.spv");
+
+    auto const chain = chain_option_value(options.at("chain").value);
+
+    if (chain.empty())
+        Util::read_data_file("shaders/effect2d-" + options.at("kernel").value + ".frag.spv");
+    else
+        Util::read_data_file("shaders/effect2d-none.frag.spv");
+
+    for (auto const& kernel : chain)
+        Util::read_data_file("shaders/effect2d-" + kernel + ".frag.spv");
+}
+
 void Effect2DScene::setup(
     VulkanState& vulkan_,
     std::vector<VulkanImage> const& vulkan_images)
@@ -95,12 +154,21 @@ void Effect2DScene::setup(
     vulkan = &vulkan_;
     extent = vulkan_images[0].extent;
     format = vulkan_images[0].format;
+    chain = chain_option_value(options_["chain"].value);
+    intermediate_format = color_format_option_value(
+        "intermediate-format", options_["intermediate-format"].value, format);
+
+    auto const scale = intermediate_scale_option_value(options_["intermediate-scale"].value);
+    intermediate_extent = vk::Extent2D{
+        std::max(static_cast<uint32_t>(extent.width * scale), 1u),
+        std::max(static_cast<uint32_t>(extent.height * scale), 1u)};
 
     mesh = create_quad_mesh();
 
     setup_vertex_buffer();
     setup_uniform_buffer();
     setup_texture();
+    setup_intermediate_images();
     setup_shader_descriptor_set();
     setup_render_pass();
     setup_pipeline();
@@ -120,10 +188,17 @@ void Effect2DScene::teardown()
     vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
     framebuffers.clear();
     image_views.clear();
+    intermediate_framebuffers.clear();
     pipeline = {};
+    chain_pipelines.clear();
     pipeline_layout = {};
     render_pass = {};
+    intermediate_render_pass = {};
+    intermediate_descriptor_sets.clear();
     descriptor_set = {};
+    intermediate_sampler = {};
+    intermediate_image_views.clear();
+    intermediate_images.clear();
     texture = {};
     uniform_buffer_map = {};
     uniform_buffer = {};
@@ -154,37 +229,21 @@ void Effect2DScene::update()
     Scene::update();
 }
 
-void Effect2DScene::setup_vertex_buffer()
+std::string Effect2DScene::extra_results() const
 {
-    vk::DeviceMemory staging_buffer_memory;
-    vk::BufferUsageFlags staging_usage_flags =
-        vk::BufferUsageFlagBits::eVertexBuffer |
-        vk::BufferUsageFlagBits::eTransferSrc;
-
-    auto staging_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(staging_usage_flags)
-        .set_memory_properties(
-            vk::MemoryPropertyFlagBits::eHostVisible |
-            vk::MemoryPropertyFlagBits::eHostCoherent)
-        .set_memory_out(staging_buffer_memory)
-        .build();
-
-    {
-        auto const staging_buffer_map = vkutil::map_memory(
-            *vulkan, staging_buffer_memory, 0, mesh->vertex_data_size());
-        mesh->copy_vertex_data_to(staging_buffer_map);
-    }
-
-    vertex_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(
-            vk::BufferUsageFlagBits::eVertexBuffer |
-            vk::BufferUsageFlagBits::eTransferDst)
-        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
-        .build();
+    if (chain.empty())
+        return {};
+
+    std::stringstream ss;
+    ss << "Passes: " << chain.size() + 1
+       << " Intermediate: " << intermediate_extent.width << "x" << intermediate_extent.height
+       << " " << vk::to_string(intermediate_format);
+    return ss.str();
+}
 
-    vkutil::copy_buffer(*vulkan, staging_buffer, vertex_buffer, mesh->vertex_data_size());
+void Effect2DScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
 }
 
 void Effect2DScene::setup_uniform_buffer()
@@ -215,6 +274,69 @@ void Effect2DScene::setup_texture()
         .build();
 }
 
+void Effect2DScene::setup_intermediate_images()
+{
+    if (chain.empty())
+        return;
+
+    auto const required_features =
+        vk::FormatFeatureFlagBits::eColorAttachment |
+        vk::FormatFeatureFlagBits::eSampledImage |
+        vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+    auto const format_props = vulkan->physical_device().getFormatProperties(intermediate_format);
+
+    if ((format_props.optimalTilingFeatures & required_features) != required_features)
+    {
+        throw std::runtime_error{"Format " + vk::to_string(intermediate_format) +
+                                 " is not supported as a filtered color attachment" +
+                                 " by the device"};
+    }
+
+    // Each pass reads the output of the previous one, so two images are
+    // enough for any chain length
+    auto const num_images = std::min(chain.size(), size_t{2});
+
+    for (size_t i = 0; i < num_images; ++i)
+    {
+        intermediate_images.push_back(
+            vkutil::ImageBuilder{*vulkan}
+                .set_extent(intermediate_extent)
+                .set_format(intermediate_format)
+                .set_tiling(vk::ImageTiling::eOptimal)
+                .set_usage(
+                    vk::ImageUsageFlagBits::eColorAttachment |
+                    vk::ImageUsageFlagBits::eSampled)
+                .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+                .set_initial_layout(vk::ImageLayout::eUndefined)
+                .build());
+
+        intermediate_image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(intermediate_images.back())
+                .set_format(intermediate_format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    // Linear filtering scales the last intermediate image to the window size
+    auto const sampler_create_info = vk::SamplerCreateInfo{}
+        .setMagFilter(vk::Filter::eLinear)
+        .setMinFilter(vk::Filter::eLinear)
+        .setAddressModeU(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeV(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeW(vk::SamplerAddressMode::eClampToEdge)
+        .setAnisotropyEnable(false)
+        .setUnnormalizedCoordinates(false)
+        .setCompareEnable(false)
+        .setMinLod(0.0f)
+        .setMaxLod(0.25f)
+        .setMipmapMode(vk::SamplerMipmapMode::eNearest);
+
+    intermediate_sampler = ManagedResource<vk::Sampler>{
+        vulkan->device().createSampler(sampler_create_info),
+        [this] (auto const& s) { vulkan->device().destroySampler(s); }};
+}
+
 void Effect2DScene::setup_shader_descriptor_set()
 {
     descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
@@ -227,6 +349,21 @@ void Effect2DScene::setup_shader_descriptor_set()
         .set_image_view(texture.image_view, texture.sampler)
         .set_layout_out(descriptor_set_layout)
         .build();
+
+    // All sets have the same layout, so they can share the pipeline layout
+    for (auto& image_view : intermediate_image_views)
+    {
+        intermediate_descriptor_sets.push_back(
+            vkutil::DescriptorSetBuilder{*vulkan}
+                .set_type(vk::DescriptorType::eUniformBuffer)
+                .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+                .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+                .next_binding()
+                .set_type(vk::DescriptorType::eCombinedImageSampler)
+                .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+                .set_image_view(image_view, intermediate_sampler)
+                .build());
+    }
 }
 
 void Effect2DScene::setup_render_pass()
@@ -235,6 +372,15 @@ void Effect2DScene::setup_render_pass()
         .set_color_format(format)
         .set_color_load_op(vk::AttachmentLoadOp::eDontCare)
         .build();
+
+    if (chain.empty())
+        return;
+
+    intermediate_render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(intermediate_format)
+        .set_color_load_op(vk::AttachmentLoadOp::eDontCare)
+        .set_color_final_layout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .build();
 }
 
 void Effect2DScene::setup_pipeline()
@@ -246,8 +392,9 @@ void Effect2DScene::setup_pipeline()
         vulkan->device().createPipelineLayout(pipeline_layout_create_info),
         [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
 
-    auto const frag_shader_file =
-        "shaders/effect2d-" + options_["kernel"].value + ".frag.spv";
+    // With a chain, the final pass only copies the result to the window
+    auto const kernel = chain.empty() ? options_["kernel"].value : "none";
+    auto const frag_shader_file = "shaders/effect2d-" + kernel + ".frag.spv";
 
     pipeline = vkutil::PipelineBuilder{*vulkan}
         .set_extent(extent)
@@ -258,10 +405,35 @@ void Effect2DScene::setup_pipeline()
         .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
         .build();
 
+    for (auto const& chain_kernel : chain)
+    {
+        if (chain_pipelines.count(chain_kernel))
+            continue;
+
+        chain_pipelines[chain_kernel] = vkutil::PipelineBuilder{*vulkan}
+            .set_extent(intermediate_extent)
+            .set_layout(pipeline_layout)
+            .set_render_pass(intermediate_render_pass)
+            .set_vertex_shader(Util::read_data_file("shaders/effect2d.vert.spv"))
+            .set_fragment_shader(
+                Util::read_data_file("shaders/effect2d-" + chain_kernel + ".frag.spv"))
+            .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+            .build();
+    }
 }
 
 void Effect2DScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
 {
+    for (auto const& image_view : intermediate_image_views)
+    {
+        intermediate_framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(intermediate_render_pass)
+                .set_image_views({image_view})
+                .set_extent(intermediate_extent)
+                .build());
+    }
+
     for (auto const& vulkan_image : vulkan_images)
     {
         image_views.push_back(
@@ -293,6 +465,18 @@ void Effect2DScene::setup_command_buffers()
     command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
     auto const binding_offsets = mesh->vertex_data_binding_offsets();
 
+    // Each pass reads the image written by the previous pass, and overwrites
+    // the image read by the pass before that
+    auto const pass_barrier = vk::MemoryBarrier{}
+        .setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+    auto const pass_barrier_stages =
+        vk::PipelineStageFlagBits::eColorAttachmentOutput |
+        vk::PipelineStageFlagBits::eFragmentShader;
+
+    auto const final_descriptor_set = chain.empty() ?
+        descriptor_set.raw : intermediate_descriptor_sets[(chain.size() - 1) % 2].raw;
+
     for (size_t i = 0; i < command_buffers.size(); ++i)
     {
         auto const begin_info = vk::CommandBufferBeginInfo{}
@@ -300,6 +484,43 @@ void Effect2DScene::setup_command_buffers()
 
         command_buffers[i].begin(begin_info);
 
+        for (size_t pass = 0; pass < chain.size(); ++pass)
+        {
+            // The intermediate images are shared by all frames, so the first
+            // pass also waits for the previous frame to finish reading them
+            command_buffers[i].pipelineBarrier(
+                pass_barrier_stages, pass_barrier_stages,
+                {}, pass_barrier, {}, {});
+
+            auto const intermediate_render_pass_begin_info = vk::RenderPassBeginInfo{}
+                .setRenderPass(intermediate_render_pass)
+                .setFramebuffer(intermediate_framebuffers[pass % 2])
+                .setRenderArea({{0,0}, intermediate_extent});
+
+            auto const& pass_descriptor_set = pass == 0 ?
+                descriptor_set.raw : intermediate_descriptor_sets[(pass - 1) % 2].raw;
+
+            command_buffers[i].beginRenderPass(intermediate_render_pass_begin_info, vk::SubpassContents::eInline);
+            command_buffers[i].bindVertexBuffers(
+                0,
+                std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+                binding_offsets
+                );
+            command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, chain_pipelines[chain[pass]]);
+            command_buffers[i].bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, pass_descriptor_set, {});
+            command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+            command_buffers[i].endRenderPass();
+        }
+
+        if (!chain.empty())
+        {
+            command_buffers[i].pipelineBarrier(
+                vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                {}, pass_barrier, {}, {});
+        }
+
         auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
             .setRenderPass(render_pass)
             .setFramebuffer(framebuffers[i])
@@ -316,7 +537,7 @@ void Effect2DScene::setup_command_buffers()
         command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
 
         command_buffers[i].bindDescriptorSets(
-            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, descriptor_set.raw, {});
+            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, final_descriptor_set, {});
         command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
 
         command_buffers[i].endRenderPass();
@@ -328,8 +549,11 @@ void Effect2DScene::update_uniforms()
 {
     Uniforms ubo;
 
-    ubo.texture_step_x = 1.0 / extent.width;
-    ubo.texture_step_y = 1.0 / extent.height;
+    // The kernels are applied at the resolution of the images they render to
+    auto const kernel_extent = chain.empty() ? extent : intermediate_extent;
+
+    ubo.texture_step_x = 1.0 / kernel_extent.width;
+    ubo.texture_step_y = 1.0 / kernel_extent.height;
 
     memcpy(uniform_buffer_map, &ubo, sizeof(ubo));
 }
@@ -26,6 +26,7 @@
 #include "managed_resource.h"
 #include "vkutil/texture.h"
 
+#include <map>
 #include <memory>
 
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -40,16 +41,20 @@ public:
     Effect2DScene();
     ~Effect2DScene();
 
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
     void setup(VulkanState&, std::vector<VulkanImage> const&) override;
     void teardown() override;
 
     VulkanImage draw(VulkanImage const&) override;
     void update() override;
 
+    std::string extra_results() const override;
+
 private:
     void setup_vertex_buffer();
     void setup_uniform_buffer();
     void setup_texture();
+    void setup_intermediate_images();
     void setup_shader_descriptor_set();
     void setup_render_pass();
     void setup_pipeline();
@@ -60,6 +65,10 @@ private:
     VulkanState* vulkan;
     vk::Extent2D extent;
     vk::Format format;
+    // The kernels applied by offscreen passes, before the final pass
+    std::vector<std::string> chain;
+    vk::Format intermediate_format;
+    vk::Extent2D intermediate_extent;
 
     std::unique_ptr<Mesh> mesh;
 
@@ -67,10 +76,17 @@ private:
     ManagedResource<vk::Buffer> uniform_buffer;
     ManagedResource<void*> uniform_buffer_map;
     vkutil::Texture texture;
+    std::vector<ManagedResource<vk::Image>> intermediate_images;
+    std::vector<ManagedResource<vk::ImageView>> intermediate_image_views;
+    ManagedResource<vk::Sampler> intermediate_sampler;
     ManagedResource<vk::DescriptorSet> descriptor_set;
+    std::vector<ManagedResource<vk::DescriptorSet>> intermediate_descriptor_sets;
+    ManagedResource<vk::RenderPass> intermediate_render_pass;
     ManagedResource<vk::RenderPass> render_pass;
     ManagedResource<vk::PipelineLayout> pipeline_layout;
+    std::map<std::string, ManagedResource<vk::Pipeline>> chain_pipelines;
     ManagedResource<vk::Pipeline> pipeline;
+    std::vector<ManagedResource<vk::Framebuffer>> intermediate_framebuffers;
     std::vector<ManagedResource<vk::ImageView>> image_views;
     std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
     std::vector<vk::CommandBuffer> command_buffers;
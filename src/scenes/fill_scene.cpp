@@ -0,0 +1,413 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fill_scene.h"
+
+#include "format_options.h"
+#include "mesh.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <array>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+uint32_t const max_layers = 1000;
+
+std::unique_ptr<Mesh> create_quad_mesh()
+{
+    auto mesh = std::make_unique<Mesh>(
+        std::vector<vk::Format>{vk::Format::eR32G32Sfloat, vk::Format::eR32G32Sfloat});
+
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,-1});
+    mesh->set_attribute(1, {0,0});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,1});
+    mesh->set_attribute(1, {0,1});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,1});
+    mesh->set_attribute(1, {1,1});
+
+    mesh->next_vertex();
+    mesh->set_attribute(0, {-1,-1});
+    mesh->set_attribute(1, {0,0});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,1});
+    mesh->set_attribute(1, {1,1});
+    mesh->next_vertex();
+    mesh->set_attribute(0, {1,-1});
+    mesh->set_attribute(1, {1,0});
+
+    mesh->set_interleave(true);
+
+    return mesh;
+}
+
+}
+
+FillScene::FillScene() : Scene{"fill"}
+{
+    options_["layers"] =
+        SceneOption("layers", "8",
+                    "The number of fullscreen layers to draw per frame (1 to 1000)");
+
+    options_["blend"] =
+        SceneOption("blend", "true",
+                    "Whether to blend the layers, instead of overwriting the pixels "
+                    "(which some GPUs can detect and skip)",
+                    "false,true");
+
+    options_["format"] =
+        SceneOption("format", "swapchain",
+                    "The format of the image the layers are drawn to",
+                    "swapchain,rgba8,rgb10a2,rgba16f,rgba32f");
+}
+
+FillScene::~FillScene() = default;
+
+void FillScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    Util::read_data_file("shaders/effect2d.vert.spv");
+    Util::read_data_file("shaders/fill.frag.spv");
+
+    if (options.at("format").value != "swapchain")
+        Util::read_data_file("shaders/texture-view.frag.spv");
+}
+
+void FillScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    Scene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+
+    num_layers = Util::ranged_option_value<uint32_t>(
+        "layers", options_["layers"].value, 1, max_layers);
+    offscreen = options_["format"].value != "swapchain";
+    fill_format = color_format_option_value("format", options_["format"].value, format);
+
+    if (offscreen)
+    {
+        auto const required_features =
+            vk::FormatFeatureFlagBits::eColorAttachment |
+            vk::FormatFeatureFlagBits::eSampledImage |
+            (options_["blend"].value == "true" ?
+             vk::FormatFeatureFlagBits::eColorAttachmentBlend : vk::FormatFeatureFlags{});
+        auto const format_props = vulkan->physical_device().getFormatProperties(fill_format);
+
+        if ((format_props.optimalTilingFeatures & required_features) != required_features)
+        {
+            throw std::runtime_error{"Format " + vk::to_string(fill_format) +
+                                     " is not supported as a blended color attachment" +
+                                     " by the device"};
+        }
+    }
+
+    mesh = create_quad_mesh();
+
+    setup_vertex_buffer();
+    if (offscreen)
+        setup_offscreen_image();
+    setup_render_passes();
+    setup_pipelines();
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+}
+
+void FillScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
+    framebuffers.clear();
+    image_views.clear();
+    offscreen_framebuffer = {};
+    view_pipeline = {};
+    view_pipeline_layout = {};
+    fill_pipeline = {};
+    fill_pipeline_layout = {};
+    view_render_pass = {};
+    fill_render_pass = {};
+    descriptor_set = {};
+    sampler = {};
+    offscreen_image_view = {};
+    offscreen_image = {};
+    vertex_buffer = {};
+
+    Scene::teardown();
+}
+
+VulkanImage FillScene::draw(VulkanImage const& image)
+{
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&command_buffers[image.index])
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, {});
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+std::string FillScene::extra_results() const
+{
+    auto const pixels_per_frame =
+        static_cast<double>(extent.width) * extent.height * num_layers;
+
+    std::stringstream ss;
+    ss << "Layers: " << num_layers << " Format: " << vk::to_string(fill_format)
+       << " Fill rate: " << std::fixed << std::setprecision(2)
+       << pixels_per_frame * average_fps() / 1000000000.0 << " Gpixels/s";
+    return ss.str();
+}
+
+void FillScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
+
+void FillScene::setup_offscreen_image()
+{
+    offscreen_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(fill_format)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(
+            vk::ImageUsageFlagBits::eColorAttachment |
+            vk::ImageUsageFlagBits::eSampled)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    offscreen_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(offscreen_image)
+        .set_format(fill_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+        .build();
+
+    auto const sampler_create_info = vk::SamplerCreateInfo{}
+        .setMagFilter(vk::Filter::eNearest)
+        .setMinFilter(vk::Filter::eNearest)
+        .setAddressModeU(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeV(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeW(vk::SamplerAddressMode::eClampToEdge)
+        .setAnisotropyEnable(false)
+        .setUnnormalizedCoordinates(false)
+        .setCompareEnable(false)
+        .setMinLod(0.0f)
+        .setMaxLod(0.25f)
+        .setMipmapMode(vk::SamplerMipmapMode::eNearest);
+
+    sampler = ManagedResource<vk::Sampler>{
+        vulkan->device().createSampler(sampler_create_info),
+        [this] (auto const& s) { vulkan->device().destroySampler(s); }};
+
+    descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eCombinedImageSampler)
+        .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+        .set_image_view(offscreen_image_view, sampler)
+        .set_layout_out(descriptor_set_layout)
+        .build();
+}
+
+void FillScene::setup_render_passes()
+{
+    fill_render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(fill_format)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .set_color_final_layout(
+            offscreen ?
+            vk::ImageLayout::eShaderReadOnlyOptimal :
+            vk::ImageLayout::ePresentSrcKHR)
+        .build();
+
+    if (offscreen)
+    {
+        view_render_pass = vkutil::RenderPassBuilder(*vulkan)
+            .set_color_format(format)
+            .set_color_load_op(vk::AttachmentLoadOp::eDontCare)
+            .build();
+    }
+}
+
+void FillScene::setup_pipelines()
+{
+    fill_pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(vk::PipelineLayoutCreateInfo{}),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    // Each layer is blended over the previous ones, with the alpha
+    // accumulating the coverage
+    fill_pipeline = vkutil::PipelineBuilder{*vulkan}
+        .set_extent(extent)
+        .set_layout(fill_pipeline_layout)
+        .set_render_pass(fill_render_pass)
+        .set_vertex_shader(Util::read_data_file("shaders/effect2d.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/fill.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .set_blend(options_["blend"].value == "true")
+        .set_blend_factors(
+            vk::BlendFactor::eSrcAlpha, vk::BlendFactor::eOneMinusSrcAlpha,
+            vk::BlendFactor::eOne, vk::BlendFactor::eOneMinusSrcAlpha)
+        .build();
+
+    if (!offscreen)
+        return;
+
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    view_pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    view_pipeline = vkutil::PipelineBuilder{*vulkan}
+        .set_extent(extent)
+        .set_layout(view_pipeline_layout)
+        .set_render_pass(view_render_pass)
+        .set_vertex_shader(Util::read_data_file("shaders/effect2d.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/texture-view.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .build();
+}
+
+void FillScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    if (offscreen)
+    {
+        offscreen_framebuffer = vkutil::FramebufferBuilder{*vulkan}
+            .set_render_pass(fill_render_pass)
+            .set_image_views({offscreen_image_view})
+            .set_extent(extent)
+            .build();
+    }
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(offscreen ? view_render_pass : fill_render_pass)
+                .set_image_views({image_view})
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void FillScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(framebuffers.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+    std::vector<vk::Buffer> const vertex_buffers{binding_offsets.size(), vertex_buffer.raw};
+
+    vk::ClearValue const clear_value{
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}}};
+
+    // The offscreen image is shared by all frames, and the display pass
+    // of the previous frame has to finish reading it before drawing to it
+    auto const view_barrier = vk::MemoryBarrier{}
+        .setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+
+    for (size_t i = 0; i < command_buffers.size(); ++i)
+    {
+        auto const begin_info = vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eSimultaneousUse);
+
+        command_buffers[i].begin(begin_info);
+
+        if (offscreen)
+        {
+            command_buffers[i].pipelineBarrier(
+                vk::PipelineStageFlagBits::eFragmentShader,
+                vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                {}, {}, {}, {});
+        }
+
+        auto const fill_render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(fill_render_pass)
+            .setFramebuffer(offscreen ? offscreen_framebuffer.raw : framebuffers[i].raw)
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(1)
+            .setPClearValues(&clear_value);
+
+        // All layers are drawn with a single draw, as instances of the same
+        // quad, which are rasterized in order
+        command_buffers[i].beginRenderPass(fill_render_pass_begin_info, vk::SubpassContents::eInline);
+        command_buffers[i].bindVertexBuffers(0, vertex_buffers, binding_offsets);
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, fill_pipeline);
+        command_buffers[i].draw(mesh->num_vertices(), num_layers, 0, 0);
+        command_buffers[i].endRenderPass();
+
+        if (offscreen)
+        {
+            command_buffers[i].pipelineBarrier(
+                vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                {}, view_barrier, {}, {});
+
+            auto const view_render_pass_begin_info = vk::RenderPassBeginInfo{}
+                .setRenderPass(view_render_pass)
+                .setFramebuffer(framebuffers[i])
+                .setRenderArea({{0,0}, extent});
+
+            command_buffers[i].beginRenderPass(view_render_pass_begin_info, vk::SubpassContents::eInline);
+            command_buffers[i].bindVertexBuffers(0, vertex_buffers, binding_offsets);
+            command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, view_pipeline);
+            command_buffers[i].bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics, view_pipeline_layout, 0, descriptor_set.raw, {});
+            command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+            command_buffers[i].endRenderPass();
+        }
+
+        command_buffers[i].end();
+    }
+}
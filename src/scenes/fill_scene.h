@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "scene.h"
+#include "managed_resource.h"
+
+#include <memory>
+
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+// Draws layers of fullscreen quads to measure fill rate. When the layers are
+// rendered to an image of a different format than the swapchain, an extra
+// pass displays that image.
+class FillScene : public Scene
+{
+public:
+    FillScene();
+    ~FillScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+
+    std::string extra_results() const override;
+
+private:
+    void setup_vertex_buffer();
+    void setup_offscreen_image();
+    void setup_render_passes();
+    void setup_pipelines();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_command_buffers();
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+    vk::Format fill_format;
+    bool offscreen;
+    uint32_t num_layers;
+
+    std::unique_ptr<Mesh> mesh;
+
+    ManagedResource<vk::Buffer> vertex_buffer;
+    ManagedResource<vk::Image> offscreen_image;
+    ManagedResource<vk::ImageView> offscreen_image_view;
+    ManagedResource<vk::Sampler> sampler;
+    ManagedResource<vk::DescriptorSet> descriptor_set;
+    ManagedResource<vk::RenderPass> fill_render_pass;
+    ManagedResource<vk::RenderPass> view_render_pass;
+    ManagedResource<vk::PipelineLayout> fill_pipeline_layout;
+    ManagedResource<vk::Pipeline> fill_pipeline;
+    ManagedResource<vk::PipelineLayout> view_pipeline_layout;
+    ManagedResource<vk::Pipeline> view_pipeline;
+    ManagedResource<vk::Framebuffer> offscreen_framebuffer;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    std::vector<vk::CommandBuffer> command_buffers;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+
+    vk::DescriptorSetLayout descriptor_set_layout;
+};
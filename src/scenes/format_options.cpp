@@ -0,0 +1,52 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "format_options.h"
+
+#include <stdexcept>
+
+std::pair<vk::Format, vk::Format> position_normal_formats(std::string const& vertex_format)
+{
+    if (vertex_format == "half")
+        return {vk::Format::eR16G16B16A16Sfloat, vk::Format::eR16G16B16A16Sfloat};
+    else if (vertex_format == "half-snorm8")
+        return {vk::Format::eR16G16B16A16Sfloat, vk::Format::eR8G8B8A8Snorm};
+    else if (vertex_format == "half-snorm10")
+        return {vk::Format::eR16G16B16A16Sfloat, vk::Format::eA2B10G10R10SnormPack32};
+    else
+        return {vk::Format::eR32G32B32Sfloat, vk::Format::eR32G32B32Sfloat};
+}
+
+vk::Format color_format_option_value(std::string const& name,
+                                     std::string const& value,
+                                     vk::Format swapchain_format)
+{
+    if (value == "swapchain")
+        return swapchain_format;
+    else if (value == "rgba8")
+        return vk::Format::eR8G8B8A8Unorm;
+    else if (value == "rgb10a2")
+        return vk::Format::eA2B10G10R10UnormPack32;
+    else if (value == "rgba16f")
+        return vk::Format::eR16G16B16A16Sfloat;
+    else if (value == "rgba32f")
+        return vk::Format::eR32G32B32A32Sfloat;
+    else
+        throw std::runtime_error("Unsupported \"" + name + "\" option value: " + value);
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <string>
+#include <utility>
+
+// The position and normal formats for a "vertex-format" option value
+std::pair<vk::Format, vk::Format> position_normal_formats(std::string const& vertex_format);
+
+// The color attachment format for an option accepting
+// "swapchain,rgba8,rgb10a2,rgba16f,rgba32f"
+vk::Format color_format_option_value(std::string const& name,
+                                     std::string const& value,
+                                     vk::Format swapchain_format);
@@ -0,0 +1,368 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "geometry_scene.h"
+
+#include "log.h"
+#include "mesh.h"
+#include "procedural_mesh.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 normal;
+    glm::vec4 material_diffuse;
+};
+
+size_t const min_triangles = 1000;
+size_t const max_triangles = 50000000;
+
+}
+
+GeometryScene::GeometryScene() : MultisampleScene{"geometry"}
+{
+    options_["shape"] =
+        SceneOption("shape", "sphere", "The shape of the generated mesh",
+                    "sphere,torus,heightfield");
+
+    options_["triangles"] =
+        SceneOption("triangles", "100000",
+                    "The number of triangles to generate (1000 to 50000000)");
+
+    options_["device-local"] =
+        SceneOption("device-local", "true",
+                    "Whether to use device-local buffers for the vertex and index data");
+}
+
+GeometryScene::~GeometryScene() = default;
+
+void GeometryScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    Util::read_data_file("shaders/light-basic.vert.spv");
+    Util::read_data_file("shaders/light-basic.frag.spv");
+}
+
+void GeometryScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    MultisampleScene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+
+    auto const shape = options_["shape"].value;
+    auto const triangles = Util::ranged_option_value<size_t>(
+        "triangles", options_["triangles"].value, min_triangles, max_triangles);
+
+    mesh = generate_procedural_mesh(shape, triangles);
+    mesh->set_interleave(true);
+    num_triangles = mesh->num_indices() / 3;
+
+    Log::debug("GeometryScene: Generated %s with %zu triangles, %zu vertices\n",
+               shape.c_str(), num_triangles, mesh->num_vertices());
+
+    // Model projection
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    auto const diameter = glm::length(max_bound - min_bound);
+    auto const aspect = static_cast<float>(extent.width)/static_cast<float>(extent.height);
+    center = (max_bound + min_bound) / 2.0f;
+    radius = diameter / 2.0f;
+    auto const fovy = 2.0f * atanf(radius / (2.0f + radius));
+    projection = glm::perspective(fovy, aspect, 2.0f, 2.0f + diameter);
+
+    setup_vertex_buffer();
+    setup_index_buffer();
+    setup_uniform_buffer();
+    setup_uniform_descriptor_set();
+    setup_render_pass();
+    setup_pipeline();
+    setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    // Large meshes take a lot of memory, which we don't need after uploading
+    mesh.reset();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    rotation = 0.0;
+}
+
+void GeometryScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
+    framebuffers.clear();
+    image_views.clear();
+    color_target = {};
+    depth_image_view = {};
+    depth_image = {};
+    pipeline = {};
+    pipeline_layout = {};
+    render_pass = {};
+    descriptor_set = {};
+    uniform_buffer_map = {};
+    uniform_buffer = {};
+    index_buffer = {};
+    vertex_buffer = {};
+
+    Scene::teardown();
+}
+
+VulkanImage GeometryScene::draw(VulkanImage const& image)
+{
+    update_uniforms();
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&command_buffers[image.index])
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, {});
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void GeometryScene::update()
+{
+    auto const t = (Util::get_timestamp_us() - start_time) / 1000000.0f;
+
+    rotation = 36.0f * t;
+
+    Scene::update();
+}
+
+std::string GeometryScene::extra_results() const
+{
+    std::stringstream ss;
+    ss << "Triangles: " << num_triangles
+       << " Throughput: " << std::fixed << std::setprecision(2)
+       << num_triangles * average_fps() / 1000000.0 << " Mtri/s";
+    return ss.str();
+}
+
+void GeometryScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(
+        *vulkan, *mesh, options_["device-local"].value == "true");
+}
+
+void GeometryScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(
+        *vulkan, *mesh, options_["device-local"].value == "true");
+}
+
+void GeometryScene::setup_uniform_buffer()
+{
+    uniform_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(sizeof(Uniforms))
+        .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(uniform_buffer_memory)
+        .build();
+
+    uniform_buffer_map = vkutil::map_memory(
+        *vulkan, uniform_buffer_memory, 0, sizeof(Uniforms));
+}
+
+
+void GeometryScene::setup_uniform_descriptor_set()
+{
+    descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eUniformBuffer)
+        .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+        .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+        .set_layout_out(descriptor_set_layout)
+        .build();
+}
+
+void GeometryScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_depth_format(depth_format)
+        .set_samples(samples)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void GeometryScene::setup_pipeline()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_samples(samples)
+        .set_vertex_shader(Util::read_data_file("shaders/light-basic.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/light-basic.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .set_depth_test(true)
+        .build();
+}
+
+void GeometryScene::setup_depth_image()
+{
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        depth_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::ImageAspectFlagBits::eDepth);
+}
+
+void GeometryScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void GeometryScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(framebuffers.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+
+    for (size_t i = 0; i < command_buffers.size(); ++i)
+    {
+        auto const begin_info = vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eSimultaneousUse);
+
+        command_buffers[i].begin(begin_info);
+
+        std::array<vk::ClearValue, 2> clear_values{{
+            vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+            vk::ClearDepthStencilValue{1.0f, 0}}};
+
+        auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(render_pass)
+            .setFramebuffer(framebuffers[i])
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(clear_values.size())
+            .setPClearValues(clear_values.data());
+
+        command_buffers[i].beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+        command_buffers[i].bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, descriptor_set.raw, {});
+        command_buffers[i].bindVertexBuffers(
+            0,
+            std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+            binding_offsets
+            );
+
+        command_buffers[i].bindIndexBuffer(index_buffer, 0, mesh->index_type());
+        command_buffers[i].drawIndexed(mesh->num_indices(), 1, 0, 0, 0);
+
+        command_buffers[i].endRenderPass();
+        command_buffers[i].end();
+    }
+}
+
+void GeometryScene::update_uniforms()
+{
+    Uniforms ubo;
+
+    glm::mat4 modelview{1.0};
+    modelview = glm::translate(modelview, glm::vec3{-center.x, -center.y, -(center.z + 2.0 + radius)});
+    // Tilt the mesh towards the viewer, so that the heightfield is visible
+    modelview = glm::rotate(modelview, glm::radians(-30.0f), {1.0f, 0.0f, 0.0f});
+    modelview = glm::rotate(modelview, glm::radians(rotation), {0.0f, 1.0f, 0.0f});
+
+    ubo.modelviewprojection = projection * modelview;
+    ubo.normal = glm::inverseTranspose(modelview);
+    ubo.material_diffuse = glm::vec4{0.7f, 0.7f, 0.7f, 1.0};
+
+    memcpy(uniform_buffer_map, &ubo, sizeof(ubo));
+}
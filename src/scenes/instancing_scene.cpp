@@ -0,0 +1,442 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "instancing_scene.h"
+
+#include "mesh.h"
+#include "model.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <cmath>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 normal;
+    glm::vec4 material_diffuse;
+};
+
+size_t const max_instances = 1000000;
+
+std::shared_ptr<Mesh const> load_mesh()
+{
+    return Model::load_mesh(
+        "cube.3ds",
+        ModelAttribMap{}
+            .with_position(vk::Format::eR32G32B32Sfloat)
+            .with_normal(vk::Format::eR32G32B32Sfloat)
+            .with_interleave(true),
+        true);
+}
+
+}
+
+InstancingScene::InstancingScene() : MultisampleScene{"instancing"}
+{
+    options_["instances"] =
+        SceneOption("instances", "10000", "The number of instances to draw (1 to 1000000)");
+
+    options_["instance-data"] =
+        SceneOption("instance-data", "attribute",
+                    "Where the vertex shader reads the per-instance data from: a vertex "
+                    "buffer with a per-instance input rate, or a storage buffer",
+                    "attribute,storage");
+
+    options_["separate-draws"] =
+        SceneOption("separate-draws", "false",
+                    "Whether to draw each instance with a separate draw call, instead of "
+                    "a single instanced draw call");
+}
+
+InstancingScene::~InstancingScene() = default;
+
+void InstancingScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    load_mesh();
+    Util::read_data_file("shaders/instancing-" + options.at("instance-data").value + ".vert.spv");
+    Util::read_data_file("shaders/light-basic.frag.spv");
+}
+
+void InstancingScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    MultisampleScene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+    use_storage_buffer = options_["instance-data"].value == "storage";
+
+    mesh = load_mesh();
+    setup_instances();
+    setup_vertex_buffer();
+    setup_index_buffer();
+    setup_instance_buffer();
+    setup_uniform_buffer();
+    setup_descriptor_set();
+    setup_render_pass();
+    setup_pipeline();
+    setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    rotation = 0.0;
+}
+
+void InstancingScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
+    framebuffers.clear();
+    image_views.clear();
+    color_target = {};
+    depth_image_view = {};
+    depth_image = {};
+    pipeline = {};
+    pipeline_layout = {};
+    render_pass = {};
+    descriptor_set = {};
+    uniform_buffer_map = {};
+    uniform_buffer = {};
+    instance_buffer = {};
+    index_buffer = {};
+    vertex_buffer = {};
+    instances.clear();
+    mesh.reset();
+
+    Scene::teardown();
+}
+
+VulkanImage InstancingScene::draw(VulkanImage const& image)
+{
+    update_uniforms();
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&command_buffers[image.index])
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, {});
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void InstancingScene::update()
+{
+    auto const t = (Util::get_timestamp_us() - start_time) / 1000000.0f;
+
+    rotation = 36.0f * t;
+
+    Scene::update();
+}
+
+void InstancingScene::setup_instances()
+{
+    auto const num_instances = Util::ranged_option_value<size_t>(
+        "instances", options_["instances"].value, 1, max_instances);
+
+    // Place the instances in the cells of a cube shaped grid of unit cells,
+    // scaling the mesh to fit comfortably in a cell
+    auto const grid = static_cast<size_t>(std::ceil(std::cbrt(num_instances)));
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    auto const scale = 0.8f / glm::length(max_bound - min_bound);
+    auto const center = (max_bound + min_bound) / 2.0f * scale;
+    auto const grid_center = (grid - 1) / 2.0f;
+
+    instances.reserve(num_instances);
+
+    for (size_t i = 0; i < num_instances; ++i)
+    {
+        glm::vec3 const cell(i % grid, i / grid % grid, i / (grid * grid));
+        instances.emplace_back(cell - grid_center - center, scale);
+    }
+
+    // Fit the bounding sphere of the grid in the view
+    auto const radius = grid * std::sqrt(3.0f) / 2.0f;
+    auto const aspect = static_cast<float>(extent.width) / extent.height;
+    view_distance = 3.0f * radius;
+    projection = glm::perspective(2.0f * std::asin(1.0f / 3.0f), aspect,
+                                  view_distance - radius, view_distance + radius);
+}
+
+void InstancingScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
+
+void InstancingScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(*vulkan, *mesh);
+}
+
+void InstancingScene::setup_instance_buffer()
+{
+    auto const size = instances.size() * sizeof(instances[0]);
+
+    instance_buffer = vkutil::create_device_local_buffer(
+        *vulkan, size,
+        use_storage_buffer ? vk::BufferUsageFlagBits::eStorageBuffer :
+                             vk::BufferUsageFlagBits::eVertexBuffer,
+        [this,size] (void* dst) { memcpy(dst, instances.data(), size); });
+}
+
+void InstancingScene::setup_uniform_buffer()
+{
+    uniform_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(sizeof(Uniforms))
+        .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(uniform_buffer_memory)
+        .build();
+
+    uniform_buffer_map = vkutil::map_memory(
+        *vulkan, uniform_buffer_memory, 0, sizeof(Uniforms));
+}
+
+void InstancingScene::setup_descriptor_set()
+{
+    vkutil::DescriptorSetBuilder builder{*vulkan};
+
+    builder.set_type(vk::DescriptorType::eUniformBuffer)
+        .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+        .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+        .set_layout_out(descriptor_set_layout);
+
+    if (use_storage_buffer)
+    {
+        builder.next_binding()
+            .set_type(vk::DescriptorType::eStorageBuffer)
+            .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+            .set_buffer(instance_buffer, 0, instances.size() * sizeof(instances[0]));
+    }
+
+    descriptor_set = builder.build();
+}
+
+void InstancingScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_depth_format(depth_format)
+        .set_samples(samples)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void InstancingScene::setup_pipeline()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    auto binding_descriptions = mesh->binding_descriptions();
+    auto attribute_descriptions = mesh->attribute_descriptions();
+
+    if (!use_storage_buffer)
+    {
+        uint32_t const binding = binding_descriptions.size();
+        uint32_t const location = attribute_descriptions.size();
+
+        binding_descriptions.push_back(
+            vk::VertexInputBindingDescription{}
+                .setBinding(binding)
+                .setStride(sizeof(instances[0]))
+                .setInputRate(vk::VertexInputRate::eInstance));
+        attribute_descriptions.push_back(
+            vk::VertexInputAttributeDescription{}
+                .setBinding(binding)
+                .setLocation(location)
+                .setFormat(vk::Format::eR32G32B32A32Sfloat)
+                .setOffset(0));
+    }
+
+    auto const vertex_shader =
+        use_storage_buffer ? "shaders/instancing-storage.vert.spv" :
+                             "shaders/instancing-attribute.vert.spv";
+
+    pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_samples(samples)
+        .set_vertex_shader(Util::read_data_file(vertex_shader))
+        .set_fragment_shader(Util::read_data_file("shaders/light-basic.frag.spv"))
+        .set_vertex_input(binding_descriptions, attribute_descriptions)
+        .set_depth_test(true)
+        .build();
+}
+
+void InstancingScene::setup_depth_image()
+{
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        depth_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::ImageAspectFlagBits::eDepth);
+}
+
+void InstancingScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void InstancingScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(framebuffers.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+
+    auto const separate_draws = options_["separate-draws"].value == "true";
+    auto const num_indices = static_cast<uint32_t>(mesh->num_indices());
+    auto const num_instances = static_cast<uint32_t>(instances.size());
+
+    auto binding_offsets = mesh->vertex_data_binding_offsets();
+    std::vector<vk::Buffer> vertex_buffers{binding_offsets.size(), vertex_buffer.raw};
+
+    if (!use_storage_buffer)
+    {
+        binding_offsets.push_back(0);
+        vertex_buffers.push_back(instance_buffer);
+    }
+
+    for (size_t i = 0; i < command_buffers.size(); ++i)
+    {
+        auto const begin_info = vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eSimultaneousUse);
+
+        command_buffers[i].begin(begin_info);
+
+        std::array<vk::ClearValue, 2> clear_values{{
+            vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+            vk::ClearDepthStencilValue{1.0f, 0}}};
+
+        auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(render_pass)
+            .setFramebuffer(framebuffers[i])
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(clear_values.size())
+            .setPClearValues(clear_values.data());
+
+        command_buffers[i].beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+        command_buffers[i].bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, descriptor_set.raw, {});
+        command_buffers[i].bindVertexBuffers(0, vertex_buffers, binding_offsets);
+        command_buffers[i].bindIndexBuffer(index_buffer, 0, mesh->index_type());
+
+        // Separate draws still pick their instance data through firstInstance,
+        // so that the only difference is the number of draw calls
+        if (separate_draws)
+        {
+            for (uint32_t j = 0; j < num_instances; ++j)
+                command_buffers[i].drawIndexed(num_indices, 1, 0, 0, j);
+        }
+        else
+        {
+            command_buffers[i].drawIndexed(num_indices, num_instances, 0, 0, 0);
+        }
+
+        command_buffers[i].endRenderPass();
+        command_buffers[i].end();
+    }
+}
+
+void InstancingScene::update_uniforms()
+{
+    Uniforms ubo;
+
+    glm::mat4 modelview{1.0};
+    modelview = glm::translate(modelview, glm::vec3{0.0f, 0.0f, -view_distance});
+    modelview = glm::rotate(modelview, glm::radians(-20.0f), {1.0f, 0.0f, 0.0f});
+    modelview = glm::rotate(modelview, glm::radians(rotation), {0.0f, 1.0f, 0.0f});
+
+    ubo.modelviewprojection = projection * modelview;
+    ubo.normal = glm::inverseTranspose(modelview);
+    ubo.material_diffuse = glm::vec4{0.7f, 0.7f, 0.7f, 1.0};
+
+    memcpy(uniform_buffer_map, &ubo, sizeof(ubo));
+}
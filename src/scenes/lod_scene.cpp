@@ -0,0 +1,491 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lod_scene.h"
+
+#include "mesh.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "model.h"
+#include "util.h"
+#include "log.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 normal;
+    glm::vec4 material_diffuse;
+};
+
+// Fraction of the full detail triangles in each LOD
+std::vector<float> const lod_triangle_ratios{1.0f, 0.5f, 0.25f, 0.1f, 0.05f};
+float const fovy = glm::radians(45.0f);
+
+std::shared_ptr<Mesh const> load_mesh()
+{
+    return Model::load_mesh(
+        "horse.3ds",
+        ModelAttribMap{}
+            .with_position(vk::Format::eR32G32B32Sfloat)
+            .with_normal(vk::Format::eR32G32B32Sfloat),
+        true);
+}
+
+}
+
+LodScene::LodScene() : MultisampleScene{"lod"}
+{
+    options_["grid"] =
+        SceneOption("grid", "8", "The number of model instances along each side of the field");
+
+    options_["lod"] =
+        SceneOption("lod", "true",
+                    "Whether to pick a level of detail per instance, instead of always "
+                    "drawing the full detail model",
+                    "false,true");
+
+    options_["triangle-size"] =
+        SceneOption("triangle-size", "8",
+                    "The target screen area of a triangle in pixels, used to pick the "
+                    "level of detail from the projected size of each instance");
+}
+
+LodScene::~LodScene() = default;
+
+void LodScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    load_mesh();
+    Util::read_data_file("shaders/light-basic.vert.spv");
+    Util::read_data_file("shaders/light-basic.frag.spv");
+}
+
+void LodScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    MultisampleScene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+
+    setup_lods();
+    setup_instances();
+    setup_vertex_buffer();
+    setup_index_buffer();
+    setup_uniform_buffer();
+    setup_uniform_descriptor_set();
+    setup_render_pass();
+    setup_pipeline();
+    setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    rotation = 0.0;
+}
+
+void LodScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
+    framebuffers.clear();
+    image_views.clear();
+    color_target = {};
+    depth_image_view = {};
+    depth_image = {};
+    pipeline = {};
+    pipeline_layout = {};
+    render_pass = {};
+    descriptor_set = {};
+    uniform_buffer_map = {};
+    uniform_buffer = {};
+    index_buffer = {};
+    vertex_buffer = {};
+    instance_lods.clear();
+    instance_positions.clear();
+    lods.clear();
+    lod_meshes.clear();
+
+    Scene::teardown();
+}
+
+VulkanImage LodScene::draw(VulkanImage const& image)
+{
+    update_uniforms();
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&command_buffers[image.index])
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, {});
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void LodScene::update()
+{
+    auto const t = (Util::get_timestamp_us() - start_time) / 1000000.0f;
+
+    rotation = 36.0f * t;
+
+    Scene::update();
+}
+
+void LodScene::setup_lods()
+{
+    auto const mesh = load_mesh();
+
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    center = (max_bound + min_bound) / 2.0f;
+    radius = glm::length(max_bound - min_bound) / 2.0f;
+
+    auto const num_triangles = mesh->num_indices() / 3;
+
+    // The loaded mesh is shared, so the full detail LOD is a copy that can
+    // be optimized below
+    lod_meshes.push_back(std::make_unique<Mesh>(*mesh));
+    for (size_t i = 1; i < lod_triangle_ratios.size(); ++i)
+    {
+        lod_meshes.push_back(
+            simplify_mesh(*lod_meshes[0], 0,
+                          static_cast<size_t>(num_triangles * lod_triangle_ratios[i])));
+    }
+
+    uint32_t first_index = 0;
+    int32_t vertex_offset = 0;
+
+    for (auto& lod_mesh : lod_meshes)
+    {
+        if (lod_mesh->num_indices() > 0)
+        {
+            optimize_vertex_cache(*lod_mesh);
+            optimize_vertex_fetch(*lod_mesh);
+        }
+        lod_mesh->set_interleave(true);
+
+        lods.push_back({first_index, static_cast<uint32_t>(lod_mesh->num_indices()),
+                        vertex_offset});
+
+        first_index += lod_mesh->num_indices();
+        vertex_offset += lod_mesh->num_vertices();
+    }
+}
+
+void LodScene::setup_instances()
+{
+    auto const grid = Util::ranged_option_value<size_t>(
+        "grid", options_["grid"].value, 1, 64);
+    auto const use_lod = options_["lod"].value == "true";
+    auto const triangle_size = Util::ranged_option_value<float>(
+        "triangle-size", options_["triangle-size"].value, 1.0f, 10000.0f);
+    auto const spacing = 2.5f * radius;
+    auto const far_distance = 3.0f * radius + grid * spacing;
+    auto const aspect = static_cast<float>(extent.width) / extent.height;
+
+    // Look at the middle of the field from above its near edge (models are
+    // converted to the vulkan coordinate system, so up is towards -y)
+    glm::vec3 const eye{0.0f, -2.0f * radius, 0.0f};
+    view = glm::lookAt(eye, glm::vec3{0.0f, 0.0f, -far_distance / 2.0f}, {0.0f, 1.0f, 0.0f});
+    projection = glm::perspective(fovy, aspect, radius, far_distance + 2.0f * radius);
+
+    for (size_t row = 0; row < grid; ++row)
+    {
+        for (size_t col = 0; col < grid; ++col)
+        {
+            glm::vec3 const position{
+                (col - (grid - 1) / 2.0f) * spacing,
+                0.0f,
+                -(3.0f * radius + row * spacing)};
+
+            // Pick the coarsest LOD that still has enough triangles to cover
+            // the projected area of the instance at the target triangle size
+            auto const distance = glm::length(position - eye);
+            auto const screen_radius =
+                radius / distance / std::tan(fovy / 2.0f) * extent.height / 2.0f;
+            auto const screen_area = static_cast<float>(M_PI) * screen_radius * screen_radius;
+            auto const wanted_triangles = screen_area / triangle_size;
+
+            size_t lod = 0;
+            while (use_lod && lod + 1 < lods.size() &&
+                   lods[lod + 1].num_indices / 3 >= wanted_triangles)
+            {
+                ++lod;
+            }
+
+            instance_positions.push_back(position);
+            instance_lods.push_back(lod);
+        }
+    }
+
+    for (size_t i = 0; i < lods.size(); ++i)
+    {
+        auto const count = std::count(instance_lods.begin(), instance_lods.end(), i);
+        Log::debug("LodScene: LOD %zu (%u triangles) used by %zu instances\n",
+                   i, lods[i].num_indices / 3, static_cast<size_t>(count));
+    }
+}
+
+void LodScene::setup_vertex_buffer()
+{
+    size_t vertex_data_size = 0;
+    for (auto const& lod_mesh : lod_meshes)
+        vertex_data_size += lod_mesh->vertex_data_size();
+
+    vertex_buffer = vkutil::create_device_local_buffer(
+        *vulkan, vertex_data_size, vk::BufferUsageFlagBits::eVertexBuffer,
+        [this] (void* data)
+        {
+            auto dst = static_cast<char*>(data);
+
+            for (auto const& lod_mesh : lod_meshes)
+            {
+                lod_mesh->copy_vertex_data_to(dst);
+                dst += lod_mesh->vertex_data_size();
+            }
+        });
+}
+
+void LodScene::setup_index_buffer()
+{
+    // All LODs share one index buffer, so use 32-bit indices throughout
+    size_t index_data_size = 0;
+    for (auto const& lod_mesh : lod_meshes)
+        index_data_size += lod_mesh->num_indices() * sizeof(uint32_t);
+
+    index_buffer = vkutil::create_device_local_buffer(
+        *vulkan, index_data_size, vk::BufferUsageFlagBits::eIndexBuffer,
+        [this] (void* data)
+        {
+            auto dst = static_cast<uint32_t*>(data);
+
+            for (auto const& lod_mesh : lod_meshes)
+                dst = std::copy(lod_mesh->index_list().begin(), lod_mesh->index_list().end(), dst);
+        });
+}
+
+void LodScene::setup_uniform_buffer()
+{
+    auto const alignment =
+        vulkan->physical_device().getProperties().limits.minUniformBufferOffsetAlignment;
+    uniforms_stride = (sizeof(Uniforms) + alignment - 1) / alignment * alignment;
+
+    auto const size = uniforms_stride * instance_positions.size();
+
+    uniform_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(size)
+        .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(uniform_buffer_memory)
+        .build();
+
+    uniform_buffer_map = vkutil::map_memory(*vulkan, uniform_buffer_memory, 0, size);
+}
+
+void LodScene::setup_uniform_descriptor_set()
+{
+    // Each instance selects its uniforms with a dynamic offset
+    descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eUniformBufferDynamic)
+        .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+        .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+        .set_layout_out(descriptor_set_layout)
+        .build();
+}
+
+void LodScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_depth_format(depth_format)
+        .set_samples(samples)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void LodScene::setup_pipeline()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_samples(samples)
+        .set_vertex_shader(Util::read_data_file("shaders/light-basic.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/light-basic.frag.spv"))
+        .set_vertex_input(lod_meshes[0]->binding_descriptions(),
+                          lod_meshes[0]->attribute_descriptions())
+        .set_depth_test(true)
+        .build();
+}
+
+void LodScene::setup_depth_image()
+{
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        depth_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::ImageAspectFlagBits::eDepth);
+}
+
+void LodScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void LodScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(framebuffers.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+    vk::DeviceSize const vertex_buffer_offset = 0;
+
+    for (size_t i = 0; i < command_buffers.size(); ++i)
+    {
+        auto const begin_info = vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eSimultaneousUse);
+
+        command_buffers[i].begin(begin_info);
+
+        std::array<vk::ClearValue, 2> clear_values{{
+            vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+            vk::ClearDepthStencilValue{1.0f, 0}}};
+
+        auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(render_pass)
+            .setFramebuffer(framebuffers[i])
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(clear_values.size())
+            .setPClearValues(clear_values.data());
+
+        command_buffers[i].beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+        command_buffers[i].bindVertexBuffers(0, vertex_buffer.raw, vertex_buffer_offset);
+        command_buffers[i].bindIndexBuffer(index_buffer, 0, vk::IndexType::eUint32);
+
+        for (size_t j = 0; j < instance_lods.size(); ++j)
+        {
+            auto const& lod = lods[instance_lods[j]];
+            uint32_t const uniforms_offset = j * uniforms_stride;
+
+            command_buffers[i].bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
+                descriptor_set.raw, uniforms_offset);
+            command_buffers[i].drawIndexed(
+                lod.num_indices, 1, lod.first_index, lod.vertex_offset, 0);
+        }
+
+        command_buffers[i].endRenderPass();
+        command_buffers[i].end();
+    }
+}
+
+void LodScene::update_uniforms()
+{
+    auto const uniforms = static_cast<char*>(uniform_buffer_map.raw);
+
+    for (size_t i = 0; i < instance_positions.size(); ++i)
+    {
+        Uniforms ubo;
+
+        auto modelview = glm::translate(view, instance_positions[i]);
+        modelview = glm::rotate(modelview, glm::radians(rotation + 45.0f * i),
+                                {0.0f, 1.0f, 0.0f});
+        modelview = glm::translate(modelview, -center);
+
+        ubo.modelviewprojection = projection * modelview;
+        ubo.normal = glm::inverseTranspose(modelview);
+        ubo.material_diffuse = glm::vec4{0.7f, 0.7f, 0.7f, 1.0};
+
+        memcpy(uniforms + i * uniforms_stride, &ubo, sizeof(ubo));
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "multisample_scene.h"
+
+#include "util.h"
+#include "vkutil/vkutil.h"
+
+MultisampleScene::MultisampleScene(std::string const& name)
+    : Scene{name},
+      samples{vk::SampleCountFlagBits::e1}
+{
+    options_["samples"] =
+        SceneOption("samples", "1",
+                    "The number of samples per pixel, for multisample antialiasing",
+                    "1,2,4,8");
+}
+
+void MultisampleScene::setup(
+    VulkanState& vulkan,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    Scene::setup(vulkan, vulkan_images);
+
+    samples = vkutil::find_sample_count(
+        vulkan, Util::from_string<uint32_t>(options_["samples"].value));
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "scene.h"
+
+#include <vulkan/vulkan.hpp>
+
+// Base for scenes that support multisample antialiasing, providing the
+// "samples" option and the sample count it resolves to during setup
+class MultisampleScene : public Scene
+{
+public:
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+
+protected:
+    MultisampleScene(std::string const& name);
+
+    vk::SampleCountFlagBits samples;
+};
@@ -0,0 +1,39 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Matches the layout of the Particle struct in particles.comp
+struct Particle
+{
+    float position[4];
+    float velocity[4];
+};
+
+// Matches the push constant block in particles.comp
+struct ParticlePushConstants
+{
+    uint32_t particle_count;
+    uint32_t steps;
+    float time_step;
+    float scale;
+    int32_t image_size[2];
+};
@@ -0,0 +1,527 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pipelines_scene.h"
+
+#include "mesh.h"
+#include "model.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 normal;
+    glm::vec4 material_diffuse;
+};
+
+size_t const max_pipelines = 1024;
+size_t const max_interval = 1000;
+// Variants cycle through the vertex layouts, then the blend states, then
+// the specialization constant values
+size_t const num_vertex_layouts = 2;
+size_t const num_blend_states = 3;
+
+std::shared_ptr<Mesh const> load_mesh(bool interleave)
+{
+    return Model::load_mesh(
+        "cube.3ds",
+        ModelAttribMap{}
+            .with_position(vk::Format::eR32G32B32Sfloat)
+            .with_normal(vk::Format::eR32G32B32Sfloat)
+            .with_interleave(interleave),
+        true);
+}
+
+double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0.0;
+
+    auto const nth = values.begin() + static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+}
+
+PipelinesScene::PipelinesScene() : MultisampleScene{"pipelines"}
+{
+    options_["pipelines"] =
+        SceneOption("pipelines", "64",
+                    "The number of pipeline variants created while rendering (1 to 1024)");
+    options_["interval"] =
+        SceneOption("interval", "10",
+                    "The number of frames between pipeline creations (1 to 1000)");
+    options_["cache"] =
+        SceneOption("cache", "false",
+                    "Whether to create the pipelines with a pipeline cache, "
+                    "warmed with all the variants during setup",
+                    "false,true");
+}
+
+PipelinesScene::~PipelinesScene() = default;
+
+void PipelinesScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    load_mesh(true);
+    load_mesh(false);
+    Util::read_data_file("shaders/light-basic.vert.spv");
+    Util::read_data_file("shaders/pipeline-variant.frag.spv");
+}
+
+void PipelinesScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    MultisampleScene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+
+    num_pipelines = Util::ranged_option_value<size_t>(
+        "pipelines", options_["pipelines"].value, 1, max_pipelines);
+    interval = Util::ranged_option_value<size_t>(
+        "interval", options_["interval"].value, 1, max_interval);
+    use_cache = options_["cache"].value == "true";
+
+    for (size_t i = 0; i < meshes.size(); ++i)
+        meshes[i] = load_mesh(i == 0);
+
+    // Read the shaders once, so that only creating the pipelines is measured
+    vertex_shader_spirv = Util::read_data_file("shaders/light-basic.vert.spv");
+    fragment_shader_spirv = Util::read_data_file("shaders/pipeline-variant.frag.spv");
+
+    setup_vertex_buffers();
+    setup_index_buffer();
+    setup_uniform_buffer();
+    setup_uniform_descriptor_set();
+    setup_render_pass();
+    setup_pipeline_layout();
+    setup_pipeline_cache();
+    setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
+    setup_framebuffers(vulkan_images);
+    setup_frames();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+
+    pipelines.reserve(num_pipelines);
+    create_times.clear();
+    frame_times.clear();
+}
+
+void PipelinesScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    for (auto const& frame : frames)
+    {
+        if (frame.fence)
+            vulkan->device().destroyFence(frame.fence);
+    }
+    frames.clear();
+    framebuffers.clear();
+    image_views.clear();
+    color_target = {};
+    depth_image_view = {};
+    depth_image = {};
+    pipelines.clear();
+    pipeline_cache = {};
+    pipeline_layout = {};
+    render_pass = {};
+    descriptor_set = {};
+    uniform_buffer_map = {};
+    uniform_buffer = {};
+    index_buffer = {};
+    vertex_buffers.clear();
+    fragment_shader_spirv.clear();
+    vertex_shader_spirv.clear();
+    for (auto& mesh : meshes)
+        mesh.reset();
+
+    Scene::teardown();
+}
+
+VulkanImage PipelinesScene::draw(VulkanImage const& image)
+{
+    auto& frame = frames[image.index];
+
+    if (!frame.fence)
+    {
+        frame.fence = vulkan->device().createFence(vk::FenceCreateInfo());
+    }
+    else
+    {
+        vulkan->device().waitForFences(frame.fence, true, INT64_MAX);
+        vulkan->device().resetFences(frame.fence);
+    }
+
+    // Create the next variant, which is drawn starting with this frame, so
+    // the frame time also includes any compilation deferred to first use
+    if (current_frame % interval == 0 && pipelines.size() < num_pipelines)
+    {
+        auto const before = Util::get_timestamp_us();
+        pipelines.push_back(create_pipeline(pipelines.size()));
+        create_times.push_back((Util::get_timestamp_us() - before) / 1000.0);
+    }
+
+    record_command_buffer(image.index);
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&frame.command_buffer)
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, frame.fence);
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void PipelinesScene::update()
+{
+    frame_times.push_back((Util::get_timestamp_us() - last_update_time) / 1000.0);
+
+    Scene::update();
+}
+
+std::string PipelinesScene::extra_results() const
+{
+    auto const create_time_avg = create_times.empty() ? 0.0 :
+        std::accumulate(create_times.begin(), create_times.end(), 0.0) / create_times.size();
+    auto const create_time_max = create_times.empty() ? 0.0 :
+        *std::max_element(create_times.begin(), create_times.end());
+    auto const frame_time_max = frame_times.empty() ? 0.0 :
+        *std::max_element(frame_times.begin(), frame_times.end());
+
+    std::stringstream ss;
+    ss << "Pipelines: " << create_times.size() << "/" << num_pipelines
+       << " Cache: " << (use_cache ? "true" : "false")
+       << std::fixed << std::setprecision(2)
+       << " Create: avg " << create_time_avg << " ms max " << create_time_max << " ms"
+       << " Frame time: median " << percentile(frame_times, 0.5)
+       << " ms p99 " << percentile(frame_times, 0.99)
+       << " ms max " << frame_time_max << " ms";
+    return ss.str();
+}
+
+void PipelinesScene::setup_vertex_buffers()
+{
+    for (auto const& mesh : meshes)
+    {
+        vertex_buffers.push_back(
+            vkutil::create_device_local_buffer(
+                *vulkan, mesh->vertex_data_size(), vk::BufferUsageFlagBits::eVertexBuffer,
+                [&mesh] (void* dst) { mesh->copy_vertex_data_to(dst); }));
+    }
+}
+
+void PipelinesScene::setup_index_buffer()
+{
+    // The meshes differ only in their vertex layout, so share the indices
+    index_buffer = vkutil::create_device_local_buffer(
+        *vulkan, meshes[0]->index_data_size(), vk::BufferUsageFlagBits::eIndexBuffer,
+        [this] (void* dst) { meshes[0]->copy_index_data_to(dst); });
+}
+
+void PipelinesScene::setup_uniform_buffer()
+{
+    auto const alignment =
+        vulkan->physical_device().getProperties().limits.minUniformBufferOffsetAlignment;
+    uniforms_stride = (sizeof(Uniforms) + alignment - 1) / alignment * alignment;
+
+    auto const size = uniforms_stride * num_pipelines;
+
+    uniform_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(size)
+        .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(uniform_buffer_memory)
+        .build();
+
+    uniform_buffer_map = vkutil::map_memory(*vulkan, uniform_buffer_memory, 0, size);
+
+    // Each variant draws an object in its own cell of a square grid of unit
+    // cells, appearing when the variant is created
+    auto const grid = static_cast<size_t>(std::ceil(std::sqrt(num_pipelines)));
+    auto const min_bound = meshes[0]->min_attribute_bound(0);
+    auto const max_bound = meshes[0]->max_attribute_bound(0);
+    auto const scale = 0.6f / glm::length(max_bound - min_bound);
+    auto const center = (max_bound + min_bound) / 2.0f;
+    auto const grid_center = (grid - 1) / 2.0f;
+
+    auto const radius = grid / 2.0f + 1.0f;
+    auto const aspect = static_cast<float>(extent.width) / extent.height;
+    auto const projection = glm::ortho(-radius * aspect, radius * aspect, -radius, radius,
+                                       -radius, radius);
+
+    auto const uniforms = static_cast<char*>(uniform_buffer_map.raw);
+
+    for (size_t i = 0; i < num_pipelines; ++i)
+    {
+        glm::vec3 const cell(i % grid, grid - 1 - i / grid, 0.0f);
+
+        glm::mat4 modelview{1.0};
+        modelview = glm::translate(modelview, cell - glm::vec3{grid_center, grid_center, 0.0f});
+        modelview = glm::rotate(modelview, glm::radians(30.0f), {1.0f, 1.0f, 0.0f});
+        modelview = glm::scale(modelview, glm::vec3{scale});
+        modelview = glm::translate(modelview, -center);
+
+        // Translucent, so that the blend state variants are visible
+        auto const hue = static_cast<float>(i) / num_pipelines * 6.2832f;
+
+        Uniforms ubo;
+
+        ubo.modelviewprojection = projection * modelview;
+        ubo.normal = glm::inverseTranspose(modelview);
+        ubo.material_diffuse = {0.6f + 0.4f * std::cos(hue),
+                                0.6f + 0.4f * std::cos(hue - 2.0944f),
+                                0.6f + 0.4f * std::cos(hue + 2.0944f),
+                                0.7f};
+
+        memcpy(uniforms + i * uniforms_stride, &ubo, sizeof(ubo));
+    }
+}
+
+void PipelinesScene::setup_uniform_descriptor_set()
+{
+    // Each variant selects the uniforms of its object with a dynamic offset
+    descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eUniformBufferDynamic)
+        .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+        .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+        .set_layout_out(descriptor_set_layout)
+        .build();
+}
+
+void PipelinesScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_depth_format(depth_format)
+        .set_samples(samples)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void PipelinesScene::setup_pipeline_layout()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+}
+
+void PipelinesScene::setup_pipeline_cache()
+{
+    if (!use_cache)
+        return;
+
+    pipeline_cache = ManagedResource<vk::PipelineCache>{
+        vulkan->device().createPipelineCache(vk::PipelineCacheCreateInfo{}),
+        [this] (auto const& pc) { vulkan->device().destroyPipelineCache(pc); }};
+
+    // Warm the cache with every variant, as if it had been loaded from a
+    // previous run
+    for (size_t i = 0; i < num_pipelines; ++i)
+        create_pipeline(i);
+}
+
+void PipelinesScene::setup_depth_image()
+{
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        depth_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::ImageAspectFlagBits::eDepth);
+}
+
+void PipelinesScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void PipelinesScene::setup_frames()
+{
+    frames.resize(framebuffers.size());
+
+    for (auto& frame : frames)
+    {
+        frame.command_pool = vkutil::create_command_pool(*vulkan);
+
+        auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+            .setCommandPool(frame.command_pool)
+            .setCommandBufferCount(1)
+            .setLevel(vk::CommandBufferLevel::ePrimary);
+
+        frame.command_buffer =
+            vulkan->device().allocateCommandBuffers(command_buffer_allocate_info)[0];
+    }
+}
+
+ManagedResource<vk::Pipeline> PipelinesScene::create_pipeline(size_t variant)
+{
+    auto const& mesh = meshes[variant % num_vertex_layouts];
+    auto const blend_state = variant / num_vertex_layouts % num_blend_states;
+    auto const iterations =
+        static_cast<uint32_t>(variant / (num_vertex_layouts * num_blend_states));
+
+    vkutil::PipelineBuilder builder{*vulkan};
+
+    builder
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_samples(samples)
+        .set_pipeline_cache(pipeline_cache)
+        .set_vertex_shader(vertex_shader_spirv)
+        .set_fragment_shader(fragment_shader_spirv)
+        .set_specialization_constants({iterations})
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .set_depth_test(true);
+
+    // Opaque, alpha blended or additive
+    if (blend_state == 1)
+    {
+        builder.set_blend(true);
+    }
+    else if (blend_state == 2)
+    {
+        builder
+            .set_blend(true)
+            .set_blend_factors(vk::BlendFactor::eOne, vk::BlendFactor::eOne,
+                               vk::BlendFactor::eOne, vk::BlendFactor::eZero);
+    }
+
+    return builder.build();
+}
+
+void PipelinesScene::record_command_buffer(size_t image_index)
+{
+    auto& frame = frames[image_index];
+    auto const command_buffer = frame.command_buffer;
+
+    vulkan->device().resetCommandPool(frame.command_pool, {});
+
+    auto const begin_info = vk::CommandBufferBeginInfo{}
+        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+    command_buffer.begin(begin_info);
+
+    std::array<vk::ClearValue, 2> clear_values{{
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+        vk::ClearDepthStencilValue{1.0f, 0}}};
+
+    auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+        .setRenderPass(render_pass)
+        .setFramebuffer(framebuffers[image_index])
+        .setRenderArea({{0,0}, extent})
+        .setClearValueCount(clear_values.size())
+        .setPClearValues(clear_values.data());
+
+    command_buffer.beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+    command_buffer.bindIndexBuffer(index_buffer, 0, meshes[0]->index_type());
+
+    auto const num_indices = static_cast<uint32_t>(meshes[0]->num_indices());
+
+    for (size_t i = 0; i < pipelines.size(); ++i)
+    {
+        auto const layout = i % num_vertex_layouts;
+        auto const binding_offsets = meshes[layout]->vertex_data_binding_offsets();
+        uint32_t const uniforms_offset = i * uniforms_stride;
+
+        command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipelines[i]);
+        command_buffer.bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
+            descriptor_set.raw, uniforms_offset);
+        command_buffer.bindVertexBuffers(
+            0,
+            std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffers[layout].raw},
+            binding_offsets);
+        command_buffer.drawIndexed(num_indices, 1, 0, 0, 0);
+    }
+
+    command_buffer.endRenderPass();
+    command_buffer.end();
+}
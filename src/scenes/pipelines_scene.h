@@ -0,0 +1,113 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "multisample_scene.h"
+#include "managed_resource.h"
+#include "vkutil/msaa_color_target.h"
+
+#include <array>
+#include <memory>
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+// Measures pipeline creation latency and the frame time spikes it causes,
+// by creating pipeline variants while rendering
+class PipelinesScene : public MultisampleScene
+{
+public:
+    PipelinesScene();
+    ~PipelinesScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+    void update() override;
+
+    std::string extra_results() const override;
+
+private:
+    // The command buffer used for a swapchain image, re-recorded every frame
+    struct Frame
+    {
+        ManagedResource<vk::CommandPool> command_pool;
+        vk::CommandBuffer command_buffer;
+        vk::Fence fence;
+    };
+
+    void setup_vertex_buffers();
+    void setup_index_buffer();
+    void setup_uniform_buffer();
+    void setup_uniform_descriptor_set();
+    void setup_render_pass();
+    void setup_pipeline_layout();
+    void setup_pipeline_cache();
+    void setup_depth_image();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_frames();
+    ManagedResource<vk::Pipeline> create_pipeline(size_t variant);
+    void record_command_buffer(size_t image_index);
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+    vk::Format depth_format;
+    size_t num_pipelines;
+    size_t interval;
+    bool use_cache;
+    vk::DeviceSize uniforms_stride;
+
+    // The same mesh with interleaved and separate vertex attributes, for
+    // variants with different vertex layouts
+    std::array<std::shared_ptr<Mesh const>, 2> meshes;
+    std::vector<char> vertex_shader_spirv;
+    std::vector<char> fragment_shader_spirv;
+
+    std::vector<ManagedResource<vk::Buffer>> vertex_buffers;
+    ManagedResource<vk::Buffer> index_buffer;
+    ManagedResource<vk::Buffer> uniform_buffer;
+    ManagedResource<void*> uniform_buffer_map;
+    ManagedResource<vk::DescriptorSet> descriptor_set;
+    ManagedResource<vk::RenderPass> render_pass;
+    ManagedResource<vk::PipelineLayout> pipeline_layout;
+    ManagedResource<vk::PipelineCache> pipeline_cache;
+    // The variants created so far, in order
+    std::vector<ManagedResource<vk::Pipeline>> pipelines;
+    vkutil::MsaaColorTarget color_target;
+    ManagedResource<vk::Image> depth_image;
+    ManagedResource<vk::ImageView> depth_image_view;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    std::vector<Frame> frames;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+
+    vk::DeviceMemory uniform_buffer_memory;
+    vk::DescriptorSetLayout descriptor_set_layout;
+
+    // In milliseconds
+    std::vector<double> create_times;
+    std::vector<double> frame_times;
+};
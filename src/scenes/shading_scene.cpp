@@ -22,6 +22,7 @@
 
 #include "shading_scene.h"
 
+#include "format_options.h"
 #include "mesh.h"
 #include "model.h"
 #include "util.h"
@@ -44,22 +45,64 @@ struct Uniforms
     glm::mat4 modelview;
 };
 
+std::shared_ptr<Mesh const> load_mesh(bool indexed, std::string const& vertex_format)
+{
+    auto const formats = position_normal_formats(vertex_format);
+
+    return Model::load_mesh(
+        "cat.3ds",
+        ModelAttribMap{}
+            .with_position(formats.first)
+            .with_normal(formats.second)
+            .with_interleave(true),
+        indexed);
 }
 
-ShadingScene::ShadingScene() : Scene{"shading"}
+std::pair<std::string, std::string> shader_files(std::string const& shading)
+{
+    if (shading == "blinn-phong-inf")
+        return {"shaders/light-advanced.vert.spv", "shaders/light-advanced.frag.spv"};
+    else if (shading == "phong")
+        return {"shaders/light-phong.vert.spv", "shaders/light-phong.frag.spv"};
+    else if (shading == "cel")
+        return {"shaders/light-phong.vert.spv", "shaders/light-cel.frag.spv"};
+    else
+        return {"shaders/light-basic.vert.spv", "shaders/light-basic.frag.spv"};
+}
+
+}
+
+ShadingScene::ShadingScene() : MultisampleScene{"shading"}
 {
     options_["shading"] =
         SceneOption("shading", "gouraud", "Which shading method to use",
                     "gouraud,blinn-phong-inf,phong,cel");
+    options_["indexed"] =
+        SceneOption("indexed", "false",
+                    "Whether to draw with an index buffer, sharing vertices between faces");
+    options_["vertex-format"] =
+        SceneOption("vertex-format", "float",
+                    "The vertex position and normal formats: 32-bit float, 16-bit float, "
+                    "or 16-bit float positions with 8-bit or packed 10-bit SNORM normals",
+                    "float,half,half-snorm8,half-snorm10");
 }
 
 ShadingScene::~ShadingScene() = default;
 
+void ShadingScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    auto const shaders = shader_files(options.at("shading").value);
+
+    load_mesh(options.at("indexed").value == "true", options.at("vertex-format").value);
+    Util::read_data_file(shaders.first);
+    Util::read_data_file(shaders.second);
+}
+
 void ShadingScene::setup(
     VulkanState& vulkan_,
     std::vector<VulkanImage> const& vulkan_images)
 {
-    Scene::setup(vulkan_, vulkan_images);
+    MultisampleScene::setup(vulkan_, vulkan_images);
 
     vulkan = &vulkan_;
     extent = vulkan_images[0].extent;
@@ -67,12 +110,7 @@ void ShadingScene::setup(
     depth_format = vk::Format::eD32Sfloat;
     aspect = static_cast<float>(extent.height) / extent.width;
 
-    mesh = Model{"cat.3ds"}.to_mesh(
-        ModelAttribMap{}
-            .with_position(vk::Format::eR32G32B32Sfloat)
-            .with_normal(vk::Format::eR32G32B32Sfloat));
-
-    mesh->set_interleave(true);
+    mesh = load_mesh(options_["indexed"].value == "true", options_["vertex-format"].value);
 
     // Model projection
     auto const min_bound = mesh->min_attribute_bound(0);
@@ -85,11 +123,13 @@ void ShadingScene::setup(
     projection = glm::perspective(fovy, aspect, 2.0f, 2.0f + diameter);
 
     setup_vertex_buffer();
+    setup_index_buffer();
     setup_uniform_buffer();
     setup_uniform_descriptor_set();
     setup_render_pass();
     setup_pipeline();
     setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
     setup_framebuffers(vulkan_images);
     setup_command_buffers();
 
@@ -105,6 +145,7 @@ void ShadingScene::teardown()
     vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
     framebuffers.clear();
     image_views.clear();
+    color_target = {};
     depth_image_view = {};
     depth_image = {};
     pipeline = {};
@@ -113,6 +154,7 @@ void ShadingScene::teardown()
     descriptor_set = {};
     uniform_buffer_map = {};
     uniform_buffer = {};
+    index_buffer = {};
     vertex_buffer = {};
 
     Scene::teardown();
@@ -148,35 +190,12 @@ void ShadingScene::update()
 
 void ShadingScene::setup_vertex_buffer()
 {
-    vk::DeviceMemory staging_buffer_memory;
-    vk::BufferUsageFlags staging_usage_flags =
-        vk::BufferUsageFlagBits::eVertexBuffer |
-        vk::BufferUsageFlagBits::eTransferSrc;
-
-    auto staging_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(staging_usage_flags)
-        .set_memory_properties(
-            vk::MemoryPropertyFlagBits::eHostVisible |
-            vk::MemoryPropertyFlagBits::eHostCoherent)
-        .set_memory_out(staging_buffer_memory)
-        .build();
-
-    {
-        auto const staging_buffer_map = vkutil::map_memory(
-            *vulkan, staging_buffer_memory, 0, mesh->vertex_data_size());
-        mesh->copy_vertex_data_to(staging_buffer_map);
-    }
-
-    vertex_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(
-            vk::BufferUsageFlagBits::eVertexBuffer |
-            vk::BufferUsageFlagBits::eTransferDst)
-        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
-        .build();
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
 
-    vkutil::copy_buffer(*vulkan, staging_buffer, vertex_buffer, mesh->vertex_data_size());
+void ShadingScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(*vulkan, *mesh);
 }
 
 void ShadingScene::setup_uniform_buffer()
@@ -211,6 +230,7 @@ void ShadingScene::setup_render_pass()
     render_pass = vkutil::RenderPassBuilder(*vulkan)
         .set_color_format(format)
         .set_depth_format(depth_format)
+        .set_samples(samples)
         .set_color_load_op(vk::AttachmentLoadOp::eClear)
         .build();
 }
@@ -224,34 +244,15 @@ void ShadingScene::setup_pipeline()
         vulkan->device().createPipelineLayout(pipeline_layout_create_info),
         [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
 
-    std::vector<char> vertex_shader;
-    std::vector<char> fragment_shader;
-
-    if (options_["shading"].value == "gouraud")
-    {
-        vertex_shader = Util::read_data_file("shaders/light-basic.vert.spv");
-        fragment_shader = Util::read_data_file("shaders/light-basic.frag.spv");
-    }
-    else if (options_["shading"].value == "blinn-phong-inf")
-    {
-        vertex_shader = Util::read_data_file("shaders/light-advanced.vert.spv");
-        fragment_shader = Util::read_data_file("shaders/light-advanced.frag.spv");
-    }
-    else if (options_["shading"].value == "phong")
-    {
-        vertex_shader = Util::read_data_file("shaders/light-phong.vert.spv");
-        fragment_shader = Util::read_data_file("shaders/light-phong.frag.spv");
-    }
-    else if (options_["shading"].value == "cel")
-    {
-        vertex_shader = Util::read_data_file("shaders/light-phong.vert.spv");
-        fragment_shader = Util::read_data_file("shaders/light-cel.frag.spv");
-    }
+    auto const shaders = shader_files(options_["shading"].value);
+    auto const vertex_shader = Util::read_data_file(shaders.first);
+    auto const fragment_shader = Util::read_data_file(shaders.second);
 
     pipeline = vkutil::PipelineBuilder(*vulkan)
         .set_extent(extent)
         .set_layout(pipeline_layout)
         .set_render_pass(render_pass)
+        .set_samples(samples)
         .set_vertex_shader(vertex_shader)
         .set_fragment_shader(fragment_shader)
         .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
@@ -264,6 +265,7 @@ void ShadingScene::setup_depth_image()
     depth_image = vkutil::ImageBuilder{*vulkan}
         .set_extent(extent)
         .set_format(depth_format)
+        .set_samples(samples)
         .set_tiling(vk::ImageTiling::eOptimal)
         .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
         .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
@@ -298,10 +300,14 @@ void ShadingScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_ima
 
     for (auto const& image_view : image_views)
     {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
         framebuffers.push_back(
             vkutil::FramebufferBuilder{*vulkan}
                 .set_render_pass(render_pass)
-                .set_image_views({image_view, depth_image_view})
+                .set_image_views(attachments)
                 .set_extent(extent)
                 .build());
     }
@@ -346,7 +352,15 @@ void ShadingScene::setup_command_buffers()
             binding_offsets
             );
 
-        command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+        if (mesh->num_indices() > 0)
+        {
+            command_buffers[i].bindIndexBuffer(index_buffer, 0, mesh->index_type());
+            command_buffers[i].drawIndexed(mesh->num_indices(), 1, 0, 0, 0);
+        }
+        else
+        {
+            command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+        }
 
         command_buffers[i].endRenderPass();
         command_buffers[i].end();
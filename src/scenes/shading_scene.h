@@ -22,8 +22,9 @@
 
 #pragma once
 
-#include "scene.h"
+#include "multisample_scene.h"
 #include "managed_resource.h"
+#include "vkutil/msaa_color_target.h"
 
 #include <memory>
 
@@ -33,12 +34,13 @@
 
 class Mesh;
 
-class ShadingScene : public Scene
+class ShadingScene : public MultisampleScene
 {
 public:
     ShadingScene();
     ~ShadingScene();
 
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
     void setup(VulkanState&, std::vector<VulkanImage> const&) override;
     void teardown() override;
 
@@ -47,6 +49,7 @@ public:
 
 private:
     void setup_vertex_buffer();
+    void setup_index_buffer();
     void setup_uniform_buffer();
     void setup_uniform_descriptor_set();
     void setup_render_pass();
@@ -65,15 +68,17 @@ private:
     glm::vec3 center;
     float radius;
 
-    std::unique_ptr<Mesh> mesh;
+    std::shared_ptr<Mesh const> mesh;
 
     ManagedResource<vk::Buffer> vertex_buffer;
+    ManagedResource<vk::Buffer> index_buffer;
     ManagedResource<vk::Buffer> uniform_buffer;
     ManagedResource<void*> uniform_buffer_map;
     ManagedResource<vk::DescriptorSet> descriptor_set;
     ManagedResource<vk::RenderPass> render_pass;
     ManagedResource<vk::PipelineLayout> pipeline_layout;
     ManagedResource<vk::Pipeline> pipeline;
+    vkutil::MsaaColorTarget color_target;
     ManagedResource<vk::Image> depth_image;
     ManagedResource<vk::ImageView> depth_image_view;
     std::vector<ManagedResource<vk::ImageView>> image_views;
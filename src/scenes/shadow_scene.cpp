@@ -0,0 +1,543 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shadow_scene.h"
+
+#include "mesh.h"
+#include "model.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+
+struct Uniforms
+{
+    glm::mat4 modelviewprojection;
+    glm::mat4 normal;
+    glm::mat4 light_modelviewprojection;
+    glm::mat4 shadow;
+    glm::vec4 material_diffuse;
+    glm::vec4 light_direction;
+    float shadow_texel_size;
+    int32_t pcf_radius;
+};
+
+std::unique_ptr<Mesh> load_mesh()
+{
+    // The loaded mesh is shared, so add to a copy
+    auto mesh = std::make_unique<Mesh>(
+        *Model::load_mesh(
+            "cat.3ds",
+            ModelAttribMap{}
+                .with_position(vk::Format::eR32G32B32Sfloat)
+                .with_normal(vk::Format::eR32G32B32Sfloat)
+                .with_interleave(true),
+            true));
+
+    // Add a floor for the model to cast its shadow on. Models are loaded with
+    // y flipped, so the floor lies at the maximum y and faces towards -y.
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    auto const center = (max_bound + min_bound) / 2.0f;
+    auto const size = 1.5f * glm::length(max_bound - min_bound) / 2.0f;
+    auto const first = static_cast<uint32_t>(mesh->num_vertices());
+
+    glm::vec3 const corners[] = {
+        {center.x - size, max_bound.y, center.z - size},
+        {center.x - size, max_bound.y, center.z + size},
+        {center.x + size, max_bound.y, center.z + size},
+        {center.x + size, max_bound.y, center.z - size}};
+
+    for (auto const& corner : corners)
+    {
+        mesh->next_vertex();
+        mesh->set_attribute(0, corner);
+        mesh->set_attribute(1, glm::vec3{0.0f, -1.0f, 0.0f});
+    }
+
+    for (auto const i : {0, 1, 2, 0, 2, 3})
+        mesh->add_index(first + i);
+
+    return mesh;
+}
+
+uint32_t shadow_size_option_value(VulkanState& vulkan, std::string const& value)
+{
+    auto const size = Util::from_string<uint32_t>(value);
+    auto const& limits = vulkan.physical_device().getProperties().limits;
+
+    if (size > limits.maxImageDimension2D || size > limits.maxFramebufferWidth ||
+        size > limits.maxFramebufferHeight)
+    {
+        throw std::runtime_error(
+            "\"shadow-size\" option value " + value + " exceeds the device limits");
+    }
+
+    return size;
+}
+
+}
+
+ShadowScene::ShadowScene() : MultisampleScene{"shadow"}
+{
+    options_["shadow-size"] =
+        SceneOption("shadow-size", "2048",
+                    "The width and height of the shadow map in texels",
+                    "256,512,1024,2048,4096,8192");
+    options_["pcf"] =
+        SceneOption("pcf", "3",
+                    "The width of the percentage closer filtering kernel in texels",
+                    "1,3,5,7");
+}
+
+ShadowScene::~ShadowScene() = default;
+
+void ShadowScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    load_mesh();
+    Util::read_data_file("shaders/shadow-depth.vert.spv");
+    Util::read_data_file("shaders/shadow.vert.spv");
+    Util::read_data_file("shaders/shadow.frag.spv");
+}
+
+void ShadowScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    MultisampleScene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+
+    auto const shadow_size =
+        shadow_size_option_value(*vulkan, options_["shadow-size"].value);
+    shadow_extent = vk::Extent2D{shadow_size, shadow_size};
+    pcf_radius = (Util::from_string<int32_t>(options_["pcf"].value) - 1) / 2;
+
+    mesh = load_mesh();
+
+    // Scene projection, covering the model and the floor
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    auto const diameter = glm::length(max_bound - min_bound);
+    auto const aspect = static_cast<float>(extent.width)/static_cast<float>(extent.height);
+    center = (max_bound + min_bound) / 2.0f;
+    radius = diameter / 2.0f;
+    auto const fovy = 2.0f * atanf(radius / (2.0f + radius));
+    projection = glm::perspective(fovy, aspect, 2.0f, 2.0f + diameter);
+
+    setup_vertex_buffer();
+    setup_index_buffer();
+    setup_uniform_buffer();
+    setup_shadow_map();
+    setup_uniform_descriptor_set();
+    setup_render_passes();
+    setup_pipelines();
+    setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    light_angle = 0.0f;
+}
+
+void ShadowScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
+    framebuffers.clear();
+    image_views.clear();
+    depth_image_view = {};
+    depth_image = {};
+    color_target = {};
+    shadow_framebuffer = {};
+    pipeline = {};
+    shadow_pipeline = {};
+    pipeline_layout = {};
+    render_pass = {};
+    shadow_render_pass = {};
+    descriptor_set = {};
+    shadow_sampler = {};
+    shadow_image_view = {};
+    shadow_image = {};
+    uniform_buffer_map = {};
+    uniform_buffer = {};
+    index_buffer = {};
+    vertex_buffer = {};
+
+    Scene::teardown();
+}
+
+VulkanImage ShadowScene::draw(VulkanImage const& image)
+{
+    update_uniforms();
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&command_buffers[image.index])
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, {});
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void ShadowScene::update()
+{
+    auto const t = (Util::get_timestamp_us() - start_time) / 1000000.0f;
+
+    // The light circles the model, so the shadow changes every frame
+    light_angle = 36.0f * t;
+
+    Scene::update();
+}
+
+void ShadowScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
+
+void ShadowScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(*vulkan, *mesh);
+}
+
+void ShadowScene::setup_uniform_buffer()
+{
+    uniform_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(sizeof(Uniforms))
+        .set_usage(vk::BufferUsageFlagBits::eUniformBuffer)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(uniform_buffer_memory)
+        .build();
+
+    uniform_buffer_map = vkutil::map_memory(
+        *vulkan, uniform_buffer_memory, 0, sizeof(Uniforms));
+}
+
+void ShadowScene::setup_shadow_map()
+{
+    shadow_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(shadow_extent)
+        .set_format(depth_format)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment |
+                   vk::ImageUsageFlagBits::eSampled)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    shadow_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(shadow_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    // Filter the depth comparison results in hardware when possible, which
+    // smooths the shadow edges on top of the PCF kernel
+    auto const format_props = vulkan->physical_device().getFormatProperties(depth_format);
+    auto const filter =
+        (format_props.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImageFilterLinear) ?
+        vk::Filter::eLinear : vk::Filter::eNearest;
+
+    // Everything outside the shadow map is lit
+    auto const sampler_create_info = vk::SamplerCreateInfo{}
+        .setMagFilter(filter)
+        .setMinFilter(filter)
+        .setAddressModeU(vk::SamplerAddressMode::eClampToBorder)
+        .setAddressModeV(vk::SamplerAddressMode::eClampToBorder)
+        .setAddressModeW(vk::SamplerAddressMode::eClampToBorder)
+        .setBorderColor(vk::BorderColor::eFloatOpaqueWhite)
+        .setAnisotropyEnable(false)
+        .setUnnormalizedCoordinates(false)
+        .setCompareEnable(true)
+        .setCompareOp(vk::CompareOp::eLessOrEqual)
+        .setMinLod(0.0f)
+        .setMaxLod(0.25f)
+        .setMipmapMode(vk::SamplerMipmapMode::eNearest);
+
+    shadow_sampler = ManagedResource<vk::Sampler>{
+        vulkan->device().createSampler(sampler_create_info),
+        [this] (auto const& s) { vulkan->device().destroySampler(s); }};
+}
+
+void ShadowScene::setup_uniform_descriptor_set()
+{
+    descriptor_set = vkutil::DescriptorSetBuilder{*vulkan}
+        .set_type(vk::DescriptorType::eUniformBuffer)
+        .set_stage_flags(vk::ShaderStageFlagBits::eVertex |
+                         vk::ShaderStageFlagBits::eFragment)
+        .set_buffer(uniform_buffer, 0, sizeof(Uniforms))
+        .next_binding()
+        .set_type(vk::DescriptorType::eCombinedImageSampler)
+        .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+        .set_image_view(shadow_image_view, shadow_sampler)
+        .set_layout_out(descriptor_set_layout)
+        .build();
+}
+
+void ShadowScene::setup_render_passes()
+{
+    shadow_render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_depth_format(depth_format)
+        .build();
+
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_depth_format(depth_format)
+        .set_samples(samples)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void ShadowScene::setup_pipelines()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    // The depth bias keeps surfaces facing the light from shadowing themselves
+    shadow_pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(shadow_extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(shadow_render_pass)
+        .set_vertex_shader(Util::read_data_file("shaders/shadow-depth.vert.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .set_depth_test(true)
+        .set_depth_bias(1.25f, 1.75f)
+        .build();
+
+    pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_samples(samples)
+        .set_vertex_shader(Util::read_data_file("shaders/shadow.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/shadow.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .set_depth_test(true)
+        .build();
+}
+
+void ShadowScene::setup_depth_image()
+{
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        depth_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::ImageAspectFlagBits::eDepth);
+}
+
+void ShadowScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    shadow_framebuffer = vkutil::FramebufferBuilder{*vulkan}
+        .set_render_pass(shadow_render_pass)
+        .set_image_views({shadow_image_view})
+        .set_extent(shadow_extent)
+        .build();
+
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void ShadowScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(framebuffers.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+
+    // Make the shadow map depth writes visible to the lit pass, transitioning
+    // the shadow map to a layout suitable for sampling
+    auto const shadow_barrier = vk::ImageMemoryBarrier{}
+        .setImage(shadow_image)
+        .setOldLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal)
+        .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setSrcAccessMask(vk::AccessFlagBits::eDepthStencilAttachmentWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setSubresourceRange(
+            vk::ImageSubresourceRange{}
+                .setAspectMask(vk::ImageAspectFlagBits::eDepth)
+                .setBaseMipLevel(0)
+                .setLevelCount(1)
+                .setBaseArrayLayer(0)
+                .setLayerCount(1));
+
+    for (size_t i = 0; i < command_buffers.size(); ++i)
+    {
+        auto const begin_info = vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eSimultaneousUse);
+
+        command_buffers[i].begin(begin_info);
+
+        command_buffers[i].bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, descriptor_set.raw, {});
+        command_buffers[i].bindVertexBuffers(
+            0,
+            std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+            binding_offsets
+            );
+        command_buffers[i].bindIndexBuffer(index_buffer, 0, mesh->index_type());
+
+        // Render the depth of the scene from the light into the shadow map
+        vk::ClearValue const shadow_clear_value = vk::ClearDepthStencilValue{1.0f, 0};
+
+        auto const shadow_render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(shadow_render_pass)
+            .setFramebuffer(shadow_framebuffer)
+            .setRenderArea({{0,0}, shadow_extent})
+            .setClearValueCount(1)
+            .setPClearValues(&shadow_clear_value);
+
+        command_buffers[i].beginRenderPass(shadow_render_pass_begin_info, vk::SubpassContents::eInline);
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, shadow_pipeline);
+        command_buffers[i].drawIndexed(mesh->num_indices(), 1, 0, 0, 0);
+        command_buffers[i].endRenderPass();
+
+        command_buffers[i].pipelineBarrier(
+            vk::PipelineStageFlagBits::eLateFragmentTests,
+            vk::PipelineStageFlagBits::eFragmentShader,
+            {}, {}, {}, shadow_barrier);
+
+        // Render the lit scene, sampling the shadow map
+        std::array<vk::ClearValue, 2> clear_values{{
+            vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+            vk::ClearDepthStencilValue{1.0f, 0}}};
+
+        auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(render_pass)
+            .setFramebuffer(framebuffers[i])
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(clear_values.size())
+            .setPClearValues(clear_values.data());
+
+        command_buffers[i].beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+        command_buffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+        command_buffers[i].drawIndexed(mesh->num_indices(), 1, 0, 0, 0);
+        command_buffers[i].endRenderPass();
+
+        command_buffers[i].end();
+    }
+}
+
+void ShadowScene::update_uniforms()
+{
+    Uniforms ubo;
+
+    // Models are loaded with y flipped, so -y points up
+    auto const angle = glm::radians(light_angle);
+    auto const light_direction =
+        glm::normalize(glm::vec3{cosf(angle), -1.5f, sinf(angle)});
+
+    // Orthographic projection of the whole scene along the light direction
+    auto const light_view = glm::lookAt(
+        center + radius * light_direction, center, glm::vec3{0.0f, 0.0f, 1.0f});
+    auto const light_projection =
+        glm::ortho(-radius, radius, -radius, radius, 0.0f, 2.0f * radius);
+    auto const light_modelviewprojection = light_projection * light_view;
+
+    // Map light clip coordinates to shadow map texture coordinates
+    glm::mat4 shadow{1.0};
+    shadow = glm::translate(shadow, glm::vec3{0.5f, 0.5f, 0.0f});
+    shadow = glm::scale(shadow, glm::vec3{0.5f, 0.5f, 1.0f});
+
+    glm::mat4 modelview{1.0};
+    modelview = glm::translate(modelview, glm::vec3{0.0f, 0.0f, -(2.0f + radius)});
+    // Tilt the scene towards the viewer, so that the floor is visible
+    modelview = glm::rotate(modelview, glm::radians(-25.0f), {1.0f, 0.0f, 0.0f});
+    modelview = glm::translate(modelview, -center);
+
+    ubo.modelviewprojection = projection * modelview;
+    ubo.normal = glm::inverseTranspose(modelview);
+    ubo.light_modelviewprojection = light_modelviewprojection;
+    ubo.shadow = shadow * light_modelviewprojection;
+    ubo.material_diffuse = glm::vec4{0.7f, 0.7f, 0.7f, 1.0};
+    ubo.light_direction =
+        glm::vec4{glm::normalize(glm::mat3{modelview} * light_direction), 0.0f};
+    ubo.shadow_texel_size = 1.0f / shadow_extent.width;
+    ubo.pcf_radius = pcf_radius;
+
+    memcpy(uniform_buffer_map, &ubo, sizeof(ubo));
+}
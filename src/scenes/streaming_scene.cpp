@@ -0,0 +1,586 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "streaming_scene.h"
+
+#include "mesh.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+uint32_t const max_textures = 64;
+
+// A quad for each texture, arranged in a grid covering the screen
+std::unique_ptr<Mesh> create_tiles_mesh(size_t num_tiles)
+{
+    auto mesh = std::make_unique<Mesh>(
+        std::vector<vk::Format>{vk::Format::eR32G32Sfloat, vk::Format::eR32G32Sfloat});
+
+    auto const columns = static_cast<size_t>(std::ceil(std::sqrt(num_tiles)));
+    auto const rows = (num_tiles + columns - 1) / columns;
+    auto const tile_width = 2.0f / columns;
+    auto const tile_height = 2.0f / rows;
+
+    for (size_t i = 0; i < num_tiles; ++i)
+    {
+        auto const x0 = -1.0f + (i % columns) * tile_width;
+        auto const y0 = -1.0f + (i / columns) * tile_height;
+        auto const x1 = x0 + tile_width;
+        auto const y1 = y0 + tile_height;
+
+        mesh->next_vertex();
+        mesh->set_attribute(0, {x0, y0});
+        mesh->set_attribute(1, {0, 0});
+        mesh->next_vertex();
+        mesh->set_attribute(0, {x0, y1});
+        mesh->set_attribute(1, {0, 1});
+        mesh->next_vertex();
+        mesh->set_attribute(0, {x1, y1});
+        mesh->set_attribute(1, {1, 1});
+
+        mesh->next_vertex();
+        mesh->set_attribute(0, {x0, y0});
+        mesh->set_attribute(1, {0, 0});
+        mesh->next_vertex();
+        mesh->set_attribute(0, {x1, y1});
+        mesh->set_attribute(1, {1, 1});
+        mesh->next_vertex();
+        mesh->set_attribute(0, {x1, y0});
+        mesh->set_attribute(1, {1, 0});
+    }
+
+    mesh->set_interleave(true);
+
+    return mesh;
+}
+
+vk::ImageSubresourceRange color_subresource_range()
+{
+    return vk::ImageSubresourceRange{}
+        .setAspectMask(vk::ImageAspectFlagBits::eColor)
+        .setBaseMipLevel(0)
+        .setLevelCount(1)
+        .setBaseArrayLayer(0)
+        .setLayerCount(1);
+}
+
+}
+
+StreamingScene::StreamingScene() : Scene{"streaming"}
+{
+    options_["upload"] =
+        SceneOption("upload", "staging",
+                    "How new texture content reaches the GPU: copied from a staging "
+                    "buffer to optimal tiling images, or written directly to "
+                    "host-visible linear tiling images",
+                    "staging,linear");
+    options_["texture-size"] =
+        SceneOption("texture-size", "1024",
+                    "The width and height of each texture in texels",
+                    "256,512,1024,2048,4096");
+    options_["textures"] =
+        SceneOption("textures", "4",
+                    "The number of textures updated every frame (1 to 64)");
+}
+
+StreamingScene::~StreamingScene() = default;
+
+void StreamingScene::prefetch(std::unordered_map<std::string, SceneOption> const&) const
+{
+    Util::read_data_file("shaders/effect2d.vert.spv");
+    Util::read_data_file("shaders/texture-view.frag.spv");
+}
+
+void StreamingScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    Scene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    texture_format = vk::Format::eR8G8B8A8Unorm;
+
+    auto const size = Util::from_string<uint32_t>(options_["texture-size"].value);
+    texture_extent = vk::Extent2D{size, size};
+    texture_size = static_cast<vk::DeviceSize>(size) * size * sizeof(uint32_t);
+    num_textures = Util::ranged_option_value<uint32_t>(
+        "textures", options_["textures"].value, 1, max_textures);
+    use_staging = options_["upload"].value == "staging";
+
+    auto const format_props = vulkan->physical_device().getFormatProperties(texture_format);
+    auto const tiling_features = use_staging ?
+        format_props.optimalTilingFeatures : format_props.linearTilingFeatures;
+    auto const required_features =
+        vk::FormatFeatureFlagBits::eSampledImage |
+        vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+
+    if ((tiling_features & required_features) != required_features)
+    {
+        throw std::runtime_error{"Format " + vk::to_string(texture_format) +
+                                 " is not supported for filtered sampling with " +
+                                 (use_staging ? "optimal" : "linear") +
+                                 " tiling by the device"};
+    }
+
+    mesh = create_tiles_mesh(num_textures);
+
+    setup_source_data();
+    setup_vertex_buffer();
+    setup_textures();
+    setup_sampler();
+    setup_frames(vulkan_images.size());
+    setup_render_pass();
+    setup_pipeline();
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    upload_count = 0;
+}
+
+void StreamingScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    for (auto const& frame : frames)
+    {
+        vulkan->device().freeCommandBuffers(vulkan->command_pool(), frame.command_buffer);
+        vulkan->device().destroyFence(frame.fence);
+    }
+    framebuffers.clear();
+    image_views.clear();
+    pipeline = {};
+    pipeline_layout = {};
+    render_pass = {};
+    frames.clear();
+    sampler = {};
+    texture_views.clear();
+    textures.clear();
+    vertex_buffer = {};
+    source_data.clear();
+    mesh.reset();
+
+    Scene::teardown();
+}
+
+VulkanImage StreamingScene::draw(VulkanImage const& image)
+{
+    auto& frame = frames[image.index];
+
+    // Wait until the previous use of the frame's upload resources completes,
+    // so that they can be overwritten
+    vulkan->device().waitForFences(frame.fence, true, INT64_MAX);
+    vulkan->device().resetFences(frame.fence);
+
+    upload_textures(frame);
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&frame.command_buffer)
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, frame.fence);
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+std::string StreamingScene::extra_results() const
+{
+    std::stringstream ss;
+    ss << "Textures: " << num_textures << " Upload: " << std::fixed << std::setprecision(2)
+       << static_cast<double>(texture_size) * num_textures * average_fps() / 1000000.0
+       << " MB/s";
+    return ss.str();
+}
+
+void StreamingScene::setup_source_data()
+{
+    auto const width = texture_extent.width;
+    auto const height = texture_extent.height;
+
+    source_data.resize(width * height);
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            uint32_t const r = (x ^ y) & 0xff;
+            uint32_t const g = (x * 255 / width) & 0xff;
+            uint32_t const b = (y * 255 / height) & 0xff;
+            source_data[y * width + x] = 0xff000000 | (b << 16) | (g << 8) | r;
+        }
+    }
+}
+
+void StreamingScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
+
+void StreamingScene::setup_textures()
+{
+    // With linear images, each frame has its own textures
+    if (!use_staging)
+        return;
+
+    for (size_t i = 0; i < num_textures; ++i)
+    {
+        textures.push_back(
+            vkutil::ImageBuilder{*vulkan}
+                .set_extent(texture_extent)
+                .set_format(texture_format)
+                .set_tiling(vk::ImageTiling::eOptimal)
+                .set_usage(
+                    vk::ImageUsageFlagBits::eTransferDst |
+                    vk::ImageUsageFlagBits::eSampled)
+                .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+                .set_initial_layout(vk::ImageLayout::eUndefined)
+                .build());
+
+        texture_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(textures.back())
+                .set_format(texture_format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+}
+
+void StreamingScene::setup_sampler()
+{
+    auto const sampler_create_info = vk::SamplerCreateInfo{}
+        .setMagFilter(vk::Filter::eLinear)
+        .setMinFilter(vk::Filter::eLinear)
+        .setAddressModeU(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeV(vk::SamplerAddressMode::eClampToEdge)
+        .setAddressModeW(vk::SamplerAddressMode::eClampToEdge)
+        .setAnisotropyEnable(false)
+        .setUnnormalizedCoordinates(false)
+        .setCompareEnable(false)
+        .setMinLod(0.0f)
+        .setMaxLod(0.25f)
+        .setMipmapMode(vk::SamplerMipmapMode::eNearest);
+
+    sampler = ManagedResource<vk::Sampler>{
+        vulkan->device().createSampler(sampler_create_info),
+        [this] (auto const& s) { vulkan->device().destroySampler(s); }};
+}
+
+void StreamingScene::setup_frames(size_t num_frames)
+{
+    frames.resize(num_frames);
+
+    for (auto& frame : frames)
+    {
+        // Signaled, so that the first wait for each frame doesn't block
+        frame.fence = vulkan->device().createFence(
+            vk::FenceCreateInfo{}.setFlags(vk::FenceCreateFlagBits::eSignaled));
+
+        if (use_staging)
+        {
+            vk::DeviceMemory staging_buffer_memory;
+
+            frame.staging_buffer = vkutil::BufferBuilder{*vulkan}
+                .set_size(texture_size * num_textures)
+                .set_usage(vk::BufferUsageFlagBits::eTransferSrc)
+                .set_memory_properties(
+                    vk::MemoryPropertyFlagBits::eHostVisible |
+                    vk::MemoryPropertyFlagBits::eHostCoherent)
+                .set_memory_out(staging_buffer_memory)
+                .build();
+
+            frame.staging_buffer_map = vkutil::map_memory(
+                *vulkan, staging_buffer_memory, 0, texture_size * num_textures);
+        }
+        else
+        {
+            for (size_t i = 0; i < num_textures; ++i)
+            {
+                vk::DeviceMemory image_memory;
+
+                frame.linear_images.push_back(
+                    vkutil::ImageBuilder{*vulkan}
+                        .set_extent(texture_extent)
+                        .set_format(texture_format)
+                        .set_tiling(vk::ImageTiling::eLinear)
+                        .set_usage(vk::ImageUsageFlagBits::eSampled)
+                        .set_memory_properties(
+                            vk::MemoryPropertyFlagBits::eHostVisible |
+                            vk::MemoryPropertyFlagBits::eHostCoherent)
+                        .set_initial_layout(vk::ImageLayout::ePreinitialized)
+                        .set_memory_out(image_memory)
+                        .build());
+
+                // The general layout allows both host writes and sampling,
+                // so the images never change layout after this
+                vkutil::transition_image_layout(
+                    *vulkan,
+                    frame.linear_images.back(),
+                    vk::ImageLayout::ePreinitialized,
+                    vk::ImageLayout::eGeneral,
+                    vk::ImageAspectFlagBits::eColor);
+
+                frame.linear_image_views.push_back(
+                    vkutil::ImageViewBuilder{*vulkan}
+                        .set_image(frame.linear_images.back())
+                        .set_format(texture_format)
+                        .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                        .build());
+
+                frame.linear_image_maps.push_back(
+                    vkutil::map_memory(*vulkan, image_memory, 0, VK_WHOLE_SIZE));
+            }
+
+            // All images are created alike, so they share the same layout
+            linear_layout = vulkan->device().getImageSubresourceLayout(
+                frame.linear_images[0],
+                vk::ImageSubresource{}.setAspectMask(vk::ImageAspectFlagBits::eColor));
+        }
+
+        auto& views = use_staging ? texture_views : frame.linear_image_views;
+
+        for (auto& view : views)
+        {
+            frame.descriptor_sets.push_back(
+                vkutil::DescriptorSetBuilder{*vulkan}
+                    .set_type(vk::DescriptorType::eCombinedImageSampler)
+                    .set_stage_flags(vk::ShaderStageFlagBits::eFragment)
+                    .set_image_view(view, sampler)
+                    .set_layout_out(descriptor_set_layout)
+                    .build());
+        }
+    }
+}
+
+void StreamingScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void StreamingScene::setup_pipeline()
+{
+    auto const pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{}
+        .setSetLayoutCount(1)
+        .setPSetLayouts(&descriptor_set_layout);
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    pipeline = vkutil::PipelineBuilder{*vulkan}
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_vertex_shader(Util::read_data_file("shaders/effect2d.vert.spv"))
+        .set_fragment_shader(Util::read_data_file("shaders/texture-view.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .build();
+}
+
+void StreamingScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views({image_view})
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void StreamingScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(frames.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    auto const command_buffers =
+        vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+
+    // The textures are shared by all frames. Their previous content is
+    // discarded, but the previous frame has to finish sampling them first.
+    std::vector<vk::ImageMemoryBarrier> upload_barriers;
+    std::vector<vk::ImageMemoryBarrier> sample_barriers;
+
+    for (auto const& texture : textures)
+    {
+        upload_barriers.push_back(
+            vk::ImageMemoryBarrier{}
+                .setImage(texture)
+                .setOldLayout(vk::ImageLayout::eUndefined)
+                .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+                .setSrcAccessMask({})
+                .setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
+                .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setSubresourceRange(color_subresource_range()));
+
+        sample_barriers.push_back(
+            vk::ImageMemoryBarrier{}
+                .setImage(texture)
+                .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+                .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+                .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+                .setDstAccessMask(vk::AccessFlagBits::eShaderRead)
+                .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setSubresourceRange(color_subresource_range()));
+    }
+
+    vk::ClearValue const clear_value{
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}}};
+
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        auto& frame = frames[i];
+        frame.command_buffer = command_buffers[i];
+
+        frame.command_buffer.begin(vk::CommandBufferBeginInfo{});
+
+        // Linear images are written by the host before submission, which
+        // makes the writes visible to the device without a barrier
+        if (use_staging)
+        {
+            frame.command_buffer.pipelineBarrier(
+                vk::PipelineStageFlagBits::eFragmentShader,
+                vk::PipelineStageFlagBits::eTransfer,
+                {}, {}, {}, upload_barriers);
+
+            for (size_t t = 0; t < textures.size(); ++t)
+            {
+                auto const region = vk::BufferImageCopy{}
+                    .setBufferOffset(t * texture_size)
+                    .setImageSubresource(
+                        vk::ImageSubresourceLayers{}
+                            .setAspectMask(vk::ImageAspectFlagBits::eColor)
+                            .setMipLevel(0)
+                            .setBaseArrayLayer(0)
+                            .setLayerCount(1))
+                    .setImageExtent({texture_extent.width, texture_extent.height, 1});
+
+                frame.command_buffer.copyBufferToImage(
+                    frame.staging_buffer, textures[t],
+                    vk::ImageLayout::eTransferDstOptimal, region);
+            }
+
+            frame.command_buffer.pipelineBarrier(
+                vk::PipelineStageFlagBits::eTransfer,
+                vk::PipelineStageFlagBits::eFragmentShader,
+                {}, {}, {}, sample_barriers);
+        }
+
+        auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(render_pass)
+            .setFramebuffer(framebuffers[i])
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(1)
+            .setPClearValues(&clear_value);
+
+        frame.command_buffer.beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+        frame.command_buffer.bindVertexBuffers(
+            0,
+            std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+            binding_offsets);
+        frame.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+
+        for (size_t t = 0; t < num_textures; ++t)
+        {
+            frame.command_buffer.bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
+                frame.descriptor_sets[t].raw, {});
+            frame.command_buffer.draw(6, 1, 6 * t, 0);
+        }
+
+        frame.command_buffer.endRenderPass();
+        frame.command_buffer.end();
+    }
+}
+
+void StreamingScene::upload_textures(Frame& frame)
+{
+    auto const width = texture_extent.width;
+    auto const height = texture_extent.height;
+    auto const row_size = width * sizeof(uint32_t);
+
+    for (size_t t = 0; t < num_textures; ++t)
+    {
+        // Scroll the content by one row every frame, with each texture
+        // showing a different part of it
+        auto const first_row = (upload_count + t * height / num_textures) % height;
+        auto const src = reinterpret_cast<char const*>(source_data.data());
+
+        if (use_staging)
+        {
+            auto const dst = static_cast<char*>(frame.staging_buffer_map.raw) + t * texture_size;
+            auto const first_part_size = (height - first_row) * row_size;
+
+            memcpy(dst, src + first_row * row_size, first_part_size);
+            memcpy(dst + first_part_size, src, first_row * row_size);
+        }
+        else
+        {
+            auto const dst = static_cast<char*>(frame.linear_image_maps[t].raw) +
+                             linear_layout.offset;
+
+            for (uint32_t y = 0; y < height; ++y)
+            {
+                memcpy(dst + y * linear_layout.rowPitch,
+                       src + ((first_row + y) % height) * row_size,
+                       row_size);
+            }
+        }
+    }
+
+    ++upload_count;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "scene.h"
+#include "managed_resource.h"
+
+#include <memory>
+
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+// Measures texture upload throughput by writing new content to a number of
+// textures every frame, and drawing them in the same frame
+class StreamingScene : public Scene
+{
+public:
+    StreamingScene();
+    ~StreamingScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+
+    std::string extra_results() const override;
+
+private:
+    // The resources written by the host for a swapchain image, which can
+    // only be reused after the frame using them has completed
+    struct Frame
+    {
+        vk::CommandBuffer command_buffer;
+        vk::Fence fence;
+        ManagedResource<vk::Buffer> staging_buffer;
+        ManagedResource<void*> staging_buffer_map;
+        std::vector<ManagedResource<vk::Image>> linear_images;
+        std::vector<ManagedResource<vk::ImageView>> linear_image_views;
+        std::vector<ManagedResource<void*>> linear_image_maps;
+        std::vector<ManagedResource<vk::DescriptorSet>> descriptor_sets;
+    };
+
+    void setup_source_data();
+    void setup_vertex_buffer();
+    void setup_textures();
+    void setup_sampler();
+    void setup_frames(size_t num_frames);
+    void setup_render_pass();
+    void setup_pipeline();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_command_buffers();
+    void upload_textures(Frame& frame);
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+    vk::Format texture_format;
+    vk::Extent2D texture_extent;
+    size_t num_textures;
+    bool use_staging;
+    vk::DeviceSize texture_size;
+    vk::SubresourceLayout linear_layout;
+    uint32_t upload_count;
+
+    std::unique_ptr<Mesh> mesh;
+    // The content of the textures, scrolled by one row every frame
+    std::vector<uint32_t> source_data;
+
+    ManagedResource<vk::Buffer> vertex_buffer;
+    std::vector<ManagedResource<vk::Image>> textures;
+    std::vector<ManagedResource<vk::ImageView>> texture_views;
+    ManagedResource<vk::Sampler> sampler;
+    std::vector<Frame> frames;
+    ManagedResource<vk::RenderPass> render_pass;
+    ManagedResource<vk::PipelineLayout> pipeline_layout;
+    ManagedResource<vk::Pipeline> pipeline;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+
+    vk::DescriptorSetLayout descriptor_set_layout;
+};
@@ -43,24 +43,99 @@ struct Uniforms
     glm::vec4 material_diffuse;
 };
 
+struct CompressedTextureFile
+{
+    char const* name;
+    vk::Format format;
+};
+
+// In order of preference for texture-format=auto
+std::array<CompressedTextureFile, 4> const compressed_texture_files{{
+    {"bc7", vk::Format::eBc7SrgbBlock},
+    {"astc", vk::Format::eAstc4x4SrgbBlock},
+    {"etc2", vk::Format::eEtc2R8G8B8SrgbBlock},
+    {"bc1", vk::Format::eBc1RgbSrgbBlock}}};
+
+std::string texture_file_for_format(VulkanState& vulkan, std::string const& texture_format,
+                                    vk::Filter filter)
+{
+    if (texture_format == "auto")
+    {
+        auto sample_features = vk::FormatFeatureFlags{vk::FormatFeatureFlagBits::eSampledImage};
+
+        if (filter == vk::Filter::eLinear)
+            sample_features |= vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+
+        for (auto const& ctf : compressed_texture_files)
+        {
+            auto const format_props = vulkan.physical_device().getFormatProperties(ctf.format);
+            if ((format_props.optimalTilingFeatures & sample_features) == sample_features)
+                return std::string{"textures/crate-base-"} + ctf.name + ".ktx2";
+        }
+    }
+    else if (texture_format != "rgba8")
+    {
+        return "textures/crate-base-" + texture_format + ".ktx2";
+    }
+
+    return "textures/crate-base.jpg";
 }
 
-TextureScene::TextureScene() : Scene{"texture"}
+std::shared_ptr<Mesh const> load_mesh(bool indexed)
+{
+    return Model::load_mesh(
+        "cube.3ds",
+        ModelAttribMap{}
+            .with_position(vk::Format::eR32G32B32Sfloat)
+            .with_normal(vk::Format::eR32G32B32Sfloat)
+            .with_texcoord(vk::Format::eR32G32Sfloat)
+            .with_interleave(true),
+        indexed);
+}
+
+}
+
+TextureScene::TextureScene() : MultisampleScene{"texture"}
 {
     options_["texture-filter"] = SceneOption("texture-filter", "linear",
                                              "The texture filter to use",
                                              "nearest,linear");
     options_["anisotropy"] = SceneOption("anisotropy", "16",
                                          "The max anisotropy bound to use (use 0 to disable it)");
+    options_["mipmaps"] = SceneOption("mipmaps", "false",
+                                      "Whether to generate and sample a mipmap chain "
+                                      "(trilinear filtering with texture-filter=linear)");
+    options_["texture-format"] = SceneOption("texture-format", "rgba8",
+                                             "The texture format to use (auto picks the best "
+                                             "compressed format supported by the device)",
+                                             "rgba8,auto,bc1,bc7,etc2,astc");
+    options_["indexed"] =
+        SceneOption("indexed", "false",
+                    "Whether to draw with an index buffer, sharing vertices between faces");
 }
 
 TextureScene::~TextureScene() = default;
 
+void TextureScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    auto const& texture_format = options.at("texture-format").value;
+
+    load_mesh(options.at("indexed").value == "true");
+    Util::read_data_file("shaders/light-basic-tex.vert.spv");
+    Util::read_data_file("shaders/light-basic-tex.frag.spv");
+
+    // The auto format depends on device support, so it's resolved in setup
+    if (texture_format == "rgba8")
+        Util::read_image_file("textures/crate-base.jpg");
+    else if (texture_format != "auto")
+        Util::read_data_file("textures/crate-base-" + texture_format + ".ktx2");
+}
+
 void TextureScene::setup(
     VulkanState& vulkan_,
     std::vector<VulkanImage> const& vulkan_images)
 {
-    Scene::setup(vulkan_, vulkan_images);
+    MultisampleScene::setup(vulkan_, vulkan_images);
 
     vulkan = &vulkan_;
     extent = vulkan_images[0].extent;
@@ -68,13 +143,7 @@ void TextureScene::setup(
     depth_format = vk::Format::eD32Sfloat;
     aspect = static_cast<float>(extent.height) / extent.width;
 
-    mesh = Model{"cube.3ds"}.to_mesh(
-        ModelAttribMap{}
-            .with_position(vk::Format::eR32G32B32Sfloat)
-            .with_normal(vk::Format::eR32G32B32Sfloat)
-            .with_texcoord(vk::Format::eR32G32Sfloat));
-
-    mesh->set_interleave(true);
+    mesh = load_mesh(options_["indexed"].value == "true");
 
     // Model projection
     auto const min_bound = mesh->min_attribute_bound(0);
@@ -87,12 +156,14 @@ void TextureScene::setup(
     projection = glm::perspective(fovy, aspect, 2.0f, 2.0f + diameter);
 
     setup_vertex_buffer();
+    setup_index_buffer();
     setup_uniform_buffer();
     setup_texture();
     setup_shader_descriptor_set();
     setup_render_pass();
     setup_pipeline();
     setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
     setup_framebuffers(vulkan_images);
     setup_command_buffers();
 
@@ -108,6 +179,7 @@ void TextureScene::teardown()
     vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
     framebuffers.clear();
     image_views.clear();
+    color_target = {};
     depth_image_view = {};
     depth_image = {};
     pipeline = {};
@@ -117,6 +189,7 @@ void TextureScene::teardown()
     texture = {};
     uniform_buffer_map = {};
     uniform_buffer = {};
+    index_buffer = {};
     vertex_buffer = {};
 
     Scene::teardown();
@@ -152,35 +225,12 @@ void TextureScene::update()
 
 void TextureScene::setup_vertex_buffer()
 {
-    vk::DeviceMemory staging_buffer_memory;
-    vk::BufferUsageFlags staging_usage_flags =
-        vk::BufferUsageFlagBits::eVertexBuffer |
-        vk::BufferUsageFlagBits::eTransferSrc;
-
-    auto staging_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(staging_usage_flags)
-        .set_memory_properties(
-            vk::MemoryPropertyFlagBits::eHostVisible |
-            vk::MemoryPropertyFlagBits::eHostCoherent)
-        .set_memory_out(staging_buffer_memory)
-        .build();
-
-    {
-        auto const staging_buffer_map = vkutil::map_memory(
-            *vulkan, staging_buffer_memory, 0, mesh->vertex_data_size());
-        mesh->copy_vertex_data_to(staging_buffer_map);
-    }
-
-    vertex_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(
-            vk::BufferUsageFlagBits::eVertexBuffer |
-            vk::BufferUsageFlagBits::eTransferDst)
-        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
-        .build();
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
 
-    vkutil::copy_buffer(*vulkan, staging_buffer, vertex_buffer, mesh->vertex_data_size());
+void TextureScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(*vulkan, *mesh);
 }
 
 void TextureScene::setup_uniform_buffer()
@@ -202,6 +252,7 @@ void TextureScene::setup_texture()
 {
     auto const& filter = options_["texture-filter"].value;
     auto const anisotropy = std::stof(options_["anisotropy"].value);
+    auto const mipmaps = options_["mipmaps"].value == "true";
     vk::Filter vk_filter = vk::Filter::eLinear;
 
     if (filter == "nearest")
@@ -209,10 +260,14 @@ void TextureScene::setup_texture()
     else if (filter == "linear")
         vk_filter = vk::Filter::eLinear;
 
+    auto const file = texture_file_for_format(
+        *vulkan, options_["texture-format"].value, vk_filter);
+
     texture = vkutil::TextureBuilder{*vulkan}
-        .set_file("textures/crate-base.jpg")
+        .set_file(file)
         .set_filter(vk_filter)
         .set_anisotropy(anisotropy)
+        .set_mipmaps(mipmaps)
         .build();
 }
 
@@ -235,6 +290,7 @@ void TextureScene::setup_render_pass()
     render_pass = vkutil::RenderPassBuilder(*vulkan)
         .set_color_format(format)
         .set_depth_format(depth_format)
+        .set_samples(samples)
         .set_color_load_op(vk::AttachmentLoadOp::eClear)
         .build();
 }
@@ -252,6 +308,7 @@ void TextureScene::setup_pipeline()
         .set_extent(extent)
         .set_layout(pipeline_layout)
         .set_render_pass(render_pass)
+        .set_samples(samples)
         .set_vertex_shader(Util::read_data_file("shaders/light-basic-tex.vert.spv"))
         .set_fragment_shader(Util::read_data_file("shaders/light-basic-tex.frag.spv"))
         .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
@@ -264,6 +321,7 @@ void TextureScene::setup_depth_image()
     depth_image = vkutil::ImageBuilder{*vulkan}
         .set_extent(extent)
         .set_format(depth_format)
+        .set_samples(samples)
         .set_tiling(vk::ImageTiling::eOptimal)
         .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
         .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
@@ -298,10 +356,14 @@ void TextureScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_ima
 
     for (auto const& image_view : image_views)
     {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
         framebuffers.push_back(
             vkutil::FramebufferBuilder{*vulkan}
                 .set_render_pass(render_pass)
-                .set_image_views({image_view, depth_image_view})
+                .set_image_views(attachments)
                 .set_extent(extent)
                 .build());
     }
@@ -346,7 +408,15 @@ void TextureScene::setup_command_buffers()
             binding_offsets
             );
 
-        command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+        if (mesh->num_indices() > 0)
+        {
+            command_buffers[i].bindIndexBuffer(index_buffer, 0, mesh->index_type());
+            command_buffers[i].drawIndexed(mesh->num_indices(), 1, 0, 0, 0);
+        }
+        else
+        {
+            command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+        }
 
         command_buffers[i].endRenderPass();
         command_buffers[i].end();
@@ -0,0 +1,451 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "transfer_scene.h"
+
+#include "log.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+vk::DeviceSize const min_size = 4 * 1024;
+vk::DeviceSize const max_size = 1024 * 1024 * 1024;
+// When not set explicitly, the number of copies per frame is chosen to copy
+// at least this much data, so that the per copy overhead doesn't dominate
+vk::DeviceSize const auto_copies_bytes = 64 * 1024 * 1024;
+uint32_t const max_copies = 100000;
+// The copies within a frame write to separate regions of the destination, so
+// that they are independent, as long as the regions fit in this much memory
+vk::DeviceSize const max_dst_bytes = 256 * 1024 * 1024;
+// Images are copied as RGBA8 texels
+vk::DeviceSize const texel_size = 4;
+
+// Accepts a number of bytes, optionally with a K, M or G binary suffix
+vk::DeviceSize size_option_value(std::string const& value)
+{
+    vk::DeviceSize multiplier = 1;
+    auto number = value;
+
+    if (!value.empty())
+    {
+        switch (value.back())
+        {
+            case 'K': multiplier = 1024; break;
+            case 'M': multiplier = 1024 * 1024; break;
+            case 'G': multiplier = 1024 * 1024 * 1024; break;
+            default: break;
+        }
+
+        if (multiplier > 1)
+            number.pop_back();
+    }
+
+    auto const number_value = Util::from_string<vk::DeviceSize>(number);
+    // Check before multiplying, so that overflowing values aren't wrapped
+    // into range
+    auto const size = number_value <= max_size / multiplier ?
+                      number_value * multiplier : 0;
+
+    if (size < min_size || size > max_size || size % texel_size != 0)
+    {
+        throw std::runtime_error(
+            "\"size\" option must be a multiple of 4 between 4K and 1G");
+    }
+
+    return size;
+}
+
+std::string size_to_string(vk::DeviceSize size)
+{
+    std::stringstream ss;
+
+    if (size % (1024 * 1024 * 1024) == 0)
+        ss << size / (1024 * 1024 * 1024) << " GiB";
+    else if (size % (1024 * 1024) == 0)
+        ss << size / (1024 * 1024) << " MiB";
+    else if (size % 1024 == 0)
+        ss << size / 1024 << " KiB";
+    else
+        ss << size << " B";
+
+    return ss.str();
+}
+
+// Picks the most square power of two width which evenly divides the texels
+vk::Extent2D image_extent_for_size(vk::DeviceSize size)
+{
+    auto const num_texels = size / texel_size;
+    uint32_t width = 1;
+
+    while (static_cast<vk::DeviceSize>(width) * 2 * width * 2 <= num_texels)
+        width *= 2;
+
+    while (num_texels % width != 0)
+        width /= 2;
+
+    return {width, static_cast<uint32_t>(num_texels / width)};
+}
+
+}
+
+TransferScene::TransferScene() : Scene{"transfer"}
+{
+    options_["copy"] =
+        SceneOption("copy", "buffer",
+                    "The kind of copy: buffer to buffer, buffer to image, or image to image",
+                    "buffer,buffer-to-image,image");
+
+    options_["memory"] =
+        SceneOption("memory", "device-local",
+                    "The type of memory for the buffers (images always use "
+                    "device-local memory)",
+                    "device-local,host-visible");
+
+    options_["size"] =
+        SceneOption("size", "64M",
+                    "The size of each copy in bytes, optionally with a K, M or G suffix "
+                    "(4K to 1G)");
+
+    options_["copies"] =
+        SceneOption("copies", "auto",
+                    "The number of copies per frame (1 to 100000), or \"auto\" to copy "
+                    "at least 64M per frame");
+}
+
+TransferScene::~TransferScene() = default;
+
+void TransferScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    Scene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+
+    copy_type = options_["copy"].value;
+    host_visible = options_["memory"].value == "host-visible";
+
+    if (host_visible && copy_type == "image")
+    {
+        Log::warning("TransferScene: Image to image copies don't use buffers, "
+                     "ignoring \"memory\" option\n");
+        host_visible = false;
+    }
+    size = size_option_value(options_["size"].value);
+
+    if (copy_type != "buffer" && copy_type != "buffer-to-image" && copy_type != "image")
+        throw std::runtime_error("Unsupported \"copy\" option value: " + copy_type);
+
+    if (options_["copies"].value == "auto")
+    {
+        num_copies = static_cast<uint32_t>(std::max<vk::DeviceSize>(1, auto_copies_bytes / size));
+    }
+    else
+    {
+        num_copies = Util::ranged_option_value<uint32_t>(
+            "copies", options_["copies"].value, 1, max_copies);
+    }
+
+    image_extent = image_extent_for_size(size);
+    num_dst_regions = static_cast<uint32_t>(
+        std::min<vk::DeviceSize>(num_copies, std::max<vk::DeviceSize>(1, max_dst_bytes / size)));
+
+    if (copy_type != "buffer")
+    {
+        auto const max_dimension =
+            vulkan->physical_device().getProperties().limits.maxImageDimension2D;
+
+        if (image_extent.width > max_dimension || image_extent.height > max_dimension)
+        {
+            throw std::runtime_error(
+                "The " + std::to_string(image_extent.width) + "x" +
+                std::to_string(image_extent.height) + " image needed for a copy of " +
+                size_to_string(size) + " exceeds the device limits");
+        }
+
+        // The destination image regions are stacked vertically
+        num_dst_regions = std::min(num_dst_regions, max_dimension / image_extent.height);
+    }
+
+    setup_buffers();
+    setup_images();
+    setup_render_pass();
+    setup_framebuffers(vulkan_images);
+    setup_command_buffers();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+}
+
+void TransferScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
+    framebuffers.clear();
+    image_views.clear();
+    render_pass = {};
+    dst_image = {};
+    src_image = {};
+    dst_buffer = {};
+    src_buffer = {};
+
+    Scene::teardown();
+}
+
+VulkanImage TransferScene::draw(VulkanImage const& image)
+{
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&command_buffers[image.index])
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, {});
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+std::string TransferScene::extra_results() const
+{
+    std::stringstream ss;
+    ss << "Size: " << size_to_string(size) << " Copies: " << num_copies
+       << " Bandwidth: " << std::fixed << std::setprecision(2)
+       << static_cast<double>(size) * num_copies * average_fps() / 1000000000.0
+       << " GB/s";
+    return ss.str();
+}
+
+void TransferScene::setup_buffers()
+{
+    if (copy_type == "image")
+        return;
+
+    auto const memory_properties = host_visible ?
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent :
+        vk::MemoryPropertyFlags{vk::MemoryPropertyFlagBits::eDeviceLocal};
+
+    src_buffer = vkutil::BufferBuilder{*vulkan}
+        .set_size(size)
+        .set_usage(vk::BufferUsageFlagBits::eTransferSrc)
+        .set_memory_properties(memory_properties)
+        .build();
+
+    if (copy_type == "buffer")
+    {
+        dst_buffer = vkutil::BufferBuilder{*vulkan}
+            .set_size(size * num_dst_regions)
+            .set_usage(vk::BufferUsageFlagBits::eTransferDst)
+            .set_memory_properties(memory_properties)
+            .build();
+    }
+}
+
+void TransferScene::setup_images()
+{
+    if (copy_type == "buffer")
+        return;
+
+    if (copy_type == "image")
+    {
+        src_image = vkutil::ImageBuilder{*vulkan}
+            .set_extent(image_extent)
+            .set_format(vk::Format::eR8G8B8A8Unorm)
+            .set_tiling(vk::ImageTiling::eOptimal)
+            .set_usage(vk::ImageUsageFlagBits::eTransferSrc)
+            .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+            .set_initial_layout(vk::ImageLayout::eUndefined)
+            .build();
+
+        vkutil::transition_image_layout(
+            *vulkan,
+            src_image,
+            vk::ImageLayout::eUndefined,
+            vk::ImageLayout::eTransferSrcOptimal,
+            vk::ImageAspectFlagBits::eColor);
+    }
+
+    dst_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent({image_extent.width, image_extent.height * num_dst_regions})
+        .set_format(vk::Format::eR8G8B8A8Unorm)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eTransferDst)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        dst_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eTransferDstOptimal,
+        vk::ImageAspectFlagBits::eColor);
+}
+
+void TransferScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void TransferScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views({image_view})
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void TransferScene::setup_command_buffers()
+{
+    auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+        .setCommandPool(vulkan->command_pool())
+        .setCommandBufferCount(framebuffers.size())
+        .setLevel(vk::CommandBufferLevel::ePrimary);
+
+    command_buffers = vulkan->device().allocateCommandBuffers(command_buffer_allocate_info);
+
+    auto const image_subresource_layers = vk::ImageSubresourceLayers{}
+        .setAspectMask(vk::ImageAspectFlagBits::eColor)
+        .setMipLevel(0)
+        .setBaseArrayLayer(0)
+        .setLayerCount(1);
+
+    auto buffer_copy = vk::BufferCopy{}.setSize(size);
+
+    auto buffer_image_copy = vk::BufferImageCopy{}
+        .setBufferOffset(0)
+        .setBufferRowLength(0)
+        .setBufferImageHeight(0)
+        .setImageSubresource(image_subresource_layers)
+        .setImageExtent({image_extent.width, image_extent.height, 1});
+
+    auto image_copy = vk::ImageCopy{}
+        .setSrcSubresource(image_subresource_layers)
+        .setSrcOffset({0, 0, 0})
+        .setDstSubresource(image_subresource_layers)
+        .setExtent({image_extent.width, image_extent.height, 1});
+
+    // Copies that write to the same destination region, either in successive
+    // frames or after the regions wrap around within a frame, are ordered,
+    // while the copies to separate regions are left free to overlap, like
+    // independent uploads would be
+    auto const transfer_barrier = vk::MemoryBarrier{}
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eTransferWrite);
+
+    vk::ClearValue const clear_value{
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}}};
+
+    for (size_t i = 0; i < command_buffers.size(); ++i)
+    {
+        auto const begin_info = vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eSimultaneousUse);
+
+        command_buffers[i].begin(begin_info);
+
+        command_buffers[i].pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eTransfer,
+            {}, transfer_barrier, {}, {});
+
+        for (uint32_t c = 0; c < num_copies; ++c)
+        {
+            auto const region = c % num_dst_regions;
+
+            if (c > 0 && region == 0)
+            {
+                command_buffers[i].pipelineBarrier(
+                    vk::PipelineStageFlagBits::eTransfer,
+                    vk::PipelineStageFlagBits::eTransfer,
+                    {}, transfer_barrier, {}, {});
+            }
+
+            auto const dst_y = static_cast<int32_t>(region * image_extent.height);
+            buffer_copy.setDstOffset(region * size);
+            buffer_image_copy.setImageOffset({0, dst_y, 0});
+            image_copy.setDstOffset({0, dst_y, 0});
+
+            if (copy_type == "buffer")
+            {
+                command_buffers[i].copyBuffer(src_buffer, dst_buffer, buffer_copy);
+            }
+            else if (copy_type == "buffer-to-image")
+            {
+                command_buffers[i].copyBufferToImage(
+                    src_buffer, dst_image, vk::ImageLayout::eTransferDstOptimal,
+                    buffer_image_copy);
+            }
+            else
+            {
+                command_buffers[i].copyImage(
+                    src_image, vk::ImageLayout::eTransferSrcOptimal,
+                    dst_image, vk::ImageLayout::eTransferDstOptimal,
+                    image_copy);
+            }
+        }
+
+        // Present a cleared image, as there is nothing to draw
+        auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+            .setRenderPass(render_pass)
+            .setFramebuffer(framebuffers[i])
+            .setRenderArea({{0,0}, extent})
+            .setClearValueCount(1)
+            .setPClearValues(&clear_value);
+
+        command_buffers[i].beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+        command_buffers[i].endRenderPass();
+
+        command_buffers[i].end();
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "scene.h"
+#include "managed_resource.h"
+
+#include <vulkan/vulkan.hpp>
+
+// Measures transfer bandwidth by copying a block of memory of the
+// configured size, between buffers, from a buffer to an image or between
+// images, a number of times per frame
+class TransferScene : public Scene
+{
+public:
+    TransferScene();
+    ~TransferScene();
+
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+
+    std::string extra_results() const override;
+
+private:
+    void setup_buffers();
+    void setup_images();
+    void setup_render_pass();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_command_buffers();
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+
+    std::string copy_type;
+    bool host_visible;
+    vk::DeviceSize size;
+    vk::Extent2D image_extent;
+    uint32_t num_copies;
+    uint32_t num_dst_regions;
+
+    ManagedResource<vk::Buffer> src_buffer;
+    ManagedResource<vk::Buffer> dst_buffer;
+    ManagedResource<vk::Image> src_image;
+    ManagedResource<vk::Image> dst_image;
+    ManagedResource<vk::RenderPass> render_pass;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    std::vector<vk::CommandBuffer> command_buffers;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+};
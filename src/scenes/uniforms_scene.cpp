@@ -0,0 +1,583 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uniforms_scene.h"
+
+#include "mesh.h"
+#include "model.h"
+#include "util.h"
+#include "vulkan_state.h"
+#include "vulkan_image.h"
+#include "vkutil/vkutil.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+size_t const max_objects = 10000;
+// Memory allocations the scene makes besides the per-object uniform buffers
+uint32_t const other_allocations = 16;
+
+std::shared_ptr<Mesh const> load_mesh()
+{
+    return Model::load_mesh(
+        "cube.3ds",
+        ModelAttribMap{}
+            .with_position(vk::Format::eR32G32B32Sfloat)
+            .with_normal(vk::Format::eR32G32B32Sfloat)
+            .with_interleave(true),
+        true);
+}
+
+std::string vertex_shader_for_mode(std::string const& ubo_mode)
+{
+    if (ubo_mode == "push-constants")
+        return "shaders/uniforms-push.vert.spv";
+    else if (ubo_mode == "ssbo-array")
+        return "shaders/uniforms-storage.vert.spv";
+    else
+        return "shaders/uniforms-ubo.vert.spv";
+}
+
+}
+
+UniformsScene::UniformsScene() : MultisampleScene{"uniforms"}
+{
+    options_["objects"] =
+        SceneOption("objects", "1000", "The number of objects drawn (1 to 10000)");
+    options_["ubo-mode"] =
+        SceneOption("ubo-mode", "per-object-ubo",
+                    "How the per-object uniforms are provided to the draws",
+                    "per-object-ubo,dynamic-offset,push-constants,ssbo-array,persistent-ring");
+}
+
+UniformsScene::~UniformsScene() = default;
+
+void UniformsScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    load_mesh();
+    Util::read_data_file(vertex_shader_for_mode(options.at("ubo-mode").value));
+    Util::read_data_file("shaders/light-basic.frag.spv");
+}
+
+void UniformsScene::setup(
+    VulkanState& vulkan_,
+    std::vector<VulkanImage> const& vulkan_images)
+{
+    MultisampleScene::setup(vulkan_, vulkan_images);
+
+    vulkan = &vulkan_;
+    extent = vulkan_images[0].extent;
+    format = vulkan_images[0].format;
+    depth_format = vk::Format::eD32Sfloat;
+
+    num_objects = Util::ranged_option_value<size_t>(
+        "objects", options_["objects"].value, 1, max_objects);
+    num_frames = vulkan_images.size();
+    ubo_mode = options_["ubo-mode"].value;
+
+    auto const& limits = vulkan->physical_device().getProperties().limits;
+
+    if (ubo_mode == "per-object-ubo" &&
+        num_objects + other_allocations > limits.maxMemoryAllocationCount)
+    {
+        throw std::runtime_error(
+            "\"objects\" option exceeds the device limit of " +
+            std::to_string(limits.maxMemoryAllocationCount - other_allocations) +
+            " objects with per-object-ubo");
+    }
+
+    // Uniforms selected with a dynamic offset have to be suitably aligned,
+    // while the storage buffer array is tightly packed
+    if (ubo_mode == "dynamic-offset" || ubo_mode == "persistent-ring")
+    {
+        auto const alignment = limits.minUniformBufferOffsetAlignment;
+        uniforms_stride =
+            (sizeof(ObjectUniforms) + alignment - 1) / alignment * alignment;
+    }
+    else
+    {
+        uniforms_stride = sizeof(ObjectUniforms);
+    }
+
+    mesh = load_mesh();
+    setup_objects();
+    setup_vertex_buffer();
+    setup_index_buffer();
+    setup_uniform_buffers();
+    setup_descriptor_sets();
+    setup_render_pass();
+    setup_pipeline();
+    setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
+    setup_framebuffers(vulkan_images);
+    setup_frames();
+
+    submit_semaphore = vkutil::SemaphoreBuilder{*vulkan}.build();
+    rotation = 0.0;
+}
+
+void UniformsScene::teardown()
+{
+    vulkan->device().waitIdle();
+
+    submit_semaphore = {};
+    for (auto const& frame : frames)
+    {
+        if (frame.fence)
+            vulkan->device().destroyFence(frame.fence);
+    }
+    frames.clear();
+    framebuffers.clear();
+    image_views.clear();
+    color_target = {};
+    depth_image_view = {};
+    depth_image = {};
+    pipeline = {};
+    pipeline_layout = {};
+    render_pass = {};
+    descriptor_sets.clear();
+    uniform_buffer_maps.clear();
+    uniform_buffers.clear();
+    index_buffer = {};
+    vertex_buffer = {};
+    object_uniforms.clear();
+    objects.clear();
+    mesh.reset();
+
+    Scene::teardown();
+}
+
+VulkanImage UniformsScene::draw(VulkanImage const& image)
+{
+    auto& frame = frames[image.index];
+
+    if (!frame.fence)
+    {
+        frame.fence = vulkan->device().createFence(vk::FenceCreateInfo());
+    }
+    else
+    {
+        vulkan->device().waitForFences(frame.fence, true, INT64_MAX);
+        vulkan->device().resetFences(frame.fence);
+    }
+
+    update_uniforms(image.index);
+    record_command_buffer(image.index);
+
+    vk::PipelineStageFlags const mask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    auto const submit_info = vk::SubmitInfo{}
+        .setCommandBufferCount(1)
+        .setPCommandBuffers(&frame.command_buffer)
+        .setWaitSemaphoreCount(image.semaphore ? 1 : 0)
+        .setPWaitSemaphores(&image.semaphore)
+        .setPWaitDstStageMask(&mask)
+        .setSignalSemaphoreCount(1)
+        .setPSignalSemaphores(&submit_semaphore.raw);
+
+    vulkan->graphics_queue().submit(submit_info, frame.fence);
+
+    return image.copy_with_semaphore(submit_semaphore);
+}
+
+void UniformsScene::update()
+{
+    auto const t = (Util::get_timestamp_us() - start_time) / 1000000.0f;
+
+    rotation = 72.0f * t;
+
+    Scene::update();
+}
+
+std::string UniformsScene::extra_results() const
+{
+    std::stringstream ss;
+    ss << "Objects: " << num_objects << " Mode: " << ubo_mode
+       << " Updates: " << std::fixed << std::setprecision(2)
+       << num_objects * average_fps() / 1000000.0 << " M/s";
+    return ss.str();
+}
+
+void UniformsScene::setup_objects()
+{
+    // Place the objects in the cells of a square grid of unit cells,
+    // scaling the mesh to fit comfortably in a cell
+    auto const grid = static_cast<size_t>(std::ceil(std::sqrt(num_objects)));
+    auto const min_bound = mesh->min_attribute_bound(0);
+    auto const max_bound = mesh->max_attribute_bound(0);
+    auto const scale = 0.6f / glm::length(max_bound - min_bound);
+    auto const center = (max_bound + min_bound) / 2.0f;
+    auto const grid_center = (grid - 1) / 2.0f;
+
+    mesh_transform = glm::scale(glm::mat4{1.0}, glm::vec3{scale});
+    mesh_transform = glm::translate(mesh_transform, -center);
+
+    objects.reserve(num_objects);
+
+    for (size_t i = 0; i < num_objects; ++i)
+    {
+        // Vary the rotation speed, so that every object needs its own
+        // transform every frame
+        glm::vec3 const cell(i % grid, i / grid, 0.0f);
+        objects.emplace_back(cell - glm::vec3{grid_center, grid_center, 0.0f},
+                             0.5f + (i % 7) / 6.0f);
+    }
+
+    object_uniforms.resize(num_objects);
+
+    auto const radius = grid * std::sqrt(2.0f) / 2.0f + 1.0f;
+    auto const aspect = static_cast<float>(extent.width) / extent.height;
+    projection = glm::ortho(-radius * aspect, radius * aspect, -radius, radius,
+                            -radius, radius);
+}
+
+void UniformsScene::setup_vertex_buffer()
+{
+    vertex_buffer = vkutil::create_vertex_buffer(*vulkan, *mesh);
+}
+
+void UniformsScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(*vulkan, *mesh);
+}
+
+void UniformsScene::setup_uniform_buffers()
+{
+    if (ubo_mode == "push-constants")
+        return;
+
+    std::vector<vk::DeviceSize> sizes;
+
+    if (ubo_mode == "per-object-ubo")
+        sizes.assign(num_objects, sizeof(ObjectUniforms));
+    else if (ubo_mode == "persistent-ring")
+        sizes.push_back(uniforms_stride * num_objects * num_frames);
+    else
+        sizes.push_back(uniforms_stride * num_objects);
+
+    auto const usage = ubo_mode == "ssbo-array" ?
+        vk::BufferUsageFlagBits::eStorageBuffer :
+        vk::BufferUsageFlagBits::eUniformBuffer;
+
+    // All buffers stay mapped for the whole run
+    for (auto const size : sizes)
+    {
+        vk::DeviceMemory uniform_buffer_memory;
+
+        uniform_buffers.push_back(
+            vkutil::BufferBuilder{*vulkan}
+                .set_size(size)
+                .set_usage(usage)
+                .set_memory_properties(
+                    vk::MemoryPropertyFlagBits::eHostVisible |
+                    vk::MemoryPropertyFlagBits::eHostCoherent)
+                .set_memory_out(uniform_buffer_memory)
+                .build());
+
+        uniform_buffer_maps.push_back(
+            vkutil::map_memory(*vulkan, uniform_buffer_memory, 0, size));
+    }
+}
+
+void UniformsScene::setup_descriptor_sets()
+{
+    if (ubo_mode == "push-constants")
+        return;
+
+    if (ubo_mode == "per-object-ubo")
+    {
+        // The descriptor set layouts are identical, so any descriptor set can
+        // be used with the pipeline
+        for (auto& uniform_buffer : uniform_buffers)
+        {
+            descriptor_sets.push_back(
+                vkutil::DescriptorSetBuilder{*vulkan}
+                    .set_type(vk::DescriptorType::eUniformBuffer)
+                    .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+                    .set_buffer(uniform_buffer, 0, sizeof(ObjectUniforms))
+                    .set_layout_out(descriptor_set_layout)
+                    .build());
+        }
+    }
+    else if (ubo_mode == "ssbo-array")
+    {
+        descriptor_sets.push_back(
+            vkutil::DescriptorSetBuilder{*vulkan}
+                .set_type(vk::DescriptorType::eStorageBuffer)
+                .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+                .set_buffer(uniform_buffers[0], 0, uniforms_stride * num_objects)
+                .set_layout_out(descriptor_set_layout)
+                .build());
+    }
+    else
+    {
+        // Each draw selects its uniforms with a dynamic offset
+        descriptor_sets.push_back(
+            vkutil::DescriptorSetBuilder{*vulkan}
+                .set_type(vk::DescriptorType::eUniformBufferDynamic)
+                .set_stage_flags(vk::ShaderStageFlagBits::eVertex)
+                .set_buffer(uniform_buffers[0], 0, sizeof(ObjectUniforms))
+                .set_layout_out(descriptor_set_layout)
+                .build());
+    }
+}
+
+void UniformsScene::setup_render_pass()
+{
+    render_pass = vkutil::RenderPassBuilder(*vulkan)
+        .set_color_format(format)
+        .set_depth_format(depth_format)
+        .set_samples(samples)
+        .set_color_load_op(vk::AttachmentLoadOp::eClear)
+        .build();
+}
+
+void UniformsScene::setup_pipeline()
+{
+    auto const push_constant_range = vk::PushConstantRange{}
+        .setStageFlags(vk::ShaderStageFlagBits::eVertex)
+        .setOffset(0)
+        .setSize(sizeof(ObjectUniforms));
+
+    auto pipeline_layout_create_info = vk::PipelineLayoutCreateInfo{};
+
+    if (ubo_mode == "push-constants")
+    {
+        pipeline_layout_create_info
+            .setPushConstantRangeCount(1)
+            .setPPushConstantRanges(&push_constant_range);
+    }
+    else
+    {
+        pipeline_layout_create_info
+            .setSetLayoutCount(1)
+            .setPSetLayouts(&descriptor_set_layout);
+    }
+
+    pipeline_layout = ManagedResource<vk::PipelineLayout>{
+        vulkan->device().createPipelineLayout(pipeline_layout_create_info),
+        [this] (auto const& pl) { vulkan->device().destroyPipelineLayout(pl); }};
+
+    pipeline = vkutil::PipelineBuilder(*vulkan)
+        .set_extent(extent)
+        .set_layout(pipeline_layout)
+        .set_render_pass(render_pass)
+        .set_samples(samples)
+        .set_vertex_shader(Util::read_data_file(vertex_shader_for_mode(ubo_mode)))
+        .set_fragment_shader(Util::read_data_file("shaders/light-basic.frag.spv"))
+        .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
+        .set_depth_test(true)
+        .build();
+}
+
+void UniformsScene::setup_depth_image()
+{
+    depth_image = vkutil::ImageBuilder{*vulkan}
+        .set_extent(extent)
+        .set_format(depth_format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        *vulkan,
+        depth_image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        vk::ImageAspectFlagBits::eDepth);
+}
+
+void UniformsScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_images)
+{
+    depth_image_view = vkutil::ImageViewBuilder{*vulkan}
+        .set_image(depth_image)
+        .set_format(depth_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eDepth)
+        .build();
+
+    for (auto const& vulkan_image : vulkan_images)
+    {
+        image_views.push_back(
+            vkutil::ImageViewBuilder{*vulkan}
+                .set_image(vulkan_image.image)
+                .set_format(vulkan_image.format)
+                .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+                .build());
+    }
+
+    for (auto const& image_view : image_views)
+    {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
+        framebuffers.push_back(
+            vkutil::FramebufferBuilder{*vulkan}
+                .set_render_pass(render_pass)
+                .set_image_views(attachments)
+                .set_extent(extent)
+                .build());
+    }
+}
+
+void UniformsScene::setup_frames()
+{
+    frames.resize(num_frames);
+
+    for (auto& frame : frames)
+    {
+        frame.command_pool = vkutil::create_command_pool(*vulkan);
+
+        auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
+            .setCommandPool(frame.command_pool)
+            .setCommandBufferCount(1)
+            .setLevel(vk::CommandBufferLevel::ePrimary);
+
+        frame.command_buffer =
+            vulkan->device().allocateCommandBuffers(command_buffer_allocate_info)[0];
+    }
+}
+
+void UniformsScene::update_uniforms(size_t image_index)
+{
+    glm::mat4 view{1.0};
+    view = glm::rotate(view, glm::radians(30.0f), {1.0f, 0.0f, 0.0f});
+
+    glm::vec3 const axis = glm::normalize(glm::vec3{1.0f, 1.0f, 0.5f});
+
+    for (size_t i = 0; i < num_objects; ++i)
+    {
+        auto const& object = objects[i];
+
+        auto model = glm::translate(glm::mat4{1.0}, glm::vec3{object});
+        model = glm::rotate(model, glm::radians(rotation * object.w), axis);
+        auto const modelview = view * model * mesh_transform;
+
+        // The model only rotates and uniformly scales the mesh, and the
+        // shader normalizes the transformed normals
+        object_uniforms[i].modelviewprojection = projection * modelview;
+        object_uniforms[i].normal = modelview;
+    }
+
+    if (ubo_mode == "per-object-ubo")
+    {
+        for (size_t i = 0; i < num_objects; ++i)
+            memcpy(uniform_buffer_maps[i], &object_uniforms[i], sizeof(ObjectUniforms));
+    }
+    else if (ubo_mode == "dynamic-offset" || ubo_mode == "persistent-ring")
+    {
+        // The ring has a separate region for each swapchain image, so the
+        // uniforms used by frames still in flight are never overwritten
+        auto const region = ubo_mode == "persistent-ring" ? image_index : 0;
+        auto const uniforms = static_cast<char*>(uniform_buffer_maps[0].raw) +
+                              region * num_objects * uniforms_stride;
+
+        for (size_t i = 0; i < num_objects; ++i)
+            memcpy(uniforms + i * uniforms_stride, &object_uniforms[i], sizeof(ObjectUniforms));
+    }
+    else if (ubo_mode == "ssbo-array")
+    {
+        memcpy(uniform_buffer_maps[0], object_uniforms.data(),
+               num_objects * sizeof(ObjectUniforms));
+    }
+}
+
+void UniformsScene::record_command_buffer(size_t image_index)
+{
+    auto& frame = frames[image_index];
+    auto const command_buffer = frame.command_buffer;
+
+    vulkan->device().resetCommandPool(frame.command_pool, {});
+
+    auto const begin_info = vk::CommandBufferBeginInfo{}
+        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+    command_buffer.begin(begin_info);
+
+    std::array<vk::ClearValue, 2> clear_values{{
+        vk::ClearColorValue{std::array<float,4>{{0.0f, 0.0f, 0.0f, 1.0f}}},
+        vk::ClearDepthStencilValue{1.0f, 0}}};
+
+    auto const render_pass_begin_info = vk::RenderPassBeginInfo{}
+        .setRenderPass(render_pass)
+        .setFramebuffer(framebuffers[image_index])
+        .setRenderArea({{0,0}, extent})
+        .setClearValueCount(clear_values.size())
+        .setPClearValues(clear_values.data());
+
+    command_buffer.beginRenderPass(render_pass_begin_info, vk::SubpassContents::eInline);
+    command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+
+    auto const binding_offsets = mesh->vertex_data_binding_offsets();
+    command_buffer.bindVertexBuffers(
+        0,
+        std::vector<vk::Buffer>{binding_offsets.size(), vertex_buffer.raw},
+        binding_offsets);
+    command_buffer.bindIndexBuffer(index_buffer, 0, mesh->index_type());
+
+    auto const num_indices = static_cast<uint32_t>(mesh->num_indices());
+    auto const region = ubo_mode == "persistent-ring" ? image_index : 0;
+
+    if (ubo_mode == "ssbo-array")
+    {
+        command_buffer.bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
+            descriptor_sets[0].raw, {});
+    }
+
+    for (size_t i = 0; i < num_objects; ++i)
+    {
+        if (ubo_mode == "per-object-ubo")
+        {
+            command_buffer.bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
+                descriptor_sets[i].raw, {});
+        }
+        else if (ubo_mode == "dynamic-offset" || ubo_mode == "persistent-ring")
+        {
+            auto const offset =
+                static_cast<uint32_t>((region * num_objects + i) * uniforms_stride);
+            command_buffer.bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
+                descriptor_sets[0].raw, offset);
+        }
+        else if (ubo_mode == "push-constants")
+        {
+            command_buffer.pushConstants(
+                pipeline_layout, vk::ShaderStageFlagBits::eVertex, 0,
+                sizeof(ObjectUniforms), &object_uniforms[i]);
+        }
+
+        // The storage buffer array is indexed by the first instance
+        command_buffer.drawIndexed(num_indices, 1, 0, 0, i);
+    }
+
+    command_buffer.endRenderPass();
+    command_buffer.end();
+}
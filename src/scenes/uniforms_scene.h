@@ -0,0 +1,117 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "multisample_scene.h"
+#include "managed_resource.h"
+#include "vkutil/msaa_color_target.h"
+
+#include <memory>
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+class Mesh;
+
+// Compares ways of providing per-object uniforms, by drawing a number of
+// objects whose transforms change every frame
+class UniformsScene : public MultisampleScene
+{
+public:
+    UniformsScene();
+    ~UniformsScene();
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override;
+    void setup(VulkanState&, std::vector<VulkanImage> const&) override;
+    void teardown() override;
+
+    VulkanImage draw(VulkanImage const&) override;
+    void update() override;
+
+    std::string extra_results() const override;
+
+private:
+    struct ObjectUniforms
+    {
+        glm::mat4 modelviewprojection;
+        glm::mat4 normal;
+    };
+
+    // The command buffer used for a swapchain image, re-recorded every frame
+    struct Frame
+    {
+        ManagedResource<vk::CommandPool> command_pool;
+        vk::CommandBuffer command_buffer;
+        vk::Fence fence;
+    };
+
+    void setup_objects();
+    void setup_vertex_buffer();
+    void setup_index_buffer();
+    void setup_uniform_buffers();
+    void setup_descriptor_sets();
+    void setup_render_pass();
+    void setup_pipeline();
+    void setup_depth_image();
+    void setup_framebuffers(std::vector<VulkanImage> const&);
+    void setup_frames();
+    void update_uniforms(size_t image_index);
+    void record_command_buffer(size_t image_index);
+
+    VulkanState* vulkan;
+    vk::Extent2D extent;
+    vk::Format format;
+    vk::Format depth_format;
+    glm::mat4 projection;
+    // Scales and centers the mesh in its grid cell
+    glm::mat4 mesh_transform;
+    size_t num_objects;
+    size_t num_frames;
+    std::string ubo_mode;
+    vk::DeviceSize uniforms_stride;
+
+    std::shared_ptr<Mesh const> mesh;
+    // Position (xyz) and rotation speed (w) of each object
+    std::vector<glm::vec4> objects;
+    // The uniforms of each object, computed every frame
+    std::vector<ObjectUniforms> object_uniforms;
+
+    ManagedResource<vk::Buffer> vertex_buffer;
+    ManagedResource<vk::Buffer> index_buffer;
+    // One buffer per object with per-object-ubo, otherwise a single buffer
+    std::vector<ManagedResource<vk::Buffer>> uniform_buffers;
+    std::vector<ManagedResource<void*>> uniform_buffer_maps;
+    std::vector<ManagedResource<vk::DescriptorSet>> descriptor_sets;
+    ManagedResource<vk::RenderPass> render_pass;
+    ManagedResource<vk::PipelineLayout> pipeline_layout;
+    ManagedResource<vk::Pipeline> pipeline;
+    vkutil::MsaaColorTarget color_target;
+    ManagedResource<vk::Image> depth_image;
+    ManagedResource<vk::ImageView> depth_image_view;
+    std::vector<ManagedResource<vk::ImageView>> image_views;
+    std::vector<ManagedResource<vk::Framebuffer>> framebuffers;
+    std::vector<Frame> frames;
+    ManagedResource<vk::Semaphore> submit_semaphore;
+
+    vk::DescriptorSetLayout descriptor_set_layout;
+
+    float rotation;
+};
@@ -22,7 +22,9 @@
 
 #include "vertex_scene.h"
 
+#include "format_options.h"
 #include "mesh.h"
+#include "mesh_optimizer.h"
 #include "model.h"
 #include "util.h"
 #include "vulkan_state.h"
@@ -43,9 +45,23 @@ struct Uniforms
     glm::vec4 material_diffuse;
 };
 
+std::shared_ptr<Mesh const> load_mesh(bool indexed, bool interleave,
+                                      std::string const& vertex_format)
+{
+    auto const formats = position_normal_formats(vertex_format);
+
+    return Model::load_mesh(
+        "horse.3ds",
+        ModelAttribMap{}
+            .with_position(formats.first)
+            .with_normal(formats.second)
+            .with_interleave(interleave),
+        indexed);
+}
+
 }
 
-VertexScene::VertexScene() : Scene{"vertex"}
+VertexScene::VertexScene() : MultisampleScene{"vertex"}
 {
     options_["interleave"] =
         SceneOption("interleave", "true", "Whether to interleave vertex data");
@@ -53,15 +69,40 @@ VertexScene::VertexScene() : Scene{"vertex"}
     options_["device-local"] =
         SceneOption("device-local", "true",
                     "Whether to use a device-local buffer for the vertex data");
+
+    options_["indexed"] =
+        SceneOption("indexed", "false",
+                    "Whether to draw with an index buffer, sharing vertices between faces");
+
+    options_["vertex-format"] =
+        SceneOption("vertex-format", "float",
+                    "The vertex position and normal formats: 32-bit float, 16-bit float, "
+                    "or 16-bit float positions with 8-bit or packed 10-bit SNORM normals",
+                    "float,half,half-snorm8,half-snorm10");
+
+    options_["optimize"] =
+        SceneOption("optimize", "none",
+                    "How to reorder the mesh: triangles for the post-transform vertex cache, "
+                    "vertices for fetch locality, or both (implies indexed drawing)",
+                    "none,cache,fetch,both");
 }
 
 VertexScene::~VertexScene() = default;
 
+void VertexScene::prefetch(std::unordered_map<std::string, SceneOption> const& options) const
+{
+    load_mesh(options.at("indexed").value == "true" || options.at("optimize").value != "none",
+              options.at("interleave").value == "true",
+              options.at("vertex-format").value);
+    Util::read_data_file("shaders/light-basic.vert.spv");
+    Util::read_data_file("shaders/light-basic.frag.spv");
+}
+
 void VertexScene::setup(
     VulkanState& vulkan_,
     std::vector<VulkanImage> const& vulkan_images)
 {
-    Scene::setup(vulkan_, vulkan_images);
+    MultisampleScene::setup(vulkan_, vulkan_images);
 
     vulkan = &vulkan_;
     extent = vulkan_images[0].extent;
@@ -69,12 +110,24 @@ void VertexScene::setup(
     depth_format = vk::Format::eD32Sfloat;
     aspect = static_cast<float>(extent.height) / extent.width;
 
-    mesh = Model{"horse.3ds"}.to_mesh(
-        ModelAttribMap{}
-            .with_position(vk::Format::eR32G32B32Sfloat)
-            .with_normal(vk::Format::eR32G32B32Sfloat));
+    auto const optimize = options_["optimize"].value;
+
+    mesh = load_mesh(options_["indexed"].value == "true" || optimize != "none",
+                     options_["interleave"].value == "true",
+                     options_["vertex-format"].value);
+
+    // The loaded mesh is shared, so optimize a copy
+    if (optimize != "none")
+    {
+        auto optimized_mesh = std::make_unique<Mesh>(*mesh);
+
+        if (optimize == "cache" || optimize == "both")
+            optimize_vertex_cache(*optimized_mesh);
+        if (optimize == "fetch" || optimize == "both")
+            optimize_vertex_fetch(*optimized_mesh);
 
-    mesh->set_interleave(options_["interleave"].value == "true");
+        mesh = std::move(optimized_mesh);
+    }
 
     // Model projection
     auto const min_bound = mesh->min_attribute_bound(0);
@@ -87,11 +140,13 @@ void VertexScene::setup(
     projection = glm::perspective(fovy, aspect, 2.0f, 2.0f + diameter);
 
     setup_vertex_buffer();
+    setup_index_buffer();
     setup_uniform_buffer();
     setup_uniform_descriptor_set();
     setup_render_pass();
     setup_pipeline();
     setup_depth_image();
+    color_target = vkutil::create_msaa_color_target(*vulkan, extent, format, samples);
     setup_framebuffers(vulkan_images);
     setup_command_buffers();
 
@@ -107,6 +162,7 @@ void VertexScene::teardown()
     vulkan->device().freeCommandBuffers(vulkan->command_pool(), command_buffers);
     framebuffers.clear();
     image_views.clear();
+    color_target = {};
     depth_image_view = {};
     depth_image = {};
     pipeline = {};
@@ -115,6 +171,7 @@ void VertexScene::teardown()
     descriptor_set = {};
     uniform_buffer_map = {};
     uniform_buffer = {};
+    index_buffer = {};
     vertex_buffer = {};
 
     Scene::teardown();
@@ -150,45 +207,14 @@ void VertexScene::update()
 
 void VertexScene::setup_vertex_buffer()
 {
-    bool const use_staging_buffer = options_["device-local"].value == "true";
-
-    vk::DeviceMemory staging_buffer_memory;
-    vk::BufferUsageFlags staging_usage_flags = vk::BufferUsageFlagBits::eVertexBuffer;
-
-    if (use_staging_buffer)
-        staging_usage_flags |= vk::BufferUsageFlagBits::eTransferSrc;
-
-    auto staging_buffer = vkutil::BufferBuilder{*vulkan}
-        .set_size(mesh->vertex_data_size())
-        .set_usage(staging_usage_flags)
-        .set_memory_properties(
-            vk::MemoryPropertyFlagBits::eHostVisible |
-            vk::MemoryPropertyFlagBits::eHostCoherent)
-        .set_memory_out(staging_buffer_memory)
-        .build();
-
-    {
-        auto const staging_buffer_map = vkutil::map_memory(
-            *vulkan, staging_buffer_memory, 0, mesh->vertex_data_size());
-        mesh->copy_vertex_data_to(staging_buffer_map);
-    }
+    vertex_buffer = vkutil::create_vertex_buffer(
+        *vulkan, *mesh, options_["device-local"].value == "true");
+}
 
-    if (use_staging_buffer)
-    {
-        vertex_buffer = vkutil::BufferBuilder{*vulkan}
-            .set_size(mesh->vertex_data_size())
-            .set_usage(
-                vk::BufferUsageFlagBits::eVertexBuffer |
-                vk::BufferUsageFlagBits::eTransferDst)
-            .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
-            .build();
-
-        vkutil::copy_buffer(*vulkan, staging_buffer, vertex_buffer, mesh->vertex_data_size());
-    }
-    else
-    {
-        vertex_buffer = std::move(staging_buffer);
-    }
+void VertexScene::setup_index_buffer()
+{
+    index_buffer = vkutil::create_index_buffer(
+        *vulkan, *mesh, options_["device-local"].value == "true");
 }
 
 void VertexScene::setup_uniform_buffer()
@@ -222,6 +248,7 @@ void VertexScene::setup_render_pass()
     render_pass = vkutil::RenderPassBuilder(*vulkan)
         .set_color_format(format)
         .set_depth_format(depth_format)
+        .set_samples(samples)
         .set_color_load_op(vk::AttachmentLoadOp::eClear)
         .build();
 }
@@ -239,6 +266,7 @@ void VertexScene::setup_pipeline()
         .set_extent(extent)
         .set_layout(pipeline_layout)
         .set_render_pass(render_pass)
+        .set_samples(samples)
         .set_vertex_shader(Util::read_data_file("shaders/light-basic.vert.spv"))
         .set_fragment_shader(Util::read_data_file("shaders/light-basic.frag.spv"))
         .set_vertex_input(mesh->binding_descriptions(), mesh->attribute_descriptions())
@@ -251,6 +279,7 @@ void VertexScene::setup_depth_image()
     depth_image = vkutil::ImageBuilder{*vulkan}
         .set_extent(extent)
         .set_format(depth_format)
+        .set_samples(samples)
         .set_tiling(vk::ImageTiling::eOptimal)
         .set_usage(vk::ImageUsageFlagBits::eDepthStencilAttachment)
         .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
@@ -285,10 +314,14 @@ void VertexScene::setup_framebuffers(std::vector<VulkanImage> const& vulkan_imag
 
     for (auto const& image_view : image_views)
     {
+        auto const attachments = samples == vk::SampleCountFlagBits::e1 ?
+            std::vector<vk::ImageView>{image_view, depth_image_view} :
+            std::vector<vk::ImageView>{color_target.image_view, depth_image_view, image_view};
+
         framebuffers.push_back(
             vkutil::FramebufferBuilder{*vulkan}
                 .set_render_pass(render_pass)
-                .set_image_views({image_view, depth_image_view})
+                .set_image_views(attachments)
                 .set_extent(extent)
                 .build());
     }
@@ -333,7 +366,15 @@ void VertexScene::setup_command_buffers()
             binding_offsets
             );
 
-        command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+        if (mesh->num_indices() > 0)
+        {
+            command_buffers[i].bindIndexBuffer(index_buffer, 0, mesh->index_type());
+            command_buffers[i].drawIndexed(mesh->num_indices(), 1, 0, 0, 0);
+        }
+        else
+        {
+            command_buffers[i].draw(mesh->num_vertices(), 1, 0, 0);
+        }
 
         command_buffers[i].endRenderPass();
         command_buffers[i].end();
@@ -22,9 +22,18 @@
 
 #include <sstream>
 #include <fstream>
+#include <functional>
+#include <thread>
+#include <cstring>
 #include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "util.h"
+#include "log.h"
+#include "lru_cache.h"
 #include <stdexcept>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -35,6 +44,160 @@
 namespace
 {
 std::string data_dir;
+std::string image_cache_dir;
+
+struct CachedImage
+{
+    std::shared_ptr<unsigned char> storage;
+    size_t size;
+    size_t width;
+    size_t height;
+    int64_t mtime_ns;
+};
+
+LruCache<CachedImage> image_cache{256 * 1024 * 1024};
+
+struct CachedDataFile
+{
+    std::vector<char> data;
+    int64_t mtime_ns;
+};
+
+LruCache<CachedDataFile> data_file_cache{64 * 1024 * 1024};
+
+char const image_cache_file_magic[8] = {'v', 'k', 'm', 'a', 'r', 'k', 'i', '1'};
+
+// On-disk layout: header, original image path, padding, RGBA pixel data
+struct ImageCacheFileHeader
+{
+    char magic[8];
+    int64_t mtime_ns;
+    uint64_t width;
+    uint64_t height;
+    uint64_t path_size;
+    uint64_t data_offset;
+};
+
+size_t const image_cache_file_data_alignment = 64;
+
+std::string image_cache_file_path(std::string const& path)
+{
+    std::stringstream ss;
+    ss << image_cache_dir << "/" << std::hex << std::hash<std::string>{}(path) << ".rgba";
+    return ss.str();
+}
+
+bool read_image_cache_file(std::string const& path, int64_t mtime_ns, CachedImage& cached)
+{
+    auto const cache_path = image_cache_file_path(path);
+
+    int const fd = open(cache_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    auto const stat_ret = fstat(fd, &st);
+    auto const map_size = static_cast<size_t>(st.st_size);
+    void* const map = (stat_ret == 0 && map_size >= sizeof(ImageCacheFileHeader)) ?
+        mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+
+    if (map == MAP_FAILED)
+        return false;
+
+    auto const bytes = static_cast<unsigned char*>(map);
+    ImageCacheFileHeader header;
+    memcpy(&header, bytes, sizeof(header));
+
+    auto const valid =
+        !memcmp(header.magic, image_cache_file_magic, sizeof(header.magic)) &&
+        header.mtime_ns == mtime_ns &&
+        header.path_size == path.size() &&
+        sizeof(header) + header.path_size <= header.data_offset &&
+        header.data_offset <= map_size &&
+        header.width * header.height * 4 == map_size - header.data_offset &&
+        !memcmp(bytes + sizeof(header), path.data(), path.size());
+
+    if (!valid)
+    {
+        munmap(map, map_size);
+        return false;
+    }
+
+    cached.storage = std::shared_ptr<unsigned char>{
+        bytes + header.data_offset,
+        [map, map_size] (unsigned char*) { munmap(map, map_size); }};
+    cached.width = header.width;
+    cached.height = header.height;
+    cached.size = cached.width * cached.height * 4;
+    cached.mtime_ns = mtime_ns;
+
+    return true;
+}
+
+void write_image_cache_file(std::string const& path, CachedImage const& cached)
+{
+    auto const cache_path = image_cache_file_path(path);
+    auto const tmp_path = Util::get_temporary_file_path(cache_path);
+
+    ImageCacheFileHeader header;
+    memcpy(header.magic, image_cache_file_magic, sizeof(header.magic));
+    header.mtime_ns = cached.mtime_ns;
+    header.width = cached.width;
+    header.height = cached.height;
+    header.path_size = path.size();
+    header.data_offset =
+        (sizeof(header) + path.size() + image_cache_file_data_alignment - 1) /
+        image_cache_file_data_alignment * image_cache_file_data_alignment;
+
+    std::vector<char> const padding(header.data_offset - sizeof(header) - path.size());
+
+    {
+        std::ofstream ofs{tmp_path, std::ios::binary | std::ios::trunc};
+        ofs.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        ofs.write(path.data(), path.size());
+        ofs.write(padding.data(), padding.size());
+        ofs.write(reinterpret_cast<char const*>(cached.storage.get()), cached.size);
+
+        if (ofs)
+            ofs.close();
+        if (!ofs)
+        {
+            Log::debug("Util: Failed to write image cache file %s\n", tmp_path.c_str());
+            unlink(tmp_path.c_str());
+            return;
+        }
+    }
+
+    // Rename atomically, so that concurrent readers never see partial files
+    if (rename(tmp_path.c_str(), cache_path.c_str()) != 0)
+        unlink(tmp_path.c_str());
+}
+
+CachedImage decode_image_file(std::string const& path, int64_t mtime_ns)
+{
+    int w = 0;
+    int h = 0;
+    int c = 0;
+
+    auto const data = stbi_load(path.c_str(), &w, &h, &c, STBI_rgb_alpha);
+
+    if (!data)
+    {
+        throw std::runtime_error{
+            "Failed to read image file " + path + ": " + stbi_failure_reason()};
+    }
+
+    CachedImage cached;
+    cached.storage = std::shared_ptr<unsigned char>{data, stbi_image_free};
+    cached.width = static_cast<size_t>(w);
+    cached.height = static_cast<size_t>(h);
+    cached.size = cached.width * cached.height * 4;
+    cached.mtime_ns = mtime_ns;
+
+    return cached;
+}
+
 }
 
 std::vector<std::string> Util::split(std::string const& src, char delim)
@@ -64,6 +227,21 @@ uint64_t Util::get_timestamp_us()
     return now;
 }
 
+int64_t Util::get_file_mtime_ns(std::string const& path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+        return -1;
+
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+std::string Util::get_temporary_file_path(std::string const& path)
+{
+    auto const thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return path + ".tmp" + std::to_string(getpid()) + "-" + std::to_string(thread_hash);
+}
+
 void Util::set_data_dir(std::string const& dir)
 {
     data_dir = dir;
@@ -80,6 +258,12 @@ std::string Util::get_data_file_path(std::string const& rel_path)
 std::vector<char> Util::read_data_file(std::string const& rel_path)
 {
     auto const path = get_data_file_path(rel_path);
+    auto const mtime_ns = get_file_mtime_ns(path);
+
+    CachedDataFile cached;
+    if (data_file_cache.find(path, cached) && cached.mtime_ns == mtime_ns)
+        return cached.data;
+
     std::ifstream ifs{path, std::ios::ate | std::ios::binary};
 
     if (!ifs)
@@ -91,6 +275,9 @@ std::vector<char> Util::read_data_file(std::string const& rel_path)
     ifs.seekg(0);
     ifs.read(buffer.data(), file_size);
 
+    if (mtime_ns >= 0)
+        data_file_cache.insert(path, CachedDataFile{buffer, mtime_ns}, buffer.size());
+
     return buffer;
 }
 
@@ -99,29 +286,25 @@ Util::Image::Image()
 {
 }
 
-Util::Image::~Image()
-{
-    if (data)
-        stbi_image_free(data);
-}
+Util::Image::~Image() = default;
 
 Util::Image::Image(Image&& other)
     : data{other.data},
       size{other.size},
       width{other.width},
-      height{other.height}
+      height{other.height},
+      storage{std::move(other.storage)}
 {
     other.data = nullptr;
 }
 
 Util::Image& Util::Image::operator=(Image&& other)
 {
-    if (data)
-        stbi_image_free(data);
     data = other.data;
     size = other.size;
     width = other.width;
     height = other.height;
+    storage = std::move(other.storage);
 
     other.data = nullptr;
 
@@ -131,23 +314,44 @@ Util::Image& Util::Image::operator=(Image&& other)
 Util::Image Util::read_image_file(std::string const& rel_path)
 {
     auto const path = get_data_file_path(rel_path);
+    auto const mtime_ns = get_file_mtime_ns(path);
 
-    int w = 0;
-    int h = 0;
-    int c = 0;
-
-    Image image;
-    image.data = stbi_load(path.c_str(), &w, &h, &c, STBI_rgb_alpha);
+    CachedImage cached;
+    bool found = image_cache.find(path, cached) && cached.mtime_ns == mtime_ns;
 
-    if (!image.data)
+    if (!found)
     {
-        throw std::runtime_error{
-            "Failed to read image file " + path + ": " + stbi_failure_reason()};
+        // Decoding is done without holding the lock, so that images can
+        // be read concurrently
+        found = mtime_ns >= 0 && !image_cache_dir.empty() &&
+                read_image_cache_file(path, mtime_ns, cached);
+
+        if (!found)
+        {
+            cached = decode_image_file(path, mtime_ns);
+            if (mtime_ns >= 0 && !image_cache_dir.empty())
+                write_image_cache_file(path, cached);
+        }
+
+        image_cache.insert(path, cached, cached.size);
     }
 
-    image.width = static_cast<size_t>(w);
-    image.height = static_cast<size_t>(h);
-    image.size = image.width * image.height * 4;
+    Image image;
+    image.storage = cached.storage;
+    image.data = cached.storage.get();
+    image.width = cached.width;
+    image.height = cached.height;
+    image.size = cached.size;
 
     return image;
 }
+
+void Util::set_image_cache_dir(std::string const& dir)
+{
+    image_cache_dir = dir;
+}
+
+void Util::clear_image_cache()
+{
+    image_cache.clear();
+}
@@ -25,7 +25,9 @@
 #include <string>
 #include <vector>
 #include <sstream>
+#include <memory>
 #include <cstdint>
+#include <stdexcept>
 
 namespace Util
 {
@@ -34,8 +36,16 @@ std::vector<std::string> split(std::string const& src, char delim);
 
 uint64_t get_timestamp_us();
 
+// Returns -1 if the file doesn't exist
+int64_t get_file_mtime_ns(std::string const& path);
+// Returns a path next to path that is unique to the calling thread, for
+// writing a file that is then atomically renamed to path
+std::string get_temporary_file_path(std::string const& path);
+
 void set_data_dir(std::string const& path);
 std::string get_data_file_path(std::string const& rel_path);
+// Recently read data files are cached in memory, keyed by path and
+// modification time
 std::vector<char> read_data_file(std::string const& rel_path);
 
 struct Image
@@ -49,9 +59,16 @@ struct Image
     size_t size;
     size_t width;
     size_t height;
+    // Owns the pixel data, which may be shared with the image cache
+    std::shared_ptr<unsigned char> storage;
 };
 
+// Recently decoded images are cached in memory, keyed by path and
+// modification time, and also stored in (and memory-mapped from) the image
+// cache directory, if set
 Image read_image_file(std::string const& rel_path);
+void set_image_cache_dir(std::string const& dir);
+void clear_image_cache();
 
 template<typename T>
 T from_string(std::string const& str)
@@ -62,6 +79,24 @@ T from_string(std::string const& str)
     return ret;
 }
 
+// Parses a numeric option value, throwing if it's not entirely a number
+// between min and max
+template<typename T>
+T ranged_option_value(std::string const& name, std::string const& value, T min, T max)
+{
+    std::stringstream ss{value};
+    T ret{};
+
+    if (!(ss >> ret) || !(ss >> std::ws).eof() || ret < min || ret > max)
+    {
+        throw std::runtime_error(
+            "\"" + name + "\" option must be between " + std::to_string(min) +
+            " and " + std::to_string(max));
+    }
+
+    return ret;
+}
+
 template <typename Init, typename Deinit>
 struct RAIIHelper
 {
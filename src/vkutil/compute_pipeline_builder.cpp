@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compute_pipeline_builder.h"
+
+#include "create_shader_module.h"
+#include "vulkan_state.h"
+
+vkutil::ComputePipelineBuilder::ComputePipelineBuilder(VulkanState& vulkan)
+    : vulkan{vulkan}
+{
+}
+
+vkutil::ComputePipelineBuilder& vkutil::ComputePipelineBuilder::set_shader(
+    std::vector<char> const& spirv)
+{
+    shader_spirv = spirv;
+    return *this;
+}
+
+vkutil::ComputePipelineBuilder& vkutil::ComputePipelineBuilder::set_layout(
+    vk::PipelineLayout layout_)
+{
+    layout = layout_;
+    return *this;
+}
+
+vkutil::ComputePipelineBuilder& vkutil::ComputePipelineBuilder::set_specialization_constants(
+    std::vector<uint32_t> const& values)
+{
+    specialization_constants = values;
+    return *this;
+}
+
+ManagedResource<vk::Pipeline> vkutil::ComputePipelineBuilder::build()
+{
+    auto const shader = create_shader_module(vulkan.device(), shader_spirv);
+
+    std::vector<vk::SpecializationMapEntry> map_entries;
+
+    for (auto i = 0u; i < specialization_constants.size(); ++i)
+    {
+        map_entries.push_back(
+            vk::SpecializationMapEntry{}
+                .setConstantID(i)
+                .setOffset(i * sizeof(uint32_t))
+                .setSize(sizeof(uint32_t)));
+    }
+
+    auto const specialization_info = vk::SpecializationInfo{}
+        .setMapEntryCount(map_entries.size())
+        .setPMapEntries(map_entries.data())
+        .setDataSize(specialization_constants.size() * sizeof(uint32_t))
+        .setPData(specialization_constants.data());
+
+    auto const shader_stage_create_info = vk::PipelineShaderStageCreateInfo{}
+        .setStage(vk::ShaderStageFlagBits::eCompute)
+        .setModule(shader)
+        .setPName("main")
+        .setPSpecializationInfo(
+            specialization_constants.empty() ? nullptr : &specialization_info);
+
+    auto const pipeline_create_info = vk::ComputePipelineCreateInfo{}
+        .setStage(shader_stage_create_info)
+        .setLayout(layout);
+
+    return ManagedResource<vk::Pipeline>{
+#if VK_HEADER_VERSION > 148
+        vulkan.device().createComputePipeline({}, pipeline_create_info).value,
+#else
+        vulkan.device().createComputePipeline({}, pipeline_create_info),
+#endif
+        [vptr=&vulkan] (auto const& p) { vptr->device().destroyPipeline(p); }};
+}
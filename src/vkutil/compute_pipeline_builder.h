@@ -0,0 +1,52 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "managed_resource.h"
+
+class VulkanState;
+
+namespace vkutil
+{
+
+class ComputePipelineBuilder
+{
+public:
+    ComputePipelineBuilder(VulkanState& vulkan);
+
+    ComputePipelineBuilder& set_shader(std::vector<char> const& spirv);
+    ComputePipelineBuilder& set_layout(vk::PipelineLayout layout);
+    // Value i is used for the specialization constant with constant_id i,
+    // e.g. to set the workgroup size with local_size_x_id
+    ComputePipelineBuilder& set_specialization_constants(
+        std::vector<uint32_t> const& values);
+
+    ManagedResource<vk::Pipeline> build();
+
+private:
+    VulkanState& vulkan;
+    std::vector<char> shader_spirv;
+    vk::PipelineLayout layout;
+    std::vector<uint32_t> specialization_constants;
+};
+
+}
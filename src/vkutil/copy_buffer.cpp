@@ -65,3 +65,17 @@ void vkutil::copy_buffer_to_image(
 
     otcb.submit();
 }
+
+void vkutil::copy_buffer_to_image(
+    VulkanState& vulkan,
+    vk::Buffer src,
+    vk::Image dst,
+    std::vector<vk::BufferImageCopy> const& regions)
+{
+    OneTimeCommandBuffer otcb{vulkan};
+
+    otcb.command_buffer().copyBufferToImage(
+        src, dst, vk::ImageLayout::eTransferDstOptimal, regions);
+
+    otcb.submit();
+}
@@ -41,4 +41,10 @@ void copy_buffer_to_image(
     vk::Image dst,
     vk::Extent2D extent);
 
+void copy_buffer_to_image(
+    VulkanState& vulkan,
+    vk::Buffer src,
+    vk::Image dst,
+    std::vector<vk::BufferImageCopy> const& regions);
+
 }
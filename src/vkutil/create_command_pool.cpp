@@ -0,0 +1,33 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "create_command_pool.h"
+
+#include "vulkan_state.h"
+
+ManagedResource<vk::CommandPool> vkutil::create_command_pool(VulkanState& vulkan)
+{
+    auto const command_pool_create_info = vk::CommandPoolCreateInfo{}
+        .setQueueFamilyIndex(vulkan.graphics_queue_family_index())
+        .setFlags(vk::CommandPoolCreateFlagBits::eTransient);
+
+    return ManagedResource<vk::CommandPool>{
+        vulkan.device().createCommandPool(command_pool_create_info),
+        [vptr=&vulkan] (auto const& cp) { vptr->device().destroyCommandPool(cp); }};
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "create_device_local_buffer.h"
+
+#include "buffer_builder.h"
+#include "map_memory.h"
+#include "one_time_command_buffer.h"
+#include "vulkan_state.h"
+
+ManagedResource<vk::Buffer> vkutil::create_device_local_buffer(
+    VulkanState& vulkan,
+    size_t size,
+    vk::BufferUsageFlags usage,
+    std::function<void(void*)> const& fill)
+{
+    return create_device_local_buffer(
+        vulkan, size, usage, fill, vulkan.command_pool(), vulkan.graphics_queue());
+}
+
+ManagedResource<vk::Buffer> vkutil::create_device_local_buffer(
+    VulkanState& vulkan,
+    size_t size,
+    vk::BufferUsageFlags usage,
+    std::function<void(void*)> const& fill,
+    vk::CommandPool command_pool,
+    vk::Queue queue)
+{
+    vk::DeviceMemory staging_buffer_memory;
+
+    auto const staging_buffer = BufferBuilder{vulkan}
+        .set_size(size)
+        .set_usage(vk::BufferUsageFlagBits::eTransferSrc)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(staging_buffer_memory)
+        .build();
+
+    {
+        auto const staging_buffer_map = map_memory(
+            vulkan, staging_buffer_memory, 0, size);
+        fill(staging_buffer_map);
+    }
+
+    auto buffer = BufferBuilder{vulkan}
+        .set_size(size)
+        .set_usage(usage | vk::BufferUsageFlagBits::eTransferDst)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .build();
+
+    OneTimeCommandBuffer otcb{vulkan, command_pool, queue};
+    otcb.command_buffer().copyBuffer(staging_buffer, buffer, vk::BufferCopy{}.setSize(size));
+    otcb.submit();
+
+    return buffer;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "managed_resource.h"
+
+#include <functional>
+
+class VulkanState;
+
+namespace vkutil
+{
+
+// Creates a device local buffer whose contents are written by the fill
+// callback into a host visible staging buffer and then copied over
+ManagedResource<vk::Buffer> create_device_local_buffer(
+    VulkanState& vulkan,
+    size_t size,
+    vk::BufferUsageFlags usage,
+    std::function<void(void*)> const& fill);
+
+// As above, but copying with a command buffer allocated from command_pool and
+// submitted to queue, for buffers that are only used on that queue
+ManagedResource<vk::Buffer> create_device_local_buffer(
+    VulkanState& vulkan,
+    size_t size,
+    vk::BufferUsageFlags usage,
+    std::function<void(void*)> const& fill,
+    vk::CommandPool command_pool,
+    vk::Queue queue);
+
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "create_mesh_buffers.h"
+
+#include "buffer_builder.h"
+#include "create_device_local_buffer.h"
+#include "map_memory.h"
+#include "mesh.h"
+
+namespace
+{
+
+ManagedResource<vk::Buffer> create_buffer(
+    VulkanState& vulkan,
+    size_t size,
+    vk::BufferUsageFlags usage,
+    bool device_local,
+    std::function<void(void*)> const& fill)
+{
+    if (device_local)
+        return vkutil::create_device_local_buffer(vulkan, size, usage, fill);
+
+    vk::DeviceMemory buffer_memory;
+
+    auto buffer = vkutil::BufferBuilder{vulkan}
+        .set_size(size)
+        .set_usage(usage)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(buffer_memory)
+        .build();
+
+    auto const buffer_map = vkutil::map_memory(vulkan, buffer_memory, 0, size);
+    fill(buffer_map.raw);
+
+    return buffer;
+}
+
+}
+
+ManagedResource<vk::Buffer> vkutil::create_vertex_buffer(
+    VulkanState& vulkan, Mesh const& mesh, bool device_local)
+{
+    return create_buffer(
+        vulkan, mesh.vertex_data_size(),
+        vk::BufferUsageFlagBits::eVertexBuffer, device_local,
+        [&mesh] (void* dst) { mesh.copy_vertex_data_to(dst); });
+}
+
+ManagedResource<vk::Buffer> vkutil::create_index_buffer(
+    VulkanState& vulkan, Mesh const& mesh, bool device_local)
+{
+    if (mesh.num_indices() == 0)
+        return {};
+
+    return create_buffer(
+        vulkan, mesh.index_data_size(),
+        vk::BufferUsageFlagBits::eIndexBuffer, device_local,
+        [&mesh] (void* dst) { mesh.copy_index_data_to(dst); });
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "managed_resource.h"
+
+class Mesh;
+class VulkanState;
+
+namespace vkutil
+{
+
+// Create buffers holding the vertex and index data of a mesh, in device local
+// memory or, if device_local is false, in host visible memory. The index
+// buffer is empty for meshes without indices.
+ManagedResource<vk::Buffer> create_vertex_buffer(
+    VulkanState& vulkan, Mesh const& mesh, bool device_local = true);
+ManagedResource<vk::Buffer> create_index_buffer(
+    VulkanState& vulkan, Mesh const& mesh, bool device_local = true);
+
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "create_shader_module.h"
+
+#include <cstring>
+
+ManagedResource<vk::ShaderModule> vkutil::create_shader_module(
+    vk::Device const& device, std::vector<char> const& spirv)
+{
+    std::vector<uint32_t> code_aligned(spirv.size() / 4 + 1);
+    memcpy(code_aligned.data(), spirv.data(), spirv.size());
+
+    auto const shader_module_create_info = vk::ShaderModuleCreateInfo{}
+        .setCodeSize(spirv.size())
+        .setPCode(code_aligned.data());
+
+    return ManagedResource<vk::ShaderModule>{
+        device.createShaderModule(shader_module_create_info),
+        [dptr=&device] (auto const& sm) { dptr->destroyShaderModule(sm); }};
+}
@@ -30,7 +30,8 @@ vkutil::DescriptorSetBuilder::Info::Info()
       offset{0},
       range{0},
       image_view{nullptr},
-      sampler{nullptr}
+      sampler{nullptr},
+      image_layout{vk::ImageLayout::eShaderReadOnlyOptimal}
 {
 }
 
@@ -72,6 +73,14 @@ vkutil::DescriptorSetBuilder& vkutil::DescriptorSetBuilder::set_image_view(
     return *this;
 }
 
+vkutil::DescriptorSetBuilder& vkutil::DescriptorSetBuilder::set_image_view(
+    vk::ImageView& image_view, vk::ImageLayout layout)
+{
+    info.back().image_view = &image_view;
+    info.back().image_layout = layout;
+    return *this;
+}
+
 vkutil::DescriptorSetBuilder& vkutil::DescriptorSetBuilder::set_layout_out(
     vk::DescriptorSetLayout& layout_out)
 {
@@ -161,9 +170,9 @@ ManagedResource<vk::DescriptorSet> vkutil::DescriptorSetBuilder::build()
         else if (info[i].image_view)
         {
             descriptor_image_infos[i]
-                .setImageLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+                .setImageLayout(info[i].image_layout)
                 .setImageView(*info[i].image_view)
-                .setSampler(*info[i].sampler);
+                .setSampler(info[i].sampler ? *info[i].sampler : vk::Sampler{});
 
             write_descriptor_sets[i].setPImageInfo(&descriptor_image_infos[i]);
         }
@@ -40,6 +40,8 @@ public:
     DescriptorSetBuilder& set_stage_flags(vk::ShaderStageFlags stage_flags);
     DescriptorSetBuilder& set_buffer(vk::Buffer& buffer_, size_t offset_, size_t range_);
     DescriptorSetBuilder& set_image_view(vk::ImageView& image_view, vk::Sampler& sampler);
+    // For images accessed without a sampler, e.g. storage images
+    DescriptorSetBuilder& set_image_view(vk::ImageView& image_view, vk::ImageLayout layout);
     DescriptorSetBuilder& set_layout_out(vk::DescriptorSetLayout& layout_out);
     DescriptorSetBuilder& next_binding();
 
@@ -58,6 +60,7 @@ private:
         size_t range;
         vk::ImageView* image_view;
         vk::Sampler* sampler;
+        vk::ImageLayout image_layout;
     };
 
     std::vector<Info> info;
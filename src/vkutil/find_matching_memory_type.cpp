@@ -28,6 +28,20 @@ uint32_t vkutil::find_matching_memory_type(
     VulkanState& vulkan,
     vk::MemoryRequirements const& requirements,
     vk::MemoryPropertyFlags const& memory_properties)
+{
+    uint32_t memory_type_index;
+
+    if (!try_find_matching_memory_type(vulkan, requirements, memory_properties, memory_type_index))
+        throw std::runtime_error("Couldn't find matching memory type");
+
+    return memory_type_index;
+}
+
+bool vkutil::try_find_matching_memory_type(
+    VulkanState& vulkan,
+    vk::MemoryRequirements const& requirements,
+    vk::MemoryPropertyFlags const& memory_properties,
+    uint32_t& memory_type_index)
 {
     auto const properties = vulkan.physical_device().getMemoryProperties();
 
@@ -36,9 +50,10 @@ uint32_t vkutil::find_matching_memory_type(
         if ((requirements.memoryTypeBits & (1 << i)) &&
             (properties.memoryTypes[i].propertyFlags & memory_properties) == memory_properties)
         {
-            return i;
+            memory_type_index = i;
+            return true;
         }
     }
 
-    throw std::runtime_error("Couldn't find matching memory type");
+    return false;
 }
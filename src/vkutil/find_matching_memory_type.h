@@ -34,4 +34,12 @@ uint32_t find_matching_memory_type(
     vk::MemoryRequirements const& requirements,
     vk::MemoryPropertyFlags const& memory_properties);
 
+// As above, but returns false instead of throwing if there is no matching
+// memory type
+bool try_find_matching_memory_type(
+    VulkanState& vulkan,
+    vk::MemoryRequirements const& requirements,
+    vk::MemoryPropertyFlags const& memory_properties,
+    uint32_t& memory_type_index);
+
 }
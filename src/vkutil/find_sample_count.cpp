@@ -0,0 +1,53 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "find_sample_count.h"
+
+#include "vulkan_state.h"
+
+#include <stdexcept>
+#include <string>
+
+vk::SampleCountFlagBits vkutil::find_sample_count(VulkanState& vulkan, uint32_t samples)
+{
+    vk::SampleCountFlagBits sample_count;
+
+    switch (samples)
+    {
+        case 1: sample_count = vk::SampleCountFlagBits::e1; break;
+        case 2: sample_count = vk::SampleCountFlagBits::e2; break;
+        case 4: sample_count = vk::SampleCountFlagBits::e4; break;
+        case 8: sample_count = vk::SampleCountFlagBits::e8; break;
+        default:
+            throw std::runtime_error(
+                "Unsupported number of samples " + std::to_string(samples));
+    }
+
+    auto const& limits = vulkan.physical_device().getProperties().limits;
+    auto const supported = limits.framebufferColorSampleCounts &
+                           limits.framebufferDepthSampleCounts;
+
+    if (!(supported & sample_count))
+    {
+        throw std::runtime_error(
+            std::to_string(samples) + " samples per pixel are not supported by the device");
+    }
+
+    return sample_count;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "generate_mipmaps.h"
+#include "one_time_command_buffer.h"
+
+#include <algorithm>
+
+void vkutil::generate_mipmaps(
+    VulkanState& vulkan,
+    vk::Image image,
+    vk::Extent2D extent,
+    uint32_t mip_levels)
+{
+    OneTimeCommandBuffer otcb{vulkan};
+    auto const command_buffer = otcb.command_buffer();
+
+    auto barrier = vk::ImageMemoryBarrier{}
+        .setImage(image)
+        .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+        .setSubresourceRange(
+            vk::ImageSubresourceRange{}
+                .setAspectMask(vk::ImageAspectFlagBits::eColor)
+                .setBaseMipLevel(0)
+                .setLevelCount(1)
+                .setBaseArrayLayer(0)
+                .setLayerCount(1));
+
+    auto width = static_cast<int32_t>(extent.width);
+    auto height = static_cast<int32_t>(extent.height);
+
+    for (uint32_t level = 1; level < mip_levels; ++level)
+    {
+        auto const next_width = std::max(width / 2, 1);
+        auto const next_height = std::max(height / 2, 1);
+
+        // Make the previous level available as the blit source
+        barrier.subresourceRange.setBaseMipLevel(level - 1);
+        barrier
+            .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eTransferRead);
+
+        command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eTransfer,
+            {}, {}, {},
+            barrier);
+
+        auto const blit = vk::ImageBlit{}
+            .setSrcSubresource(
+                vk::ImageSubresourceLayers{}
+                    .setAspectMask(vk::ImageAspectFlagBits::eColor)
+                    .setMipLevel(level - 1)
+                    .setBaseArrayLayer(0)
+                    .setLayerCount(1))
+            .setSrcOffsets({{vk::Offset3D{0, 0, 0}, vk::Offset3D{width, height, 1}}})
+            .setDstSubresource(
+                vk::ImageSubresourceLayers{}
+                    .setAspectMask(vk::ImageAspectFlagBits::eColor)
+                    .setMipLevel(level)
+                    .setBaseArrayLayer(0)
+                    .setLayerCount(1))
+            .setDstOffsets({{vk::Offset3D{0, 0, 0}, vk::Offset3D{next_width, next_height, 1}}});
+
+        command_buffer.blitImage(
+            image, vk::ImageLayout::eTransferSrcOptimal,
+            image, vk::ImageLayout::eTransferDstOptimal,
+            blit, vk::Filter::eLinear);
+
+        // The previous level is now final
+        barrier
+            .setOldLayout(vk::ImageLayout::eTransferSrcOptimal)
+            .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferRead)
+            .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+
+        command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eFragmentShader,
+            {}, {}, {},
+            barrier);
+
+        width = next_width;
+        height = next_height;
+    }
+
+    // The last level is only ever written to
+    barrier.subresourceRange.setBaseMipLevel(mip_levels - 1);
+    barrier
+        .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+
+    command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eFragmentShader,
+        {}, {}, {},
+        barrier);
+
+    otcb.submit();
+}
+
+uint32_t vkutil::mip_levels_for_extent(vk::Extent2D extent)
+{
+    uint32_t levels = 1;
+    auto size = std::max(extent.width, extent.height);
+
+    while (size > 1)
+    {
+        size /= 2;
+        ++levels;
+    }
+
+    return levels;
+}
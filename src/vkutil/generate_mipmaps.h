@@ -0,0 +1,39 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+class VulkanState;
+
+namespace vkutil
+{
+
+// Expects all levels of the image in TransferDstOptimal layout with level 0
+// populated, and leaves all levels in ShaderReadOnlyOptimal layout.
+void generate_mipmaps(
+    VulkanState& vulkan,
+    vk::Image image,
+    vk::Extent2D extent,
+    uint32_t mip_levels);
+
+uint32_t mip_levels_for_extent(vk::Extent2D extent);
+
+}
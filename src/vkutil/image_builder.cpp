@@ -28,8 +28,11 @@
 vkutil::ImageBuilder::ImageBuilder(VulkanState& vulkan)
     : vulkan{vulkan},
       format{vk::Format::eUndefined},
+      mip_levels{1},
+      samples{vk::SampleCountFlagBits::e1},
       tiling{vk::ImageTiling::eOptimal},
-      initial_layout{vk::ImageLayout::eUndefined}
+      initial_layout{vk::ImageLayout::eUndefined},
+      memory_out_ptr{nullptr}
 {
 }
 
@@ -45,6 +48,18 @@ vkutil::ImageBuilder& vkutil::ImageBuilder::set_format(vk::Format format_)
     return *this;
 }
 
+vkutil::ImageBuilder& vkutil::ImageBuilder::set_mip_levels(uint32_t mip_levels_)
+{
+    mip_levels = mip_levels_;
+    return *this;
+}
+
+vkutil::ImageBuilder& vkutil::ImageBuilder::set_samples(vk::SampleCountFlagBits samples_)
+{
+    samples = samples_;
+    return *this;
+}
+
 vkutil::ImageBuilder& vkutil::ImageBuilder::set_tiling(vk::ImageTiling tiling_)
 {
     tiling = tiling_;
@@ -70,18 +85,25 @@ vkutil::ImageBuilder& vkutil::ImageBuilder::set_initial_layout(vk::ImageLayout i
     return *this;
 }
 
+vkutil::ImageBuilder& vkutil::ImageBuilder::set_memory_out(
+    vk::DeviceMemory& memory_out)
+{
+    memory_out_ptr = &memory_out;
+    return *this;
+}
+
 ManagedResource<vk::Image> vkutil::ImageBuilder::build()
 {
     auto const image_create_info = vk::ImageCreateInfo{}
         .setImageType(vk::ImageType::e2D)
         .setExtent({extent.width, extent.height, 1})
-        .setMipLevels(1)
+        .setMipLevels(mip_levels)
         .setArrayLayers(1)
         .setFormat(format)
         .setTiling(tiling)
         .setInitialLayout(initial_layout)
         .setUsage(usage)
-        .setSamples(vk::SampleCountFlagBits::e1)
+        .setSamples(samples)
         .setSharingMode(vk::SharingMode::eExclusive);
 
     auto vk_image = ManagedResource<vk::Image>{
@@ -89,8 +111,17 @@ ManagedResource<vk::Image> vkutil::ImageBuilder::build()
         [vptr=&vulkan] (auto const& i) { vptr->device().destroyImage(i); }};
 
     auto const req = vulkan.device().getImageMemoryRequirements(vk_image);
-    auto const memory_type_index = vkutil::find_matching_memory_type(
-        vulkan, req, memory_properties);
+    // Transient attachments never leave the render pass, so prefer lazily
+    // allocated memory for them, which tiled GPUs may never back at all
+    uint32_t memory_type_index;
+    if (!(usage & vk::ImageUsageFlagBits::eTransientAttachment) ||
+        !vkutil::try_find_matching_memory_type(
+            vulkan, req, memory_properties | vk::MemoryPropertyFlagBits::eLazilyAllocated,
+            memory_type_index))
+    {
+        memory_type_index = vkutil::find_matching_memory_type(
+            vulkan, req, memory_properties);
+    }
 
     auto const memory_allocate_info = vk::MemoryAllocateInfo{}
         .setAllocationSize(req.size)
@@ -102,6 +133,9 @@ ManagedResource<vk::Image> vkutil::ImageBuilder::build()
 
     vulkan.device().bindImageMemory(vk_image, vk_mem, 0);
 
+    if (memory_out_ptr)
+        *memory_out_ptr = vk_mem.raw;
+
     return ManagedResource<vk::Image>{
         vk_image.steal(),
         [vptr=&vulkan, mem=vk_mem.steal()]
@@ -38,10 +38,13 @@ public:
 
     ImageBuilder& set_extent(vk::Extent2D extent);
     ImageBuilder& set_format(vk::Format format);
+    ImageBuilder& set_mip_levels(uint32_t mip_levels);
+    ImageBuilder& set_samples(vk::SampleCountFlagBits samples);
     ImageBuilder& set_tiling(vk::ImageTiling tiling);
     ImageBuilder& set_usage(vk::ImageUsageFlags usage);
     ImageBuilder& set_memory_properties(vk::MemoryPropertyFlags memory_properties);
     ImageBuilder& set_initial_layout(vk::ImageLayout initial_layout);
+    ImageBuilder& set_memory_out(vk::DeviceMemory& memory_out);
 
     ManagedResource<vk::Image> build();
 
@@ -49,10 +52,13 @@ private:
     VulkanState& vulkan;
     vk::Extent2D extent;
     vk::Format format;
+    uint32_t mip_levels;
+    vk::SampleCountFlagBits samples;
     vk::ImageTiling tiling;
     vk::ImageUsageFlags usage;
     vk::MemoryPropertyFlags memory_properties;
     vk::ImageLayout initial_layout;
+    vk::DeviceMemory* memory_out_ptr;
 };
 
 }
@@ -26,7 +26,8 @@
 
 vkutil::ImageViewBuilder::ImageViewBuilder(VulkanState& vulkan)
     : vulkan{vulkan},
-      format{vk::Format::eUndefined}
+      format{vk::Format::eUndefined},
+      mip_levels{1}
 {
 }
 
@@ -49,12 +50,18 @@ vkutil::ImageViewBuilder& vkutil::ImageViewBuilder::set_aspect_mask(
     return *this;
 }
 
+vkutil::ImageViewBuilder& vkutil::ImageViewBuilder::set_mip_levels(uint32_t mip_levels_)
+{
+    mip_levels = mip_levels_;
+    return *this;
+}
+
 ManagedResource<vk::ImageView> vkutil::ImageViewBuilder::build()
 {
     auto const image_subresource_range = vk::ImageSubresourceRange{}
         .setAspectMask(aspect_mask)
         .setBaseMipLevel(0)
-        .setLevelCount(1)
+        .setLevelCount(mip_levels)
         .setBaseArrayLayer(0)
         .setLayerCount(1);
 
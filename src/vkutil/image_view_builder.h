@@ -39,6 +39,7 @@ public:
     ImageViewBuilder& set_image(vk::Image image);
     ImageViewBuilder& set_format(vk::Format format);
     ImageViewBuilder& set_aspect_mask(vk::ImageAspectFlags mask);
+    ImageViewBuilder& set_mip_levels(uint32_t mip_levels);
 
     ManagedResource<vk::ImageView> build();
 
@@ -47,6 +48,7 @@ private:
     vk::Image image;
     vk::Format format;
     vk::ImageAspectFlags aspect_mask;
+    uint32_t mip_levels;
 };
 
 }
@@ -0,0 +1,54 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "msaa_color_target.h"
+
+#include "image_builder.h"
+#include "image_view_builder.h"
+
+vkutil::MsaaColorTarget vkutil::create_msaa_color_target(
+    VulkanState& vulkan,
+    vk::Extent2D extent,
+    vk::Format format,
+    vk::SampleCountFlagBits samples)
+{
+    MsaaColorTarget target;
+
+    if (samples == vk::SampleCountFlagBits::e1)
+        return target;
+
+    target.image = ImageBuilder{vulkan}
+        .set_extent(extent)
+        .set_format(format)
+        .set_samples(samples)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(vk::ImageUsageFlagBits::eColorAttachment |
+                   vk::ImageUsageFlagBits::eTransientAttachment)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    target.image_view = ImageViewBuilder{vulkan}
+        .set_image(target.image)
+        .set_format(format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+        .build();
+
+    return target;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "managed_resource.h"
+
+class VulkanState;
+
+namespace vkutil
+{
+
+struct MsaaColorTarget
+{
+    ManagedResource<vk::Image> image;
+    ManagedResource<vk::ImageView> image_view;
+};
+
+// Creates the transient multisampled color attachment that is rendered to and
+// then resolved to the presented image. With a single sample no target is
+// needed, and an empty one is returned.
+MsaaColorTarget create_msaa_color_target(
+    VulkanState& vulkan,
+    vk::Extent2D extent,
+    vk::Format format,
+    vk::SampleCountFlagBits samples);
+
+}
@@ -27,18 +27,19 @@
 namespace
 {
 
-ManagedResource<vk::CommandBuffer> create_command_buffer(VulkanState& vulkan)
+ManagedResource<vk::CommandBuffer> create_command_buffer(
+    VulkanState& vulkan, vk::CommandPool command_pool)
 {
     auto const command_buffer_allocate_info = vk::CommandBufferAllocateInfo{}
-        .setCommandPool(vulkan.command_pool())
+        .setCommandPool(command_pool)
         .setCommandBufferCount(1)
         .setLevel(vk::CommandBufferLevel::ePrimary);
 
     return ManagedResource<vk::CommandBuffer>{
         std::move(vulkan.device().allocateCommandBuffers(command_buffer_allocate_info)[0]),
-        [&vulkan] (auto const& cb)
+        [&vulkan, command_pool] (auto const& cb)
         {
-            vulkan.device().freeCommandBuffers(vulkan.command_pool(), cb);
+            vulkan.device().freeCommandBuffers(command_pool, cb);
         }};
 }
 
@@ -46,8 +47,17 @@ ManagedResource<vk::CommandBuffer> create_command_buffer(VulkanState& vulkan)
 
 vkutil::OneTimeCommandBuffer::OneTimeCommandBuffer(
     VulkanState& vulkan)
+    : OneTimeCommandBuffer{vulkan, vulkan.command_pool(), vulkan.graphics_queue()}
+{
+}
+
+vkutil::OneTimeCommandBuffer::OneTimeCommandBuffer(
+    VulkanState& vulkan,
+    vk::CommandPool command_pool,
+    vk::Queue queue)
     : vulkan{vulkan},
-      command_buffer_{create_command_buffer(vulkan)}
+      queue{queue},
+      command_buffer_{create_command_buffer(vulkan, command_pool)}
 {
     auto const begin_info = vk::CommandBufferBeginInfo{}
         .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
@@ -68,7 +78,7 @@ void vkutil::OneTimeCommandBuffer::submit()
         .setCommandBufferCount(1)
         .setPCommandBuffers(&command_buffer_.raw);
 
-    vulkan.graphics_queue().submit(submit_info, {});
+    queue.submit(submit_info, {});
 
     vulkan.device().waitIdle();
 }
@@ -35,12 +35,18 @@ class OneTimeCommandBuffer
 {
 public:
     OneTimeCommandBuffer(VulkanState& vulkan);
+    // Allocates the command buffer from command_pool and submits it to queue,
+    // instead of using the graphics queue
+    OneTimeCommandBuffer(VulkanState& vulkan,
+                         vk::CommandPool command_pool,
+                         vk::Queue queue);
 
     vk::CommandBuffer command_buffer() const;
     void submit();
 
 private:
     VulkanState& vulkan;
+    vk::Queue const queue;
     ManagedResource<vk::CommandBuffer> command_buffer_;
 };
 
@@ -22,32 +22,24 @@
 
 #include "pipeline_builder.h"
 
+#include "create_shader_module.h"
 #include "vulkan_state.h"
 
-namespace
-{
-
-ManagedResource<vk::ShaderModule> create_shader_module(
-    vk::Device const& device, std::vector<char> const& code)
-{
-    std::vector<uint32_t> code_aligned(code.size() / 4 + 1);
-    memcpy(code_aligned.data(), code.data(), code.size());
-
-    auto const shader_module_create_info = vk::ShaderModuleCreateInfo{}
-        .setCodeSize(code.size())
-        .setPCode(code_aligned.data());
-
-    return ManagedResource<vk::ShaderModule>{
-        device.createShaderModule(shader_module_create_info),
-        [dptr=&device] (auto const& sm) { dptr->destroyShaderModule(sm); }};
-}
-
-}
-
 vkutil::PipelineBuilder::PipelineBuilder(VulkanState& vulkan)
     : vulkan{vulkan},
       depth_test{false},
-      blend{false}
+      depth_bias_constant_factor{0.0f},
+      depth_bias_slope_factor{0.0f},
+      blend{false},
+      src_color_blend_factor{vk::BlendFactor::eSrcAlpha},
+      dst_color_blend_factor{vk::BlendFactor::eOneMinusSrcAlpha},
+      src_alpha_blend_factor{vk::BlendFactor::eOne},
+      dst_alpha_blend_factor{vk::BlendFactor::eZero},
+      color_blend_op{vk::BlendOp::eAdd},
+      alpha_blend_op{vk::BlendOp::eAdd},
+      subpass{0},
+      color_attachment_count{1},
+      samples{vk::SampleCountFlagBits::e1}
 {
 }
 
@@ -80,6 +72,14 @@ vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_depth_test(bool depth_test
     return *this;
 }
 
+vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_depth_bias(
+    float constant_factor, float slope_factor)
+{
+    depth_bias_constant_factor = constant_factor;
+    depth_bias_slope_factor = slope_factor;
+    return *this;
+}
+
 vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_extent(vk::Extent2D extent_)
 {
     extent = extent_;
@@ -98,25 +98,111 @@ vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_render_pass(vk::RenderPass
     return *this;
 }
 
+vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_subpass(uint32_t subpass_)
+{
+    subpass = subpass_;
+    return *this;
+}
+
+vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_color_attachment_count(uint32_t count)
+{
+    color_attachment_count = count;
+    return *this;
+}
+
+vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_samples(vk::SampleCountFlagBits samples_)
+{
+    samples = samples_;
+    return *this;
+}
+
 vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_blend(bool blend_)
 {
     blend = blend_;
     return *this;
 }
 
+vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_blend_factors(
+    vk::BlendFactor src_color, vk::BlendFactor dst_color,
+    vk::BlendFactor src_alpha, vk::BlendFactor dst_alpha)
+{
+    src_color_blend_factor = src_color;
+    dst_color_blend_factor = dst_color;
+    src_alpha_blend_factor = src_alpha;
+    dst_alpha_blend_factor = dst_alpha;
+    return *this;
+}
+
+vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_blend_op(
+    vk::BlendOp color_op, vk::BlendOp alpha_op)
+{
+    color_blend_op = color_op;
+    alpha_blend_op = alpha_op;
+    return *this;
+}
+
+vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_specialization_constants(
+    std::vector<uint32_t> const& values)
+{
+    specialization_constants = values;
+    return *this;
+}
+
+vkutil::PipelineBuilder& vkutil::PipelineBuilder::set_pipeline_cache(
+    vk::PipelineCache pipeline_cache_)
+{
+    pipeline_cache = pipeline_cache_;
+    return *this;
+}
+
 ManagedResource<vk::Pipeline> vkutil::PipelineBuilder::build()
 {
+    for (auto const& attribute : attribute_descriptions)
+    {
+        auto const format_props =
+            vulkan.physical_device().getFormatProperties(attribute.format);
+
+        if (!(format_props.bufferFeatures & vk::FormatFeatureFlagBits::eVertexBuffer))
+            throw std::runtime_error{"Vertex format " + vk::to_string(attribute.format) +
+                                     " is not supported by the device"};
+    }
+
+    bool const use_fragment_shader = !fragment_shader_spirv.empty();
+
     auto const vertex_shader = create_shader_module(vulkan.device(), vertex_shader_spirv);
-    auto const fragment_shader = create_shader_module(vulkan.device(), fragment_shader_spirv);
+    auto const fragment_shader = use_fragment_shader ?
+        create_shader_module(vulkan.device(), fragment_shader_spirv) :
+        ManagedResource<vk::ShaderModule>{};
+
+    std::vector<vk::SpecializationMapEntry> map_entries;
+
+    for (auto i = 0u; i < specialization_constants.size(); ++i)
+    {
+        map_entries.push_back(
+            vk::SpecializationMapEntry{}
+                .setConstantID(i)
+                .setOffset(i * sizeof(uint32_t))
+                .setSize(sizeof(uint32_t)));
+    }
+
+    auto const specialization_info = vk::SpecializationInfo{}
+        .setMapEntryCount(map_entries.size())
+        .setPMapEntries(map_entries.data())
+        .setDataSize(specialization_constants.size() * sizeof(uint32_t))
+        .setPData(specialization_constants.data());
+    auto const specialization_info_ptr =
+        specialization_constants.empty() ? nullptr : &specialization_info;
 
     auto const vertex_shader_stage_create_info = vk::PipelineShaderStageCreateInfo{}
         .setStage(vk::ShaderStageFlagBits::eVertex)
         .setModule(vertex_shader)
-        .setPName("main");
+        .setPName("main")
+        .setPSpecializationInfo(specialization_info_ptr);
     auto const fragment_shader_stage_create_info = vk::PipelineShaderStageCreateInfo{}
         .setStage(vk::ShaderStageFlagBits::eFragment)
         .setModule(fragment_shader)
-        .setPName("main");
+        .setPName("main")
+        .setPSpecializationInfo(specialization_info_ptr);
 
     vk::PipelineShaderStageCreateInfo shader_stages[] = {
         vertex_shader_stage_create_info,
@@ -155,11 +241,14 @@ ManagedResource<vk::Pipeline> vkutil::PipelineBuilder::build()
         .setLineWidth(1.0f)
         .setCullMode(vk::CullModeFlagBits::eBack)
         .setFrontFace(vk::FrontFace::eCounterClockwise)
-        .setDepthBiasEnable(false);
+        .setDepthBiasEnable(depth_bias_constant_factor != 0.0f ||
+                            depth_bias_slope_factor != 0.0f)
+        .setDepthBiasConstantFactor(depth_bias_constant_factor)
+        .setDepthBiasSlopeFactor(depth_bias_slope_factor);
 
     auto const multisample_state_create_info = vk::PipelineMultisampleStateCreateInfo{}
         .setSampleShadingEnable(false)
-        .setRasterizationSamples(vk::SampleCountFlagBits::e1);
+        .setRasterizationSamples(samples);
 
     auto const blend_attach = vk::PipelineColorBlendAttachmentState{}
         .setColorWriteMask(
@@ -168,17 +257,20 @@ ManagedResource<vk::Pipeline> vkutil::PipelineBuilder::build()
             vk::ColorComponentFlagBits::eB |
             vk::ColorComponentFlagBits::eA)
         .setBlendEnable(blend)
-        .setSrcColorBlendFactor(vk::BlendFactor::eSrcAlpha)
-        .setDstColorBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)
-        .setColorBlendOp(vk::BlendOp::eAdd)
-        .setSrcAlphaBlendFactor(vk::BlendFactor::eOne)
-        .setDstAlphaBlendFactor(vk::BlendFactor::eZero)
-        .setAlphaBlendOp(vk::BlendOp::eAdd);
+        .setSrcColorBlendFactor(src_color_blend_factor)
+        .setDstColorBlendFactor(dst_color_blend_factor)
+        .setColorBlendOp(color_blend_op)
+        .setSrcAlphaBlendFactor(src_alpha_blend_factor)
+        .setDstAlphaBlendFactor(dst_alpha_blend_factor)
+        .setAlphaBlendOp(alpha_blend_op);
+
+    std::vector<vk::PipelineColorBlendAttachmentState> const blend_attachments(
+        use_fragment_shader ? color_attachment_count : 0, blend_attach);
 
     auto const color_blend_state_create_info = vk::PipelineColorBlendStateCreateInfo{}
         .setLogicOpEnable(false)
-        .setAttachmentCount(1)
-        .setPAttachments(&blend_attach);
+        .setAttachmentCount(blend_attachments.size())
+        .setPAttachments(blend_attachments.data());
 
     auto const depth_stencil_state_create_info = vk::PipelineDepthStencilStateCreateInfo{}
         .setDepthTestEnable(depth_test)
@@ -188,7 +280,7 @@ ManagedResource<vk::Pipeline> vkutil::PipelineBuilder::build()
         .setStencilTestEnable(false);
 
     auto pipeline_create_info = vk::GraphicsPipelineCreateInfo{}
-        .setStageCount(2)
+        .setStageCount(use_fragment_shader ? 2 : 1)
         .setPStages(shader_stages)
         .setPVertexInputState(&vertex_input_state_create_info)
         .setPInputAssemblyState(&input_assembly_state_create_info)
@@ -199,13 +291,13 @@ ManagedResource<vk::Pipeline> vkutil::PipelineBuilder::build()
         .setPDepthStencilState(&depth_stencil_state_create_info)
         .setLayout(layout)
         .setRenderPass(render_pass)
-        .setSubpass(0);
+        .setSubpass(subpass);
 
     return ManagedResource<vk::Pipeline>{
 #if VK_HEADER_VERSION > 148
-        vulkan.device().createGraphicsPipeline({}, pipeline_create_info).value,
+        vulkan.device().createGraphicsPipeline(pipeline_cache, pipeline_create_info).value,
 #else
-        vulkan.device().createGraphicsPipeline({}, pipeline_create_info),
+        vulkan.device().createGraphicsPipeline(pipeline_cache, pipeline_create_info),
 #endif
         [vptr=&vulkan] (auto const& p) { vptr->device().destroyPipeline(p); }};
 }
@@ -40,12 +40,28 @@ public:
         std::vector<vk::VertexInputBindingDescription> const& binding_descriptions,
         std::vector<vk::VertexInputAttributeDescription> const& attribute_descriptions);
     PipelineBuilder& set_vertex_shader(std::vector<char> const& spirv);
+    // Without a fragment shader the pipeline is depth-only, for render passes
+    // without color attachments
     PipelineBuilder& set_fragment_shader(std::vector<char> const& spirv);
     PipelineBuilder& set_depth_test(bool depth_test);
+    PipelineBuilder& set_depth_bias(float constant_factor, float slope_factor);
     PipelineBuilder& set_extent(vk::Extent2D extent);
     PipelineBuilder& set_layout(vk::PipelineLayout layout);
     PipelineBuilder& set_render_pass(vk::RenderPass render_pass);
+    PipelineBuilder& set_subpass(uint32_t subpass);
+    // For rendering to multiple targets, all with the same blend state
+    PipelineBuilder& set_color_attachment_count(uint32_t count);
+    PipelineBuilder& set_samples(vk::SampleCountFlagBits samples);
     PipelineBuilder& set_blend(bool blend);
+    // Defaults to alpha blending: src_alpha, one_minus_src_alpha, one, zero
+    PipelineBuilder& set_blend_factors(
+        vk::BlendFactor src_color, vk::BlendFactor dst_color,
+        vk::BlendFactor src_alpha, vk::BlendFactor dst_alpha);
+    PipelineBuilder& set_blend_op(vk::BlendOp color_op, vk::BlendOp alpha_op);
+    // Value i is used for the specialization constant with constant_id i,
+    // in all shader stages
+    PipelineBuilder& set_specialization_constants(std::vector<uint32_t> const& values);
+    PipelineBuilder& set_pipeline_cache(vk::PipelineCache pipeline_cache);
 
     ManagedResource<vk::Pipeline> build();
 
@@ -56,10 +72,23 @@ private:
     std::vector<char> vertex_shader_spirv;
     std::vector<char> fragment_shader_spirv;
     bool depth_test;
+    float depth_bias_constant_factor;
+    float depth_bias_slope_factor;
     bool blend;
+    vk::BlendFactor src_color_blend_factor;
+    vk::BlendFactor dst_color_blend_factor;
+    vk::BlendFactor src_alpha_blend_factor;
+    vk::BlendFactor dst_alpha_blend_factor;
+    vk::BlendOp color_blend_op;
+    vk::BlendOp alpha_blend_op;
     vk::Extent2D extent;
     vk::PipelineLayout layout;
     vk::RenderPass render_pass;
+    uint32_t subpass;
+    uint32_t color_attachment_count;
+    vk::SampleCountFlagBits samples;
+    std::vector<uint32_t> specialization_constants;
+    vk::PipelineCache pipeline_cache;
 };
 
 }
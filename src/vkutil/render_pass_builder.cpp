@@ -24,17 +24,28 @@
 
 #include "vulkan_state.h"
 
+#include <stdexcept>
+
 vkutil::RenderPassBuilder::RenderPassBuilder(VulkanState& vulkan)
     : vulkan{vulkan},
-      color_format{vk::Format::eUndefined},
       depth_format{vk::Format::eUndefined},
-      color_load_op{vk::AttachmentLoadOp::eLoad}
+      samples{vk::SampleCountFlagBits::e1},
+      second_subpass_format{vk::Format::eUndefined},
+      color_load_op{vk::AttachmentLoadOp::eLoad},
+      color_final_layout{vk::ImageLayout::ePresentSrcKHR}
 {
 }
 
 vkutil::RenderPassBuilder& vkutil::RenderPassBuilder::set_color_format(vk::Format format_)
 {
-    color_format = format_;
+    color_formats = {format_};
+    return *this;
+}
+
+vkutil::RenderPassBuilder& vkutil::RenderPassBuilder::set_color_formats(
+    std::vector<vk::Format> const& formats_)
+{
+    color_formats = formats_;
     return *this;
 }
 
@@ -44,55 +55,163 @@ vkutil::RenderPassBuilder& vkutil::RenderPassBuilder::set_depth_format(vk::Forma
     return *this;
 }
 
+vkutil::RenderPassBuilder& vkutil::RenderPassBuilder::set_samples(vk::SampleCountFlagBits samples_)
+{
+    samples = samples_;
+    return *this;
+}
+
+vkutil::RenderPassBuilder& vkutil::RenderPassBuilder::set_second_subpass_format(vk::Format format_)
+{
+    second_subpass_format = format_;
+    return *this;
+}
+
 vkutil::RenderPassBuilder& vkutil::RenderPassBuilder::set_color_load_op(vk::AttachmentLoadOp load_op_)
 {
     color_load_op = load_op_;
     return *this;
 }
 
+vkutil::RenderPassBuilder& vkutil::RenderPassBuilder::set_color_final_layout(vk::ImageLayout layout_)
+{
+    color_final_layout = layout_;
+    return *this;
+}
+
 ManagedResource<vk::RenderPass> vkutil::RenderPassBuilder::build()
 {
-    auto const color_attachment = vk::AttachmentDescription{}
-        .setFormat(color_format)
-        .setSamples(vk::SampleCountFlagBits::e1)
-        .setLoadOp(color_load_op)
-        .setStoreOp(vk::AttachmentStoreOp::eStore)
-        .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
-        .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
-        .setInitialLayout(vk::ImageLayout::eUndefined)
-        .setFinalLayout(vk::ImageLayout::ePresentSrcKHR);
-
-    auto const color_attachment_ref = vk::AttachmentReference{}
-        .setAttachment(0)
-        .setLayout(vk::ImageLayout::eColorAttachmentOptimal);
+    bool const use_color_attachments = !color_formats.empty();
+    bool const use_depth_attachment = depth_format != vk::Format::eUndefined;
+    bool const use_resolve_attachments =
+        use_color_attachments && samples != vk::SampleCountFlagBits::e1;
+    bool const use_second_subpass = second_subpass_format != vk::Format::eUndefined;
 
-    auto const depth_attachment = vk::AttachmentDescription{}
-        .setFormat(depth_format)
-        .setSamples(vk::SampleCountFlagBits::e1)
-        .setLoadOp(vk::AttachmentLoadOp::eClear)
-        .setStoreOp(vk::AttachmentStoreOp::eDontCare)
-        .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
-        .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
-        .setInitialLayout(vk::ImageLayout::eUndefined)
-        .setFinalLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
+    if (use_second_subpass && (!use_color_attachments || use_resolve_attachments))
+    {
+        throw std::logic_error{
+            "A second subpass requires single-sample color attachments in the first"};
+    }
+
+    std::vector<vk::AttachmentDescription> attachments;
+    std::vector<vk::AttachmentReference> color_attachment_refs;
+    std::vector<vk::AttachmentReference> input_attachment_refs;
+    std::vector<vk::AttachmentReference> resolve_attachment_refs;
+
+    // Multisample color contents are only needed until they are resolved, and
+    // color contents read by the second subpass only until the end of the
+    // render pass, so they are never stored, which lets tiled GPUs keep them
+    // on-chip
+    auto const color_store_op = use_resolve_attachments || use_second_subpass ?
+        vk::AttachmentStoreOp::eDontCare : vk::AttachmentStoreOp::eStore;
+    auto const color_attachment_final_layout =
+        use_resolve_attachments ? vk::ImageLayout::eColorAttachmentOptimal :
+        use_second_subpass ? vk::ImageLayout::eShaderReadOnlyOptimal :
+        color_final_layout;
+
+    for (auto const format : color_formats)
+    {
+        color_attachment_refs.push_back(
+            vk::AttachmentReference{}
+                .setAttachment(attachments.size())
+                .setLayout(vk::ImageLayout::eColorAttachmentOptimal));
+        input_attachment_refs.push_back(
+            vk::AttachmentReference{}
+                .setAttachment(attachments.size())
+                .setLayout(vk::ImageLayout::eShaderReadOnlyOptimal));
+
+        attachments.push_back(
+            vk::AttachmentDescription{}
+                .setFormat(format)
+                .setSamples(samples)
+                .setLoadOp(color_load_op)
+                .setStoreOp(color_store_op)
+                .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
+                .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
+                .setInitialLayout(vk::ImageLayout::eUndefined)
+                .setFinalLayout(color_attachment_final_layout));
+    }
 
     auto const depth_attachment_ref = vk::AttachmentReference{}
-        .setAttachment(1)
+        .setAttachment(attachments.size())
         .setLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
 
-    bool const use_depth_attachment = depth_format != vk::Format::eUndefined;
+    if (use_depth_attachment)
+    {
+        attachments.push_back(
+            vk::AttachmentDescription{}
+                .setFormat(depth_format)
+                .setSamples(samples)
+                .setLoadOp(vk::AttachmentLoadOp::eClear)
+                .setStoreOp(use_color_attachments ?
+                            vk::AttachmentStoreOp::eDontCare :
+                            vk::AttachmentStoreOp::eStore)
+                .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
+                .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
+                .setInitialLayout(vk::ImageLayout::eUndefined)
+                .setFinalLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal));
+    }
 
-    auto const subpass = vk::SubpassDescription{}
-        .setPipelineBindPoint(vk::PipelineBindPoint::eGraphics)
-        .setColorAttachmentCount(1)
-        .setPColorAttachments(&color_attachment_ref)
-        .setPDepthStencilAttachment(use_depth_attachment ? &depth_attachment_ref : nullptr);
+    if (use_resolve_attachments)
+    {
+        for (auto const format : color_formats)
+        {
+            resolve_attachment_refs.push_back(
+                vk::AttachmentReference{}
+                    .setAttachment(attachments.size())
+                    .setLayout(vk::ImageLayout::eColorAttachmentOptimal));
 
-    std::vector<vk::AttachmentDescription> attachments{color_attachment};
-    if (use_depth_attachment)
-        attachments.push_back(depth_attachment);
+            attachments.push_back(
+                vk::AttachmentDescription{}
+                    .setFormat(format)
+                    .setSamples(vk::SampleCountFlagBits::e1)
+                    .setLoadOp(vk::AttachmentLoadOp::eDontCare)
+                    .setStoreOp(vk::AttachmentStoreOp::eStore)
+                    .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
+                    .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
+                    .setInitialLayout(vk::ImageLayout::eUndefined)
+                    .setFinalLayout(color_final_layout));
+        }
+    }
+
+    auto const second_subpass_attachment_ref = vk::AttachmentReference{}
+        .setAttachment(attachments.size())
+        .setLayout(vk::ImageLayout::eColorAttachmentOptimal);
+
+    if (use_second_subpass)
+    {
+        attachments.push_back(
+            vk::AttachmentDescription{}
+                .setFormat(second_subpass_format)
+                .setSamples(vk::SampleCountFlagBits::e1)
+                .setLoadOp(vk::AttachmentLoadOp::eDontCare)
+                .setStoreOp(vk::AttachmentStoreOp::eStore)
+                .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
+                .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
+                .setInitialLayout(vk::ImageLayout::eUndefined)
+                .setFinalLayout(color_final_layout));
+    }
 
-    auto const subpass_dependency = vk::SubpassDependency{}
+    std::vector<vk::SubpassDescription> subpasses{
+        vk::SubpassDescription{}
+            .setPipelineBindPoint(vk::PipelineBindPoint::eGraphics)
+            .setColorAttachmentCount(color_attachment_refs.size())
+            .setPColorAttachments(color_attachment_refs.data())
+            .setPResolveAttachments(use_resolve_attachments ? resolve_attachment_refs.data() : nullptr)
+            .setPDepthStencilAttachment(use_depth_attachment ? &depth_attachment_ref : nullptr)};
+
+    if (use_second_subpass)
+    {
+        subpasses.push_back(
+            vk::SubpassDescription{}
+                .setPipelineBindPoint(vk::PipelineBindPoint::eGraphics)
+                .setInputAttachmentCount(input_attachment_refs.size())
+                .setPInputAttachments(input_attachment_refs.data())
+                .setColorAttachmentCount(1)
+                .setPColorAttachments(&second_subpass_attachment_ref));
+    }
+
+    auto const color_subpass_dependency = vk::SubpassDependency{}
         .setSrcSubpass(VK_SUBPASS_EXTERNAL)
         .setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput)
         .setSrcAccessMask({})
@@ -102,13 +221,47 @@ ManagedResource<vk::RenderPass> vkutil::RenderPassBuilder::build()
                           vk::AccessFlagBits::eColorAttachmentWrite)
         .setDependencyFlags(vk::DependencyFlagBits::eByRegion);
 
+    // Depth-only passes render textures, so they wait for earlier reads of
+    // the depth contents by fragment shaders before overwriting them
+    auto const depth_subpass_dependency = vk::SubpassDependency{}
+        .setSrcSubpass(VK_SUBPASS_EXTERNAL)
+        .setSrcStageMask(vk::PipelineStageFlagBits::eFragmentShader)
+        .setSrcAccessMask({})
+        .setDstSubpass(0)
+        .setDstStageMask(vk::PipelineStageFlagBits::eEarlyFragmentTests |
+                         vk::PipelineStageFlagBits::eLateFragmentTests)
+        .setDstAccessMask(vk::AccessFlagBits::eDepthStencilAttachmentRead |
+                          vk::AccessFlagBits::eDepthStencilAttachmentWrite);
+
+    std::vector<vk::SubpassDependency> subpass_dependencies{
+        use_color_attachments ? color_subpass_dependency : depth_subpass_dependency};
+
+    if (use_second_subpass)
+    {
+        subpass_dependencies.push_back(
+            vk::SubpassDependency{color_subpass_dependency}
+                .setDstSubpass(1));
+
+        // Each fragment of the second subpass reads only the first subpass
+        // contents at the same location, so the dependency is by region
+        subpass_dependencies.push_back(
+            vk::SubpassDependency{}
+                .setSrcSubpass(0)
+                .setSrcStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput)
+                .setSrcAccessMask(vk::AccessFlagBits::eColorAttachmentWrite)
+                .setDstSubpass(1)
+                .setDstStageMask(vk::PipelineStageFlagBits::eFragmentShader)
+                .setDstAccessMask(vk::AccessFlagBits::eInputAttachmentRead)
+                .setDependencyFlags(vk::DependencyFlagBits::eByRegion));
+    }
+
     auto const render_pass_create_info = vk::RenderPassCreateInfo{}
         .setAttachmentCount(attachments.size())
         .setPAttachments(attachments.data())
-        .setSubpassCount(1)
-        .setPSubpasses(&subpass)
-        .setDependencyCount(1)
-        .setPDependencies(&subpass_dependency);
+        .setSubpassCount(subpasses.size())
+        .setPSubpasses(subpasses.data())
+        .setDependencyCount(subpass_dependencies.size())
+        .setPDependencies(subpass_dependencies.data());
 
     return ManagedResource<vk::RenderPass>{
         vulkan.device().createRenderPass(render_pass_create_info),
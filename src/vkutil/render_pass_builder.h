@@ -37,17 +37,34 @@ public:
     RenderPassBuilder(VulkanState& vulkan);
 
     RenderPassBuilder& set_color_format(vk::Format format);
+    // Multiple render targets, as attachments 0 to formats.size() - 1,
+    // followed by the depth attachment
+    RenderPassBuilder& set_color_formats(std::vector<vk::Format> const& formats);
+    // Without a color format the render pass is depth-only, and the depth
+    // contents are stored for later use as a texture
     RenderPassBuilder& set_depth_format(vk::Format format);
+    // With more than one sample, the color attachments are multisampled and
+    // single-sample resolve attachments are added after the depth attachment
+    RenderPassBuilder& set_samples(vk::SampleCountFlagBits samples);
+    // Adds a second subpass, which reads the color attachments of the first
+    // subpass as input attachments and renders to a color attachment of the
+    // given format, added last. The first subpass contents are not stored.
+    RenderPassBuilder& set_second_subpass_format(vk::Format format);
 
     RenderPassBuilder& set_color_load_op(vk::AttachmentLoadOp load_op);
+    // Defaults to the presentation layout, for rendering to swapchain images
+    RenderPassBuilder& set_color_final_layout(vk::ImageLayout layout);
 
     ManagedResource<vk::RenderPass> build();
 
 private:
     VulkanState& vulkan;
-    vk::Format color_format;
+    std::vector<vk::Format> color_formats;
     vk::Format depth_format;
+    vk::SampleCountFlagBits samples;
+    vk::Format second_subpass_format;
     vk::AttachmentLoadOp color_load_op;
+    vk::ImageLayout color_final_layout;
 };
 
 }
@@ -22,23 +22,49 @@
 
 #include "texture_builder.h"
 #include "texture.h"
+#include "ktx2_file.h"
 #include "util.h"
 #include "vulkan_state.h"
 
 #include "buffer_builder.h"
 #include "copy_buffer.h"
+#include "generate_mipmaps.h"
 #include "image_builder.h"
 #include "image_view_builder.h"
 #include "transition_image_layout.h"
 
+#include <stdexcept>
+
 namespace
 {
 
+vk::Format const texture_format = vk::Format::eR8G8B8A8Srgb;
+
+uint32_t texture_mip_levels(VulkanState& vulkan,
+                            Util::Image const& image,
+                            bool mipmaps)
+{
+    if (!mipmaps)
+        return 1;
+
+    auto const format_props = vulkan.physical_device().getFormatProperties(texture_format);
+    auto const blit_features =
+        vk::FormatFeatureFlagBits::eBlitSrc |
+        vk::FormatFeatureFlagBits::eBlitDst |
+        vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+
+    if ((format_props.optimalTilingFeatures & blit_features) != blit_features)
+        throw std::runtime_error{"Texture format doesn't support mipmap generation"};
+
+    return vkutil::mip_levels_for_extent(
+        {static_cast<uint32_t>(image.width), static_cast<uint32_t>(image.height)});
+}
+
 void texture_setup_image(VulkanState& vulkan,
                          vkutil::Texture& texture,
-                         Util::Image const& image)
+                         Util::Image const& image,
+                         uint32_t mip_levels)
 {
-    auto const texture_format = vk::Format::eR8G8B8A8Srgb;
     vk::DeviceMemory staging_buffer_memory;
 
     auto const image_extent = vk::Extent2D{
@@ -59,12 +85,20 @@ void texture_setup_image(VulkanState& vulkan,
     memcpy(staging_buffer_map, image.data, image.size);
     vulkan.device().unmapMemory(staging_buffer_memory);
 
+    vk::ImageUsageFlags usage =
+        vk::ImageUsageFlagBits::eTransferDst |
+        vk::ImageUsageFlagBits::eSampled;
+
+    // Mipmap levels are generated by blitting from the previous level
+    if (mip_levels > 1)
+        usage |= vk::ImageUsageFlagBits::eTransferSrc;
+
     texture.image = vkutil::ImageBuilder{vulkan}
         .set_extent(image_extent)
         .set_format(texture_format)
+        .set_mip_levels(mip_levels)
         .set_tiling(vk::ImageTiling::eOptimal)
-        .set_usage(vk::ImageUsageFlagBits::eTransferDst |
-                   vk::ImageUsageFlagBits::eSampled)
+        .set_usage(usage)
         .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
         .set_initial_layout(vk::ImageLayout::ePreinitialized)
         .build();
@@ -74,29 +108,158 @@ void texture_setup_image(VulkanState& vulkan,
         texture.image,
         vk::ImageLayout::ePreinitialized,
         vk::ImageLayout::eTransferDstOptimal,
-        vk::ImageAspectFlagBits::eColor);
+        vk::ImageAspectFlagBits::eColor,
+        mip_levels);
 
     vkutil::copy_buffer_to_image(vulkan, staging_buffer, texture.image, image_extent);
 
+    if (mip_levels > 1)
+    {
+        vkutil::generate_mipmaps(vulkan, texture.image, image_extent, mip_levels);
+    }
+    else
+    {
+        vkutil::transition_image_layout(
+            vulkan,
+            texture.image,
+            vk::ImageLayout::eTransferDstOptimal,
+            vk::ImageLayout::eShaderReadOnlyOptimal,
+            vk::ImageAspectFlagBits::eColor);
+    }
+
+    texture.image_view = vkutil::ImageViewBuilder{vulkan}
+        .set_image(texture.image)
+        .set_format(texture_format)
+        .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+        .set_mip_levels(mip_levels)
+        .build();
+}
+
+uint32_t texture_mip_levels(VulkanState& vulkan,
+                            Ktx2File const& ktx2,
+                            vk::Filter filter,
+                            bool mipmaps)
+{
+    auto const format_props = vulkan.physical_device().getFormatProperties(ktx2.format());
+    auto sample_features = vk::FormatFeatureFlags{vk::FormatFeatureFlagBits::eSampledImage};
+
+    if (filter == vk::Filter::eLinear)
+        sample_features |= vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+
+    if ((format_props.optimalTilingFeatures & sample_features) != sample_features)
+        throw std::runtime_error{"Texture format " + vk::to_string(ktx2.format()) +
+                                 " is not supported by the device"};
+
+    // Pre-encoded mipmap levels can't be regenerated on the GPU, so only
+    // the levels stored in the file are available
+    return mipmaps ? static_cast<uint32_t>(ktx2.levels().size()) : 1;
+}
+
+void texture_setup_image(VulkanState& vulkan,
+                         vkutil::Texture& texture,
+                         Ktx2File const& ktx2,
+                         uint32_t mip_levels)
+{
+    vk::DeviceMemory staging_buffer_memory;
+
+    auto staging_buffer = vkutil::BufferBuilder{vulkan}
+        .set_size(ktx2.size())
+        .set_usage(vk::BufferUsageFlagBits::eTransferSrc)
+        .set_memory_properties(
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent)
+        .set_memory_out(staging_buffer_memory)
+        .build();
+
+    auto const staging_buffer_map = vulkan.device().mapMemory(
+        staging_buffer_memory, 0, ktx2.size());
+    memcpy(staging_buffer_map, ktx2.data(), ktx2.size());
+    vulkan.device().unmapMemory(staging_buffer_memory);
+
+    texture.image = vkutil::ImageBuilder{vulkan}
+        .set_extent(ktx2.extent())
+        .set_format(ktx2.format())
+        .set_mip_levels(mip_levels)
+        .set_tiling(vk::ImageTiling::eOptimal)
+        .set_usage(
+            vk::ImageUsageFlagBits::eTransferDst |
+            vk::ImageUsageFlagBits::eSampled)
+        .set_memory_properties(vk::MemoryPropertyFlagBits::eDeviceLocal)
+        .set_initial_layout(vk::ImageLayout::eUndefined)
+        .build();
+
+    vkutil::transition_image_layout(
+        vulkan,
+        texture.image,
+        vk::ImageLayout::eUndefined,
+        vk::ImageLayout::eTransferDstOptimal,
+        vk::ImageAspectFlagBits::eColor,
+        mip_levels);
+
+    // The file contents are uploaded as is, so each level is copied
+    // straight from its offset in the staging buffer
+    std::vector<vk::BufferImageCopy> regions;
+
+    for (uint32_t i = 0; i < mip_levels; ++i)
+    {
+        auto const& level = ktx2.levels()[i];
+
+        regions.push_back(
+            vk::BufferImageCopy{}
+                .setBufferOffset(level.offset)
+                .setBufferRowLength(0)
+                .setBufferImageHeight(0)
+                .setImageSubresource(
+                    vk::ImageSubresourceLayers{}
+                        .setAspectMask(vk::ImageAspectFlagBits::eColor)
+                        .setMipLevel(i)
+                        .setBaseArrayLayer(0)
+                        .setLayerCount(1))
+                .setImageOffset({0, 0, 0})
+                .setImageExtent({level.extent.width, level.extent.height, 1}));
+    }
+
+    vkutil::copy_buffer_to_image(vulkan, staging_buffer, texture.image, regions);
+
     vkutil::transition_image_layout(
         vulkan,
         texture.image,
         vk::ImageLayout::eTransferDstOptimal,
         vk::ImageLayout::eShaderReadOnlyOptimal,
-        vk::ImageAspectFlagBits::eColor);
+        vk::ImageAspectFlagBits::eColor,
+        mip_levels);
 
     texture.image_view = vkutil::ImageViewBuilder{vulkan}
         .set_image(texture.image)
-        .set_format(texture_format)
+        .set_format(ktx2.format())
         .set_aspect_mask(vk::ImageAspectFlagBits::eColor)
+        .set_mip_levels(mip_levels)
         .build();
 }
 
+bool is_ktx2_file(std::string const& file)
+{
+    std::string const ext{".ktx2"};
+
+    return file.size() >= ext.size() &&
+           file.compare(file.size() - ext.size(), ext.size(), ext) == 0;
+}
+
 void texture_setup_sampler(VulkanState& vulkan,
                            vkutil::Texture& texture,
                            vk::Filter filter,
-                           float anisotropy)
+                           float anisotropy,
+                           uint32_t mip_levels)
 {
+    // With a single level keep the sampler from ever leaving the base level,
+    // otherwise use the whole mipmap chain, interpolating between levels
+    // for linear filtering (i.e., trilinear filtering)
+    auto const mipmap_mode =
+        (mip_levels > 1 && filter == vk::Filter::eLinear) ?
+        vk::SamplerMipmapMode::eLinear :
+        vk::SamplerMipmapMode::eNearest;
+    auto const max_lod = mip_levels > 1 ? static_cast<float>(mip_levels) : 0.25f;
+
     auto const sampler_create_info = vk::SamplerCreateInfo{}
         .setMagFilter(filter)
         .setMinFilter(filter)
@@ -108,8 +271,8 @@ void texture_setup_sampler(VulkanState& vulkan,
         .setUnnormalizedCoordinates(false)
         .setCompareEnable(false)
         .setMinLod(0.0f)
-        .setMaxLod(0.25f)
-        .setMipmapMode(vk::SamplerMipmapMode::eNearest);
+        .setMaxLod(max_lod)
+        .setMipmapMode(mipmap_mode);
 
     texture.sampler = ManagedResource<vk::Sampler>{
         vulkan.device().createSampler(sampler_create_info),
@@ -121,7 +284,8 @@ void texture_setup_sampler(VulkanState& vulkan,
 vkutil::TextureBuilder::TextureBuilder(VulkanState& vulkan)
     : vulkan{vulkan},
       filter{vk::Filter::eNearest},
-      anisotropy{0.0f}
+      anisotropy{0.0f},
+      mipmaps{false}
 {
 }
 
@@ -143,14 +307,31 @@ vkutil::TextureBuilder& vkutil::TextureBuilder::set_anisotropy(float a)
     return *this;
 }
 
+vkutil::TextureBuilder& vkutil::TextureBuilder::set_mipmaps(bool mipmaps_)
+{
+    mipmaps = mipmaps_;
+    return *this;
+}
+
 vkutil::Texture vkutil::TextureBuilder::build()
 {
     Texture texture;
+    uint32_t mip_levels;
 
-    auto const image = Util::read_image_file(file);
+    if (is_ktx2_file(file))
+    {
+        Ktx2File const ktx2{file};
+        mip_levels = texture_mip_levels(vulkan, ktx2, filter, mipmaps);
+        texture_setup_image(vulkan, texture, ktx2, mip_levels);
+    }
+    else
+    {
+        auto const image = Util::read_image_file(file);
+        mip_levels = texture_mip_levels(vulkan, image, mipmaps);
+        texture_setup_image(vulkan, texture, image, mip_levels);
+    }
 
-    texture_setup_image(vulkan, texture, image);
-    texture_setup_sampler(vulkan, texture, filter, anisotropy);
+    texture_setup_sampler(vulkan, texture, filter, anisotropy, mip_levels);
 
     return texture;
 }
@@ -41,6 +41,7 @@ public:
     TextureBuilder& set_file(std::string const& file);
     TextureBuilder& set_filter(vk::Filter filter);
     TextureBuilder& set_anisotropy(float anisotropy);
+    TextureBuilder& set_mipmaps(bool mipmaps);
 
     Texture build();
 
@@ -49,6 +50,7 @@ private:
     std::string file;
     vk::Filter filter;
     float anisotropy;
+    bool mipmaps;
 };
 
 }
@@ -70,12 +70,13 @@ void vkutil::transition_image_layout(
     vk::Image image,
     vk::ImageLayout old_layout,
     vk::ImageLayout new_layout,
-    vk::ImageAspectFlags aspect_mask)
+    vk::ImageAspectFlags aspect_mask,
+    uint32_t mip_levels)
 {
     auto const image_subresource_range = vk::ImageSubresourceRange{}
         .setAspectMask(aspect_mask)
         .setBaseMipLevel(0)
-        .setLevelCount(1)
+        .setLevelCount(mip_levels)
         .setBaseArrayLayer(0)
         .setLayerCount(1);
 
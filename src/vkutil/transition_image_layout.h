@@ -34,6 +34,7 @@ void transition_image_layout(
     vk::Image image,
     vk::ImageLayout old_layout,
     vk::ImageLayout new_layout,
-    vk::ImageAspectFlags aspect_mask);
+    vk::ImageAspectFlags aspect_mask,
+    uint32_t mip_levels = 1);
 
 }
@@ -23,13 +23,21 @@
 #pragma once
 
 #include "buffer_builder.h"
+#include "compute_pipeline_builder.h"
 #include "copy_buffer.h"
+#include "create_command_pool.h"
+#include "create_device_local_buffer.h"
+#include "create_mesh_buffers.h"
+#include "create_shader_module.h"
 #include "descriptor_set_builder.h"
 #include "find_matching_memory_type.h"
+#include "find_sample_count.h"
 #include "framebuffer_builder.h"
+#include "generate_mipmaps.h"
 #include "image_builder.h"
 #include "image_view_builder.h"
 #include "map_memory.h"
+#include "msaa_color_target.h"
 #include "pipeline_builder.h"
 #include "render_pass_builder.h"
 #include "semaphore_builder.h"
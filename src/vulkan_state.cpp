@@ -24,7 +24,9 @@
 #include "device_uuid.h"
 #include "log.h"
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <vector>
 #include <vulkan/vulkan.hpp>
 
@@ -55,6 +57,13 @@ std::vector<vk::PhysicalDevice> VulkanState::available_devices(VulkanWSI& vulkan
     return available_devices;
 }
 
+static bool has_extension(std::vector<vk::ExtensionProperties> const& extensions,
+                          char const* name)
+{
+    return std::any_of(extensions.begin(), extensions.end(),
+                       [name] (auto const& e) { return !strcmp(e.extensionName, name); });
+}
+
 static void log_device_info(vk::PhysicalDevice const& device)
 {
     auto const props = device.getProperties();
@@ -90,6 +99,15 @@ void VulkanState::create_instance(VulkanWSI& vulkan_wsi)
     std::vector<char const*> enabled_extensions{vulkan_wsi.required_extensions().instance};
     enabled_extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
 
+    // Required by some of the optional device extensions
+    if (has_extension(vk::enumerateInstanceExtensionProperties(),
+                      VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME))
+    {
+        enabled_extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    }
+
+    vk_instance_extensions.assign(enabled_extensions.begin(), enabled_extensions.end());
+
     auto const create_info = vk::InstanceCreateInfo{}
         .setPApplicationInfo(&app_info)
         .setEnabledExtensionCount(enabled_extensions.size())
@@ -120,6 +138,22 @@ static std::pair<uint32_t, bool> find_queue_family_index(vk::PhysicalDevice pd,
     return std::make_pair(0, false);
 }
 
+// pseudo-optional
+static std::pair<uint32_t, bool> find_async_compute_queue_family_index(vk::PhysicalDevice pd)
+{
+    auto const queue_families = pd.getQueueFamilyProperties();
+
+    for (uint32_t queue_index = 0; queue_index < queue_families.size(); ++queue_index)
+    {
+        auto const flags = queue_families[queue_index].queueFlags;
+
+        if ((flags & vk::QueueFlagBits::eCompute) && !(flags & vk::QueueFlagBits::eGraphics))
+            return std::make_pair(queue_index, true);
+    }
+
+    return std::make_pair(0, false);
+}
+
 void VulkanState::create_logical_device(VulkanWSI& vulkan_wsi)
 {
     // it would be really nice to support c++17
@@ -128,6 +162,10 @@ void VulkanState::create_logical_device(VulkanWSI& vulkan_wsi)
         throw std::runtime_error("selected physical device does not provide graphics queue");
     vk_graphics_queue_family_index = pair.first;
 
+    auto const compute_pair = find_async_compute_queue_family_index(physical_device());
+    vk_compute_queue_family_index =
+        compute_pair.second ? compute_pair.first : vk_graphics_queue_family_index;
+
     auto const priority = 1.0f;
 
     auto queue_family_indices =
@@ -146,6 +184,13 @@ void VulkanState::create_logical_device(VulkanWSI& vulkan_wsi)
         queue_family_indices.push_back(graphics_queue_family_index());
     }
 
+    if (std::find(queue_family_indices.begin(),
+                  queue_family_indices.end(),
+                  compute_queue_family_index()) == queue_family_indices.end())
+    {
+        queue_family_indices.push_back(compute_queue_family_index());
+    }
+
     std::vector<vk::DeviceQueueCreateInfo> queue_create_infos;
     for (auto index : queue_family_indices)
     {
@@ -159,10 +204,37 @@ void VulkanState::create_logical_device(VulkanWSI& vulkan_wsi)
     Log::debug("VulkanState: Using queue family index %d for rendering\n",
                graphics_queue_family_index());
 
+    if (has_async_compute_queue())
+    {
+        Log::debug("VulkanState: Using queue family index %d for async compute\n",
+                   compute_queue_family_index());
+    }
+
     std::vector<char const*> enabled_extensions{vulkan_wsi.required_extensions().device};
 
+    // Enable the optional extensions that scenes can check for with
+    // has_device_extension()
+    auto const supported_extensions = physical_device().enumerateDeviceExtensionProperties();
+    bool const properties2 =
+        std::find(vk_instance_extensions.begin(), vk_instance_extensions.end(),
+                  VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) !=
+        vk_instance_extensions.end();
+
+    if (has_extension(supported_extensions, VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+        enabled_extensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+    if (properties2 && has_extension(supported_extensions, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+        enabled_extensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+
+    vk_device_extensions.assign(enabled_extensions.begin(), enabled_extensions.end());
+
+    // Enable whichever compressed texture formats the device can sample,
+    // so that scenes can pick one at runtime
+    auto const supported_features = physical_device().getFeatures();
     auto const device_features = vk::PhysicalDeviceFeatures{}
-        .setSamplerAnisotropy(true);
+        .setSamplerAnisotropy(true)
+        .setTextureCompressionBC(supported_features.textureCompressionBC)
+        .setTextureCompressionETC2(supported_features.textureCompressionETC2)
+        .setTextureCompressionASTC_LDR(supported_features.textureCompressionASTC_LDR);
 
     auto const device_create_info = vk::DeviceCreateInfo{}
         .setQueueCreateInfoCount(queue_create_infos.size())
@@ -176,6 +248,7 @@ void VulkanState::create_logical_device(VulkanWSI& vulkan_wsi)
         [] (auto& d) { d.destroy(); }};
 
     vk_graphics_queue = device().getQueue(graphics_queue_family_index(), 0);
+    vk_compute_queue = device().getQueue(compute_queue_family_index(), 0);
 }
 
 void VulkanState::create_command_pool()
@@ -22,7 +22,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <string>
+#include <vector>
 #include <vulkan/vulkan.hpp>
 
 #include "managed_resource.h"
@@ -68,6 +71,31 @@ public:
         return vk_command_pool;
     }
 
+    // Whether the device has a compute queue family without graphics support,
+    // whose queue can run work asynchronously to the graphics queue. If not,
+    // the compute queue is the graphics queue.
+    bool has_async_compute_queue() const
+    {
+        return vk_compute_queue_family_index != vk_graphics_queue_family_index;
+    }
+
+    uint32_t const& compute_queue_family_index() const
+    {
+        return vk_compute_queue_family_index;
+    }
+
+    vk::Queue const& compute_queue() const
+    {
+        return vk_compute_queue;
+    }
+
+    // Whether the named device extension is enabled
+    bool has_device_extension(std::string const& name) const
+    {
+        return std::find(vk_device_extensions.begin(), vk_device_extensions.end(), name) !=
+               vk_device_extensions.end();
+    }
+
     void log_info() const;
     void log_all_devices() const;
 
@@ -83,8 +111,12 @@ private:
     ManagedResource<vk::Device> vk_device;
     ManagedResource<vk::CommandPool> vk_command_pool;
     vk::Queue vk_graphics_queue;
+    vk::Queue vk_compute_queue;
     vk::PhysicalDevice vk_physical_device;
     uint32_t vk_graphics_queue_family_index;
+    uint32_t vk_compute_queue_family_index;
+    std::vector<std::string> vk_instance_extensions;
+    std::vector<std::string> vk_device_extensions;
 };
 
 class ChooseFirstSupportedStrategy
@@ -45,6 +45,21 @@ struct TestSceneWithOptions : TestScene
     }
 };
 
+struct PrefetchRecordingScene : TestSceneWithOptions
+{
+    PrefetchRecordingScene(std::string const& name)
+        : TestSceneWithOptions{name}
+    {
+    }
+
+    void prefetch(std::unordered_map<std::string, SceneOption> const& options) const override
+    {
+        prefetched_options = options;
+    }
+
+    mutable std::unordered_map<std::string, SceneOption> prefetched_options;
+};
+
 std::string benchmark_string(
     std::string const& name,
     std::string const& value1 = "",
@@ -226,3 +241,38 @@ SCENARIO("benchmark collection contains normal scenes", "")
         }
     }
 }
+
+SCENARIO("benchmark prefetch", "")
+{
+    SceneCollection sc;
+    BenchmarkCollection bc{sc};
+
+    GIVEN("A benchmark with options for a scene")
+    {
+        auto const scene_name = TestScene::name(1);
+        auto scene_ptr = std::make_unique<PrefetchRecordingScene>(scene_name);
+        auto& scene = *scene_ptr;
+        sc.register_scene(std::move(scene_ptr));
+
+        auto const value1 = "bla";
+        bc.add({benchmark_string(scene_name, value1)});
+        scene.set_option(option2.name, "other");
+
+        WHEN("running the benchmark prefetch task")
+        {
+            bc.benchmarks()[0]->prefetch_task()();
+
+            THEN("the scene is prefetched with the benchmark option values")
+            {
+                REQUIRE(scene.prefetched_options.at(option1.name).value == value1);
+                REQUIRE(scene.prefetched_options.at(option2.name).value == option2.value);
+            }
+
+            THEN("the scene options are not modified")
+            {
+                REQUIRE(scene.options().at(option1.name).value == option1.value);
+                REQUIRE(scene.options().at(option2.name).value == "other");
+            }
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/ktx2_file.h"
+
+#include "catch.hpp"
+
+#include <cstring>
+
+namespace
+{
+
+void write_u32(std::vector<char>& data, size_t offset, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+        data[offset + i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+void write_u64(std::vector<char>& data, size_t offset, uint64_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+        data[offset + i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+// An 8x4 BC1 texture with two levels: 2 blocks for level 0, 1 block for level 1
+std::vector<char> bc1_ktx2_data()
+{
+    unsigned char const identifier[] =
+        {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    std::vector<char> data(128 + 24);
+    memcpy(data.data(), identifier, sizeof(identifier));
+
+    write_u32(data, 12, static_cast<uint32_t>(vk::Format::eBc1RgbSrgbBlock));
+    write_u32(data, 16, 1);
+    write_u32(data, 20, 8);
+    write_u32(data, 24, 4);
+    write_u32(data, 28, 0);
+    write_u32(data, 32, 0);
+    write_u32(data, 36, 1);
+    write_u32(data, 40, 2);
+    write_u32(data, 44, 0);
+
+    // Level index, levels stored smallest first
+    write_u64(data, 80, 136);
+    write_u64(data, 88, 16);
+    write_u64(data, 96, 16);
+    write_u64(data, 104, 128);
+    write_u64(data, 112, 8);
+    write_u64(data, 120, 8);
+
+    return data;
+}
+
+}
+
+SCENARIO("ktx2 file parsing", "")
+{
+    GIVEN("A valid KTX2 file with a mipmap chain")
+    {
+        auto const data = bc1_ktx2_data();
+
+        WHEN("parsing it")
+        {
+            Ktx2File const ktx2{data};
+
+            THEN("the format and extent are read")
+            {
+                REQUIRE(ktx2.format() == vk::Format::eBc1RgbSrgbBlock);
+                REQUIRE(ktx2.extent() == (vk::Extent2D{8, 4}));
+            }
+
+            THEN("all levels are read with their extents and data ranges")
+            {
+                REQUIRE(ktx2.levels().size() == 2);
+
+                REQUIRE(ktx2.levels()[0].extent == (vk::Extent2D{8, 4}));
+                REQUIRE(ktx2.levels()[0].offset == 136);
+                REQUIRE(ktx2.levels()[0].size == 16);
+
+                REQUIRE(ktx2.levels()[1].extent == (vk::Extent2D{4, 2}));
+                REQUIRE(ktx2.levels()[1].offset == 128);
+                REQUIRE(ktx2.levels()[1].size == 8);
+            }
+        }
+    }
+
+    GIVEN("A file without the KTX2 identifier")
+    {
+        auto data = bc1_ktx2_data();
+        data[1] = 'X';
+
+        THEN("parsing it throws")
+        {
+            REQUIRE_THROWS(Ktx2File{data});
+        }
+    }
+
+    GIVEN("A supercompressed KTX2 file")
+    {
+        auto data = bc1_ktx2_data();
+        write_u32(data, 44, 1);
+
+        THEN("parsing it throws")
+        {
+            REQUIRE_THROWS(Ktx2File{data});
+        }
+    }
+
+    GIVEN("A KTX2 file with level data beyond the end of the file")
+    {
+        auto data = bc1_ktx2_data();
+        data.resize(140);
+
+        THEN("parsing it throws")
+        {
+            REQUIRE_THROWS(Ktx2File{data});
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/lru_cache.h"
+
+#include "catch.hpp"
+
+SCENARIO("lru cache", "")
+{
+    LruCache<int> cache{10};
+
+    GIVEN("A cache with entries within the size limit")
+    {
+        cache.insert("a", 1, 4);
+        cache.insert("b", 2, 4);
+
+        WHEN("looking up the entries")
+        {
+            int a = 0;
+            int b = 0;
+
+            THEN("their values are found")
+            {
+                REQUIRE(cache.find("a", a));
+                REQUIRE(a == 1);
+                REQUIRE(cache.find("b", b));
+                REQUIRE(b == 2);
+            }
+        }
+
+        WHEN("replacing an entry")
+        {
+            cache.insert("a", 3, 4);
+
+            THEN("the new value is found")
+            {
+                int a = 0;
+                REQUIRE(cache.find("a", a));
+                REQUIRE(a == 3);
+            }
+        }
+
+        WHEN("inserting an entry that exceeds the size limit")
+        {
+            int value = 0;
+
+            cache.find("a", value);
+            cache.insert("c", 3, 4);
+
+            THEN("the least recently used entry is evicted")
+            {
+                REQUIRE_FALSE(cache.find("b", value));
+                REQUIRE(cache.find("a", value));
+                REQUIRE(cache.find("c", value));
+            }
+        }
+
+        WHEN("inserting an entry larger than the size limit")
+        {
+            cache.insert("c", 3, 20);
+
+            THEN("only that entry is kept")
+            {
+                int value = 0;
+                REQUIRE_FALSE(cache.find("a", value));
+                REQUIRE_FALSE(cache.find("b", value));
+                REQUIRE(cache.find("c", value));
+                REQUIRE(value == 3);
+            }
+        }
+
+        WHEN("clearing the cache")
+        {
+            cache.clear();
+
+            THEN("no entries are found")
+            {
+                int value = 0;
+                REQUIRE_FALSE(cache.find("a", value));
+                REQUIRE_FALSE(cache.find("b", value));
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/mesh_cache_file.h"
+#include "src/mesh.h"
+
+#include "catch.hpp"
+#include "temporary_dir.h"
+
+#include <fstream>
+#include <unistd.h>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+
+struct TemporaryMeshCacheFile
+{
+    TemporaryDir const dir{"mesh-cache"};
+    std::string const path{dir.path() + "/test.mesh"};
+};
+
+std::vector<float> mesh_vertex_data(Mesh& mesh)
+{
+    std::vector<float> ret(mesh.vertex_data_size() / sizeof(float));
+
+    mesh.set_interleave(true);
+    mesh.copy_vertex_data_to(ret.data());
+
+    return ret;
+}
+
+std::vector<uint16_t> mesh_index_data(Mesh const& mesh)
+{
+    std::vector<uint16_t> ret(mesh.num_indices());
+    mesh.copy_index_data_to(ret.data());
+    return ret;
+}
+
+}
+
+SCENARIO("mesh cache file", "")
+{
+    TemporaryMeshCacheFile cache_file;
+    std::string const key{"models/test.ply:indexed"};
+
+    Mesh mesh{{vk::Format::eR32G32B32Sfloat, vk::Format::eR32G32Sfloat}};
+
+    for (int i = 0; i < 4; ++i)
+    {
+        mesh.next_vertex();
+        mesh.set_attribute(0, glm::vec3{i, i + 1, i + 2});
+        mesh.set_attribute(1, glm::vec2{-i, -i - 1});
+    }
+
+    for (auto const index : {0, 1, 2, 0, 2, 3})
+        mesh.add_index(index);
+
+    GIVEN("A mesh written to a cache file")
+    {
+        REQUIRE(write_mesh_cache_file(cache_file.path, key, mesh));
+
+        WHEN("reading the file with the same key")
+        {
+            auto const read_mesh = read_mesh_cache_file(cache_file.path, key);
+
+            THEN("the mesh is restored")
+            {
+                REQUIRE(read_mesh);
+                REQUIRE(read_mesh->vertex_formats() == mesh.vertex_formats());
+                REQUIRE(read_mesh->num_vertices() == mesh.num_vertices());
+                REQUIRE_THAT(mesh_vertex_data(*read_mesh), Equals(mesh_vertex_data(mesh)));
+                REQUIRE_THAT(mesh_index_data(*read_mesh), Equals(mesh_index_data(mesh)));
+            }
+        }
+
+        WHEN("reading the file with a different key")
+        {
+            auto const read_mesh = read_mesh_cache_file(cache_file.path, key + ":1");
+
+            THEN("no mesh is returned")
+            {
+                REQUIRE(!read_mesh);
+            }
+        }
+
+        WHEN("reading a truncated file")
+        {
+            truncate(cache_file.path.c_str(), mesh.vertex_data_size());
+            auto const read_mesh = read_mesh_cache_file(cache_file.path, key);
+
+            THEN("no mesh is returned")
+            {
+                REQUIRE(!read_mesh);
+            }
+        }
+    }
+
+    GIVEN("A non-existent cache file")
+    {
+        WHEN("reading the file")
+        {
+            auto const read_mesh = read_mesh_cache_file(cache_file.path, key);
+
+            THEN("no mesh is returned")
+            {
+                REQUIRE(!read_mesh);
+            }
+        }
+    }
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/mesh_optimizer.h"
+#include "src/mesh.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+
+uint32_t const grid_size = 32;
+
+// A grid of quads, with the triangles in random order
+Mesh shuffled_grid_mesh()
+{
+    Mesh mesh{{vk::Format::eR32G32Sfloat}};
+
+    for (uint32_t y = 0; y <= grid_size; ++y)
+    {
+        for (uint32_t x = 0; x <= grid_size; ++x)
+        {
+            mesh.next_vertex();
+            mesh.set_attribute(0, glm::vec2{x, y});
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+
+    for (uint32_t y = 0; y < grid_size; ++y)
+    {
+        for (uint32_t x = 0; x < grid_size; ++x)
+        {
+            uint32_t const v = y * (grid_size + 1) + x;
+            triangles.push_back({{v, v + 1, v + grid_size + 1}});
+            triangles.push_back({{v + 1, v + grid_size + 2, v + grid_size + 1}});
+        }
+    }
+
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937{1});
+
+    for (auto const& t : triangles)
+    {
+        for (auto const index : t)
+            mesh.add_index(index);
+    }
+
+    return mesh;
+}
+
+// The triangles of a mesh as vertex values, independent of the order of
+// vertices and triangles
+std::vector<std::vector<float>> mesh_triangles(Mesh& mesh)
+{
+    std::vector<float> vertex_data(mesh.vertex_data_size() / sizeof(float));
+    mesh.set_interleave(true);
+    mesh.copy_vertex_data_to(vertex_data.data());
+
+    auto const& indices = mesh.index_list();
+    std::vector<std::vector<float>> ret;
+
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        std::vector<std::vector<float>> tri;
+        for (size_t j = 0; j < 3; ++j)
+        {
+            auto const v = vertex_data.begin() + indices[i + j] * 2;
+            tri.emplace_back(v, v + 2);
+        }
+
+        // Normalize the winding-preserving rotation of the triangle
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+
+        ret.emplace_back();
+        for (auto const& v : tri)
+            ret.back().insert(ret.back().end(), v.begin(), v.end());
+    }
+
+    std::sort(ret.begin(), ret.end());
+
+    return ret;
+}
+
+}
+
+SCENARIO("mesh optimization", "")
+{
+    GIVEN("An indexed mesh with triangles in random order")
+    {
+        auto mesh = shuffled_grid_mesh();
+        auto const triangles = mesh_triangles(mesh);
+        auto const miss_ratio = vertex_cache_miss_ratio(mesh, 16);
+
+        WHEN("optimizing for the vertex cache")
+        {
+            optimize_vertex_cache(mesh);
+
+            THEN("the triangles are preserved")
+            {
+                REQUIRE(mesh_triangles(mesh) == triangles);
+            }
+
+            THEN("the cache miss ratio is reduced")
+            {
+                REQUIRE(vertex_cache_miss_ratio(mesh, 16) < 0.5f * miss_ratio);
+            }
+        }
+
+        WHEN("optimizing for vertex fetch")
+        {
+            optimize_vertex_fetch(mesh);
+
+            THEN("the triangles are preserved")
+            {
+                REQUIRE(mesh_triangles(mesh) == triangles);
+            }
+
+            THEN("vertices are ordered by first use")
+            {
+                std::vector<uint32_t> first_use;
+                for (auto const index : mesh.index_list())
+                {
+                    if (std::find(first_use.begin(), first_use.end(), index) == first_use.end())
+                        first_use.push_back(index);
+                }
+
+                std::vector<uint32_t> expected(mesh.num_vertices());
+                std::iota(expected.begin(), expected.end(), 0);
+
+                REQUIRE_THAT(first_use, Equals(expected));
+            }
+        }
+    }
+
+    GIVEN("A mesh without indices")
+    {
+        Mesh mesh{{vk::Format::eR32G32Sfloat}};
+        mesh.next_vertex();
+
+        WHEN("optimizing for the vertex cache")
+        {
+            THEN("an exception is thrown")
+            {
+                REQUIRE_THROWS(optimize_vertex_cache(mesh));
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/mesh_simplifier.h"
+#include "src/mesh.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+uint32_t const grid_size = 64;
+
+// A bumpy grid of quads, with normals
+Mesh grid_mesh()
+{
+    Mesh mesh{{vk::Format::eR32G32B32Sfloat, vk::Format::eR32G32B32Sfloat}};
+
+    for (uint32_t y = 0; y <= grid_size; ++y)
+    {
+        for (uint32_t x = 0; x <= grid_size; ++x)
+        {
+            mesh.next_vertex();
+            mesh.set_attribute(0, glm::vec3{x, y, std::sin(x * 0.3f) * std::cos(y * 0.2f)});
+            mesh.set_attribute(1, glm::vec3{0, 0, 1});
+        }
+    }
+
+    for (uint32_t y = 0; y < grid_size; ++y)
+    {
+        for (uint32_t x = 0; x < grid_size; ++x)
+        {
+            uint32_t const v = y * (grid_size + 1) + x;
+            for (auto const index : {v, v + 1, v + grid_size + 1,
+                                     v + 1, v + grid_size + 2, v + grid_size + 1})
+            {
+                mesh.add_index(index);
+            }
+        }
+    }
+
+    return mesh;
+}
+
+}
+
+SCENARIO("mesh simplification", "")
+{
+    GIVEN("An indexed mesh")
+    {
+        auto const mesh = grid_mesh();
+        auto const num_triangles = mesh.num_indices() / 3;
+
+        WHEN("simplifying to a fraction of the triangles")
+        {
+            auto const target = num_triangles / 4;
+            auto const simplified = simplify_mesh(mesh, 0, target);
+            auto const simplified_triangles = simplified->num_indices() / 3;
+
+            THEN("the triangle count is close to, but not above the target")
+            {
+                REQUIRE(simplified_triangles <= target);
+                REQUIRE(simplified_triangles > target / 2);
+            }
+
+            THEN("only referenced vertices are kept")
+            {
+                std::vector<bool> referenced(simplified->num_vertices());
+                for (auto const index : simplified->index_list())
+                    referenced[index] = true;
+
+                REQUIRE(simplified->num_vertices() < mesh.num_vertices());
+                REQUIRE(std::all_of(referenced.begin(), referenced.end(),
+                                    [] (bool r) { return r; }));
+            }
+
+            THEN("there are no degenerate triangles")
+            {
+                auto const& indices = simplified->index_list();
+                size_t num_degenerate = 0;
+
+                for (size_t i = 0; i < indices.size(); i += 3)
+                {
+                    if (indices[i] == indices[i + 1] ||
+                        indices[i + 1] == indices[i + 2] ||
+                        indices[i + 2] == indices[i])
+                    {
+                        ++num_degenerate;
+                    }
+                }
+
+                REQUIRE(num_degenerate == 0);
+            }
+
+            THEN("the vertex formats and bounds are preserved")
+            {
+                REQUIRE(simplified->vertex_formats() == mesh.vertex_formats());
+                REQUIRE(glm::length(simplified->min_attribute_bound(0) -
+                                    mesh.min_attribute_bound(0)) < 2.0f);
+                REQUIRE(glm::length(simplified->max_attribute_bound(0) -
+                                    mesh.max_attribute_bound(0)) < 2.0f);
+            }
+        }
+    }
+
+    GIVEN("A mesh without indices")
+    {
+        Mesh mesh{{vk::Format::eR32G32B32Sfloat}};
+        mesh.next_vertex();
+
+        WHEN("simplifying the mesh")
+        {
+            THEN("an exception is thrown")
+            {
+                REQUIRE_THROWS(simplify_mesh(mesh, 0, 1));
+            }
+        }
+    }
+}
@@ -26,6 +26,7 @@
 
 #include <vulkan/vulkan.hpp>
 #include <glm/glm.hpp>
+#include <cstring>
 #include <memory>
 #include <numeric>
 
@@ -111,6 +112,8 @@ SCENARIO("mesh creation", "")
 
     GIVEN("A mesh with vertices")
     {
+        mesh.reserve_vertices(5);
+
         for (int i = 0; i < 5; ++i)
         {
             auto const v = i * num_vertex_floats;
@@ -222,6 +225,180 @@ SCENARIO("mesh creation", "")
                     REQUIRE(attrib_descs[i].offset == 0);
                 }
             }
+
+            THEN("binding offsets point to the start of each attribute's data")
+            {
+                auto const offsets = mesh.vertex_data_binding_offsets();
+
+                std::vector<vk::DeviceSize> const expected{
+                    0 * 5 * sizeof(float),
+                    1 * 5 * sizeof(float),
+                    3 * 5 * sizeof(float),
+                    6 * 5 * sizeof(float)};
+
+                REQUIRE_THAT(offsets, Equals(expected));
+            }
+        }
+    }
+}
+
+SCENARIO("mesh indices", "")
+{
+    std::vector<vk::Format> const formats{vk::Format::eR32Sfloat};
+
+    GIVEN("A mesh with a few vertices")
+    {
+        Mesh mesh{formats};
+
+        for (int i = 0; i < 3; ++i)
+        {
+            mesh.next_vertex();
+            mesh.set_attribute(0, static_cast<float>(i));
+        }
+
+        WHEN("adding indices to existing vertices")
+        {
+            mesh.add_index(2);
+            mesh.add_index(0);
+            mesh.add_index(1);
+
+            THEN("16-bit index data is produced")
+            {
+                REQUIRE(mesh.num_indices() == 3);
+                REQUIRE(mesh.index_type() == vk::IndexType::eUint16);
+                REQUIRE(mesh.index_data_size() == 3 * sizeof(uint16_t));
+
+                std::vector<uint16_t> index_data(3);
+                mesh.copy_index_data_to(index_data.data());
+                REQUIRE_THAT(index_data, Equals(std::vector<uint16_t>{2, 0, 1}));
+            }
+        }
+
+        WHEN("adding an index to a non-existent vertex")
+        {
+            THEN("an exception is thrown")
+            {
+                REQUIRE_THROWS(mesh.add_index(3));
+            }
+        }
+    }
+
+    GIVEN("A mesh with more vertices than 16-bit indices can address")
+    {
+        Mesh mesh{formats};
+
+        for (int i = 0; i < 65537; ++i)
+            mesh.next_vertex();
+
+        mesh.add_index(65536);
+        mesh.add_index(0);
+
+        THEN("32-bit index data is produced")
+        {
+            REQUIRE(mesh.index_type() == vk::IndexType::eUint32);
+            REQUIRE(mesh.index_data_size() == 2 * sizeof(uint32_t));
+
+            std::vector<uint32_t> index_data(2);
+            mesh.copy_index_data_to(index_data.data());
+            REQUIRE_THAT(index_data, Equals(std::vector<uint32_t>{65536, 0}));
+        }
+    }
+}
+
+SCENARIO("mesh compact vertex formats", "")
+{
+    GIVEN("A mesh with compact vertex formats")
+    {
+        std::vector<vk::Format> const formats{
+            vk::Format::eR16G16B16A16Sfloat,
+            vk::Format::eR8G8B8A8Snorm,
+            vk::Format::eA2B10G10R10SnormPack32,
+            vk::Format::eR16G16Unorm};
+
+        Mesh mesh{formats};
+
+        mesh.next_vertex();
+        mesh.set_attribute(0, glm::vec3{1.0f, -2.0f, 0.5f});
+        mesh.set_attribute(1, glm::vec3{1.0f, -1.0f, 0.5f});
+        mesh.set_attribute(2, glm::vec3{1.0f, -1.0f, 2.0f});
+        mesh.set_attribute(3, glm::vec2{0.0f, 1.0f});
+
+        WHEN("setting four component formats with three component data")
+        {
+            THEN("the data is accepted, but not data with fewer components")
+            {
+                mesh.set_attribute(0, glm::vec4{1, 2, 3, 4});
+                mesh.set_attribute(0, glm::vec3{1.0f, -2.0f, 0.5f});
+                REQUIRE_THROWS(mesh.set_attribute(0, glm::vec2{1, 2}));
+                REQUIRE_THROWS(mesh.set_attribute(1, glm::vec2{1, 2}));
+            }
+        }
+
+        WHEN("interleave is true")
+        {
+            mesh.set_interleave(true);
+
+            THEN("the vertex layout uses the compact sizes")
+            {
+                REQUIRE(mesh.vertex_size() == 20);
+                REQUIRE(mesh.vertex_data_size() == 20);
+                REQUIRE(mesh.binding_descriptions()[0].stride == 20);
+
+                auto const attrib_descs = mesh.attribute_descriptions();
+                REQUIRE(attrib_descs[0].offset == 0);
+                REQUIRE(attrib_descs[1].offset == 8);
+                REQUIRE(attrib_descs[2].offset == 12);
+                REQUIRE(attrib_descs[3].offset == 16);
+            }
+
+            THEN("the copied vertex data is converted to the formats")
+            {
+                std::vector<char> data(mesh.vertex_data_size());
+                mesh.copy_vertex_data_to(data.data());
+
+                uint16_t half[4];
+                memcpy(half, &data[0], sizeof(half));
+                REQUIRE(half[0] == 0x3c00);
+                REQUIRE(half[1] == 0xc000);
+                REQUIRE(half[2] == 0x3800);
+                REQUIRE(half[3] == 0x0000);
+
+                int8_t snorm8[4];
+                memcpy(snorm8, &data[8], sizeof(snorm8));
+                REQUIRE(snorm8[0] == 127);
+                REQUIRE(snorm8[1] == -127);
+                REQUIRE(snorm8[2] == 64);
+                REQUIRE(snorm8[3] == 0);
+
+                uint32_t packed;
+                memcpy(&packed, &data[12], sizeof(packed));
+                REQUIRE((packed & 0x3ff) == 511);
+                REQUIRE(((packed >> 10) & 0x3ff) == (-511 & 0x3ff));
+                REQUIRE(((packed >> 20) & 0x3ff) == 511);
+                REQUIRE((packed >> 30) == 0);
+
+                uint16_t unorm16[2];
+                memcpy(unorm16, &data[16], sizeof(unorm16));
+                REQUIRE(unorm16[0] == 0);
+                REQUIRE(unorm16[1] == 65535);
+            }
+        }
+
+        WHEN("interleave is false")
+        {
+            mesh.set_interleave(false);
+
+            THEN("binding strides and offsets use the compact sizes")
+            {
+                auto const binding_descs = mesh.binding_descriptions();
+                REQUIRE(binding_descs[0].stride == 8);
+                REQUIRE(binding_descs[1].stride == 4);
+                REQUIRE(binding_descs[2].stride == 4);
+                REQUIRE(binding_descs[3].stride == 4);
+
+                REQUIRE_THAT(mesh.vertex_data_binding_offsets(),
+                             Equals(std::vector<vk::DeviceSize>{0, 8, 12, 16}));
+            }
         }
     }
 }
@@ -22,15 +22,21 @@
 
 #include "src/model.h"
 #include "src/mesh.h"
+#include "src/util.h"
 
 #include "catch.hpp"
+#include "temporary_dir.h"
+
+#include <fstream>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 using namespace Catch::Matchers;
 
 namespace
 {
 
-std::vector<float> mesh_vertex_data(Mesh& mesh)
+std::vector<float> mesh_vertex_data(Mesh mesh)
 {
     std::vector<float> ret(mesh.vertex_data_size() / sizeof(float));
 
@@ -40,6 +46,36 @@ std::vector<float> mesh_vertex_data(Mesh& mesh)
     return ret;
 }
 
+// A data dir with a models subdirectory, holding a single model file
+struct TemporaryModelDataDir
+{
+    TemporaryModelDataDir()
+    {
+        mkdir((dir.path() + "/models").c_str(), 0700);
+        Util::set_data_dir(dir.path());
+        Model::clear_mesh_cache();
+    }
+
+    ~TemporaryModelDataDir()
+    {
+        Util::set_data_dir({});
+        Model::clear_mesh_cache();
+    }
+
+    void write_model(std::string const& model_str, time_t mtime_sec)
+    {
+        auto const path = dir.path() + "/models/" + model_file;
+
+        std::ofstream{path} << model_str;
+
+        struct timespec const times[2] = {{mtime_sec, 0}, {mtime_sec, 0}};
+        utimensat(AT_FDCWD, path.c_str(), times, 0);
+    }
+
+    TemporaryDir const dir{"model"};
+    std::string const model_file{"model.obj"};
+};
+
 }
 
 SCENARIO("model to mesh", "")
@@ -123,6 +159,42 @@ SCENARIO("model to mesh", "")
 
             }
         }
+
+        WHEN("converting to an indexed mesh")
+        {
+            auto const mesh = model.to_mesh(
+                ModelAttribMap{}.with_position(vk::Format::eR32G32B32Sfloat),
+                true);
+
+            THEN("vertices are shared between the triangulated faces")
+            {
+                REQUIRE(mesh->num_vertices() == 4);
+                REQUIRE(mesh->num_indices() == 6);
+                REQUIRE(mesh->index_type() == vk::IndexType::eUint16);
+
+                auto const vertex_data = mesh_vertex_data(*mesh);
+                std::vector<uint16_t> index_data(mesh->num_indices());
+                mesh->copy_index_data_to(index_data.data());
+
+                std::vector<float> expanded_vertex_data;
+                for (auto const index : index_data)
+                {
+                    expanded_vertex_data.insert(
+                        expanded_vertex_data.end(),
+                        vertex_data.begin() + index * 3,
+                        vertex_data.begin() + index * 3 + 3);
+                }
+
+                REQUIRE_THAT(expanded_vertex_data, Equals(
+                    std::vector<float>{
+                        -1, -1,  1,
+                        -1,  1,  1,
+                         1,  1,  1,
+                        -1, -1,  1,
+                         1,  1,  1,
+                         1, -1,  1}));
+            }
+        }
     }
 
     GIVEN("A model with normals")
@@ -279,3 +351,53 @@ SCENARIO("model to mesh", "")
         }
     }
 }
+
+SCENARIO("model mesh cache", "")
+{
+    TemporaryModelDataDir data_dir;
+    auto const map = ModelAttribMap{}.with_position(vk::Format::eR32G32B32Sfloat);
+
+    GIVEN("A model that has already been loaded")
+    {
+        data_dir.write_model(
+            "v  0  1  1\n"
+            "v -1 -1  1\n"
+            "v  1 -1  1\n"
+            "f  1  2  3\n",
+            1000000);
+
+        auto const mesh = Model::load_mesh(data_dir.model_file, map, false);
+
+        WHEN("loading the model again")
+        {
+            auto const cached_mesh = Model::load_mesh(data_dir.model_file, map, false);
+
+            THEN("the cached mesh is shared")
+            {
+                REQUIRE(cached_mesh == mesh);
+            }
+        }
+
+        WHEN("loading the model again after it has changed")
+        {
+            data_dir.write_model(
+                "v  0  2  1\n"
+                "v -2 -2  1\n"
+                "v  2 -2  1\n"
+                "f  1  2  3\n",
+                2000000);
+
+            auto const changed_mesh = Model::load_mesh(data_dir.model_file, map, false);
+
+            THEN("the changed model is returned")
+            {
+                auto const vertex_data = mesh_vertex_data(*changed_mesh);
+                REQUIRE_THAT(vertex_data, Equals(
+                    std::vector<float>{
+                         0, -2,  1,
+                        -2,  2,  1,
+                         2,  2,  1}));
+            }
+        }
+    }
+}
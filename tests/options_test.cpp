@@ -249,6 +249,42 @@ SCENARIO("options parses command line arguments", "")
         }
     }
 
+    GIVEN("A command line with --image-cache-dir")
+    {
+        std::string const image_cache_dir{"bla/cache"};
+        std::vector<std::string> args{"vkmark", "--image-cache-dir", image_cache_dir};
+        auto argv = argv_from_vector(args);
+
+        WHEN("parsing the args")
+        {
+            REQUIRE(options.image_cache_dir.empty());
+            REQUIRE(options.parse_args(args.size(), argv.get()));
+
+            THEN("the image cache dir is parsed")
+            {
+                REQUIRE(options.image_cache_dir == image_cache_dir);
+            }
+        }
+    }
+
+    GIVEN("A command line with --mesh-cache-dir")
+    {
+        std::string const mesh_cache_dir{"bla/meshes"};
+        std::vector<std::string> args{"vkmark", "--mesh-cache-dir", mesh_cache_dir};
+        auto argv = argv_from_vector(args);
+
+        WHEN("parsing the args")
+        {
+            REQUIRE(options.mesh_cache_dir.empty());
+            REQUIRE(options.parse_args(args.size(), argv.get()));
+
+            THEN("the mesh cache dir is parsed")
+            {
+                REQUIRE(options.mesh_cache_dir == mesh_cache_dir);
+            }
+        }
+    }
+
     GIVEN("A command line with --winsys")
     {
         std::string const winsys{"mywinsys"};
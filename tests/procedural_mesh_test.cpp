@@ -0,0 +1,143 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/procedural_mesh.h"
+#include "src/mesh.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+glm::vec3 attribute_vec3(Mesh const& mesh, size_t vertex, size_t pos)
+{
+    auto const v = mesh.vertex_attribute_values(vertex, pos);
+    return {v[0], v[1], v[2]};
+}
+
+size_t num_degenerate_triangles(Mesh const& mesh)
+{
+    auto const& indices = mesh.index_list();
+    size_t count = 0;
+
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        auto const p0 = attribute_vec3(mesh, indices[i], 0);
+        auto const p1 = attribute_vec3(mesh, indices[i + 1], 0);
+        auto const p2 = attribute_vec3(mesh, indices[i + 2], 0);
+        if (glm::length(glm::cross(p1 - p0, p2 - p0)) < 1e-12f)
+            ++count;
+    }
+
+    return count;
+}
+
+// Front faces are clockwise in the vulkan coordinate system, as seen from
+// the side the normals point to
+size_t num_back_facing_triangles(Mesh const& mesh)
+{
+    auto const& indices = mesh.index_list();
+    size_t count = 0;
+
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        auto const p0 = attribute_vec3(mesh, indices[i], 0);
+        auto const p1 = attribute_vec3(mesh, indices[i + 1], 0);
+        auto const p2 = attribute_vec3(mesh, indices[i + 2], 0);
+        auto const n = attribute_vec3(mesh, indices[i], 1);
+        if (glm::dot(glm::cross(p1 - p0, p2 - p0), n) >= 0.0f)
+            ++count;
+    }
+
+    return count;
+}
+
+size_t num_non_unit_normals(Mesh const& mesh)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < mesh.num_vertices(); ++i)
+    {
+        auto const n = attribute_vec3(mesh, i, 1);
+        if (std::abs(glm::length(n) - 1.0f) > 1e-4f)
+            ++count;
+    }
+
+    return count;
+}
+
+}
+
+SCENARIO("procedural mesh generation", "")
+{
+    for (auto const shape : {"sphere", "torus", "heightfield"})
+    {
+        GIVEN(std::string{"A "} + shape)
+        {
+            for (size_t const target : {1000, 123456})
+            {
+                WHEN("generating it with " + std::to_string(target) + " triangles")
+                {
+                    auto const mesh = generate_procedural_mesh(shape, target);
+
+                    THEN("the triangle count is close to the target")
+                    {
+                        auto const triangles = mesh->num_indices() / 3.0;
+                        REQUIRE(mesh->num_indices() % 3 == 0);
+                        REQUIRE(triangles > target * 0.9);
+                        REQUIRE(triangles < target * 1.1);
+                    }
+
+                    THEN("all indices refer to vertices")
+                    {
+                        auto const& indices = mesh->index_list();
+                        REQUIRE(*std::max_element(indices.begin(), indices.end()) <
+                                mesh->num_vertices());
+                    }
+
+                    THEN("there are no degenerate triangles")
+                    {
+                        REQUIRE(num_degenerate_triangles(*mesh) == 0);
+                    }
+
+                    THEN("all triangles face towards their normals")
+                    {
+                        REQUIRE(num_back_facing_triangles(*mesh) == 0);
+                    }
+
+                    THEN("the normals have unit length")
+                    {
+                        REQUIRE(num_non_unit_normals(*mesh) == 0);
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("An unknown shape")
+    {
+        THEN("generation fails")
+        {
+            REQUIRE_THROWS(generate_procedural_mesh("teapot", 1000));
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <ftw.h>
+
+// A uniquely named directory under /tmp, which is removed along with its
+// contents when the object is destroyed
+class TemporaryDir
+{
+public:
+    TemporaryDir(std::string const& name)
+    {
+        auto const dir_template = "/tmp/vkmark-" + name + "-XXXXXX";
+        std::vector<char> dir_buf{dir_template.begin(), dir_template.end()};
+        dir_buf.push_back('\0');
+
+        if (!mkdtemp(dir_buf.data()))
+            throw std::runtime_error{"Failed to create temporary directory " + dir_template};
+
+        dir = dir_buf.data();
+    }
+
+    ~TemporaryDir()
+    {
+        nftw(dir.c_str(),
+             [] (char const* path, struct stat const*, int, struct FTW*)
+             {
+                 return remove(path);
+             },
+             16, FTW_DEPTH | FTW_PHYS);
+    }
+
+    TemporaryDir(TemporaryDir const&) = delete;
+    TemporaryDir& operator=(TemporaryDir const&) = delete;
+
+    std::string const& path() const { return dir; }
+
+    // The names of the entries directly in the directory
+    std::vector<std::string> files() const
+    {
+        std::vector<std::string> ret;
+        auto const d = opendir(dir.c_str());
+
+        while (auto const entry = readdir(d))
+        {
+            std::string const name{entry->d_name};
+            if (name != "." && name != "..")
+                ret.push_back(name);
+        }
+
+        closedir(d);
+
+        return ret;
+    }
+
+private:
+    std::string dir;
+};
@@ -26,6 +26,7 @@
 #include "noise_rgba.c"
 
 #include "catch.hpp"
+#include "temporary_dir.h"
 
 #include <cstring>
 
@@ -38,6 +39,25 @@ struct TemporarySetDataDir
     ~TemporarySetDataDir() { Util::set_data_dir({}); }
 };
 
+struct TemporaryImageCacheDir
+{
+    TemporaryImageCacheDir()
+    {
+        Util::set_image_cache_dir(dir.path());
+        Util::clear_image_cache();
+    }
+
+    ~TemporaryImageCacheDir()
+    {
+        Util::set_image_cache_dir({});
+        Util::clear_image_cache();
+    }
+
+    std::vector<std::string> files() { return dir.files(); }
+
+    TemporaryDir const dir{"image-cache"};
+};
+
 template <typename ImageStruct>
 class ImageEquals : public Catch::MatcherBase<Util::Image>
 {
@@ -170,3 +190,52 @@ SCENARIO("util image object", "")
         }
     }
 }
+
+SCENARIO("util image cache", "")
+{
+    TemporarySetDataDir set_data_dir{VKMARK_TEST_DATA_DIR};
+
+    GIVEN("An image that has already been read")
+    {
+        Util::clear_image_cache();
+        auto const image = Util::read_image_file("images/noise-rgb.png");
+
+        WHEN("reading the image again")
+        {
+            auto const new_image = Util::read_image_file("images/noise-rgb.png");
+
+            THEN("the decoded image data is reused")
+            {
+                REQUIRE(new_image.data == image.data);
+                REQUIRE_THAT(new_image, Equals(noise_rgb_image));
+            }
+        }
+    }
+
+    GIVEN("An image cache directory")
+    {
+        TemporaryImageCacheDir image_cache_dir;
+
+        WHEN("reading an image")
+        {
+            auto const image = Util::read_image_file("images/noise-rgba.png");
+
+            THEN("the decoded image is stored in the cache directory")
+            {
+                REQUIRE(image_cache_dir.files().size() == 1);
+            }
+
+            AND_WHEN("reading the image again after clearing the in-memory cache")
+            {
+                Util::clear_image_cache();
+                auto const new_image = Util::read_image_file("images/noise-rgba.png");
+
+                THEN("the image is read from the cache directory")
+                {
+                    REQUIRE(new_image.data != image.data);
+                    REQUIRE_THAT(new_image, Equals(noise_rgba_image));
+                }
+            }
+        }
+    }
+}
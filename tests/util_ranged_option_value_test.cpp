@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2026 vkmark developers
+ *
+ * This file is part of vkmark.
+ *
+ * vkmark is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * vkmark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with vkmark. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/util.h"
+
+#include "catch.hpp"
+
+SCENARIO("util ranged option value", "")
+{
+    GIVEN("A value within the range")
+    {
+        std::string const value{"10"};
+
+        WHEN("parsing the value")
+        {
+            auto const ret = Util::ranged_option_value<uint32_t>("opt", value, 1, 10);
+
+            THEN("the value is returned")
+            {
+                REQUIRE(ret == 10);
+            }
+        }
+    }
+
+    GIVEN("A value outside the range")
+    {
+        std::string const value{"11"};
+
+        WHEN("parsing the value")
+        {
+            THEN("an exception naming the option and the range is thrown")
+            {
+                REQUIRE_THROWS_WITH(
+                    Util::ranged_option_value<uint32_t>("opt", value, 1, 10),
+                    "\"opt\" option must be between 1 and 10");
+            }
+        }
+    }
+
+    GIVEN("A non-numeric value")
+    {
+        std::string const value{"many"};
+
+        WHEN("parsing the value")
+        {
+            THEN("an exception is thrown")
+            {
+                REQUIRE_THROWS_AS(
+                    Util::ranged_option_value<size_t>("opt", value, 0, 10),
+                    std::runtime_error);
+            }
+        }
+    }
+
+    GIVEN("A value with a valid numeric prefix")
+    {
+        std::string const value{"5abc"};
+
+        WHEN("parsing the value")
+        {
+            THEN("an exception is thrown")
+            {
+                REQUIRE_THROWS_AS(
+                    Util::ranged_option_value<size_t>("opt", value, 0, 10),
+                    std::runtime_error);
+            }
+        }
+    }
+}